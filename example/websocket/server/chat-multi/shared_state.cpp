@@ -37,8 +37,8 @@ void
 shared_state::
 send(std::string message)
 {
-    // Put the message in a shared pointer so we can re-use it for each client
-    auto const ss = boost::make_shared<std::string const>(std::move(message));
+    // Frame the message once, every client shares the same bytes
+    websocket::prepared_message const msg(net::buffer(message));
 
     // Make a local list of all the weak pointers representing
     // the sessions, so we can do the actual sending without
@@ -55,5 +55,5 @@ send(std::string message)
     // pointer. If successful, then send the message on that session.
     for(auto const& wp : v)
         if(auto sp = wp.lock())
-            sp->send(ss);
+            sp->send(msg);
 }
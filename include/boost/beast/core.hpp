@@ -41,11 +41,13 @@
 #include <boost/beast/core/read_size.hpp>
 #include <boost/beast/core/role.hpp>
 #include <boost/beast/core/saved_handler.hpp>
+#include <boost/beast/core/shared_rate_policy.hpp>
 #include <boost/beast/core/span.hpp>
 #include <boost/beast/core/static_buffer.hpp>
 #include <boost/beast/core/static_string.hpp>
 #include <boost/beast/core/stream_traits.hpp>
 #include <boost/beast/core/string.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/core/timer_wheel.hpp>
 
 #endif
@@ -16,6 +16,7 @@
 #include <boost/beast/core/rate_policy.hpp>
 #include <boost/beast/core/role.hpp>
 #include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/core/timer_wheel.hpp>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/basic_stream_socket.hpp>
 #include <boost/asio/connect.hpp>
@@ -42,6 +43,12 @@ template<typename> class stream;
 namespace boost {
 namespace beast {
 
+#if ! BOOST_BEAST_DOXYGEN
+namespace detail {
+struct basic_stream_access;
+} // detail
+#endif
+
 /** A stream socket wrapper with timeouts, an executor, and a rate limit policy.
 
     This stream wraps a `net::basic_stream_socket` to provide
@@ -254,10 +261,15 @@ private:
                 std::chrono::steady_clock>,
             Executor> timer; // rate timer;
 
+        // used instead of the read and write timers, if set
+        std::shared_ptr<detail::timer_wheel_impl> wheel;
+
         int waiting = 0;
 
         impl_type(impl_type&&) = default;
 
+        ~impl_type();
+
         template<class... Args>
         explicit
         impl_type(std::false_type, Args&&...);
@@ -290,8 +302,27 @@ private:
         template<class Executor2>
         void on_timer(Executor2 const& ex2);
 
+        void add_waiter();      // before waiting on the rate timer
+
+        // templates, so that explicit instantiations of
+        // basic_stream do not require `refill_time`
+        template<class Policy>
+        void add_waiter(Policy& policy, std::true_type);
+        template<class Policy>
+        void add_waiter(Policy& policy, std::false_type);
+
         void reset();           // set timeouts to never
         void close() noexcept;  // cancel everything
+
+        // start timing out an operation
+        template<class Executor2>
+        void arm(op_state& state, Executor2 const& ex2);
+
+        // stop timing out an operation, returns
+        // `0` if the timeout already happened
+        std::size_t disarm(op_state& state);
+
+        static void on_wheel_timeout(detail::timer_wheel_entry& e);
     };
 
     // We use shared ownership for the state so it can
@@ -305,6 +336,10 @@ private:
 
     struct ops;
 
+#if ! BOOST_BEAST_DOXYGEN
+    friend struct detail::basic_stream_access;
+#endif
+
 #if ! BOOST_BEAST_DOXYGEN
     // boost::asio::ssl::stream needs these
     // DEPRECATED
@@ -499,6 +534,24 @@ public:
     void
     expires_never();
 
+    /** Use a timing wheel for the timeouts of the stream.
+
+        Subsequent operations with a timeout link their deadline
+        into the wheel rather than wait on a timer of their own.
+        The timeouts are still set with @ref expires_after,
+        @ref expires_at and @ref expires_never, and expire up to
+        one resolution of the wheel late. The wheel must be used
+        on the same strand as the stream, see @ref timer_wheel.
+
+        This function may only be called when no read, write or
+        connect operation is outstanding.
+
+        @param wheel The wheel to use. A default constructed wheel
+        makes the stream go back to using its own timers.
+    */
+    void
+    set_timer_wheel(timer_wheel const& wheel);
+
     /** Cancel all asynchronous operations associated with the socket.
 
         This function causes all outstanding asynchronous connect,
@@ -40,6 +40,7 @@
 #define BOOST_BEAST_DETAIL_BASE64_IPP
 
 #include <boost/beast/core/detail/base64.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
 #include <boost/beast/core/string.hpp>
 #include <cctype>
 #include <string>
@@ -87,6 +88,148 @@ get_inverse()
     return &tab[0];
 }
 
+/*  Vector kernels.
+
+    Each works on whole groups while it can load a full register
+    and returns the number of input characters consumed, leaving
+    the rest, and any group it cannot handle, to the scalar code.
+    The encoder reads 16 octets to encode 12 of them; the decoder
+    turns 16 characters into 12 octets but stores 16, so it is
+    only used while the output has room for that.
+*/
+using encode_fn = std::size_t(*)(
+    char*, unsigned char const*, std::size_t);
+
+using decode_fn = std::size_t(*)(
+    char*, unsigned char const*, std::size_t);
+
+inline
+std::size_t
+encode_none(char*, unsigned char const*, std::size_t)
+{
+    return 0;
+}
+
+inline
+std::size_t
+decode_none(char*, unsigned char const*, std::size_t)
+{
+    return 0;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET_SSSE3
+inline
+std::size_t
+encode_ssse3(char* out, unsigned char const* in, std::size_t len)
+{
+    auto const begin = in;
+    for(; len >= 16; in += 12, out += 16, len -= 12)
+    {
+        auto v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in));
+
+        // spread each 3 octets over 4 lanes, then
+        // move the 6-bit fields into place
+        v = _mm_shuffle_epi8(v, _mm_set_epi8(
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        auto const t0 = _mm_mulhi_epu16(
+            _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+            _mm_set1_epi32(0x04000040));
+        auto const t1 = _mm_mullo_epi16(
+            _mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+            _mm_set1_epi32(0x01000010));
+        v = _mm_or_si128(t0, t1);
+
+        // add the offset of the range of each index:
+        // 0..25, 26..51, 52..61, 62 and 63
+        auto idx = _mm_subs_epu8(v, _mm_set1_epi8(51));
+        idx = _mm_sub_epi8(idx,
+            _mm_cmpgt_epi8(v, _mm_set1_epi8(25)));
+        auto const offsets = _mm_setr_epi8(
+            65, 71, -4, -4, -4, -4, -4, -4,
+            -4, -4, -4, -4, -19, -16, 0, 0);
+        v = _mm_add_epi8(v, _mm_shuffle_epi8(offsets, idx));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+    }
+    return static_cast<std::size_t>(in - begin);
+}
+
+BOOST_BEAST_TARGET_SSSE3
+inline
+std::size_t
+decode_ssse3(char* out, unsigned char const* in, std::size_t len)
+{
+    auto const begin = in;
+    auto const nibble = _mm_set1_epi8(0x0f);
+    // bits set for the kinds of characters valid
+    // with each low and high nibble
+    auto const lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    auto const lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    // the offset from a character to its value,
+    // by high nibble, with '/' moved to 1
+    auto const lut_roll = _mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71,
+        0, 0, 0, 0, 0, 0, 0, 0);
+
+    // 16 characters make 12 octets, but 16 are stored
+    for(; len >= 24; in += 16, out += 12, len -= 16)
+    {
+        auto v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(in));
+        auto const hi_nibbles = _mm_and_si128(
+            _mm_srli_epi32(v, 4), nibble);
+        auto const lo = _mm_shuffle_epi8(
+            lut_lo, _mm_and_si128(v, nibble));
+        auto const hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        // padding or an invalid character
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xffff)
+            break;
+        auto const eq_2f = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x2f));
+        v = _mm_add_epi8(v, _mm_shuffle_epi8(
+            lut_roll, _mm_add_epi8(eq_2f, hi_nibbles)));
+
+        // pack each 4 values of 6 bits into 3 octets
+        v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+        v = _mm_shuffle_epi8(v, _mm_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+    }
+    return static_cast<std::size_t>(in - begin);
+}
+
+#endif
+
+inline
+encode_fn
+select_encode()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    if(get_cpu_info().ssse3)
+        return &encode_ssse3;
+#endif
+    return &encode_none;
+}
+
+inline
+decode_fn
+select_decode()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    if(get_cpu_info().ssse3)
+        return &decode_ssse3;
+#endif
+    return &decode_none;
+}
+
 /** Encode a series of octets as a padded, base64 string.
 
     The resulting string will not be null terminated.
@@ -106,6 +249,16 @@ encode(void* dest, void const* src, std::size_t len)
     char const* in = static_cast<char const*>(src);
     auto const tab = base64::get_alphabet();
 
+    if(len >= 16)
+    {
+        static encode_fn const fn = select_encode();
+        auto const n = fn(out, reinterpret_cast<
+            unsigned char const*>(in), len);
+        out += n / 3 * 4;
+        in += n;
+        len -= n;
+    }
+
     for(auto n = len / 3; n--;)
     {
         *out++ = tab[ (in[0] & 0xfc) >> 2];
@@ -160,6 +313,15 @@ decode(void* dest, char const* src, std::size_t len)
 
     auto const inverse = base64::get_inverse();
 
+    if(len >= 24)
+    {
+        static decode_fn const fn = select_decode();
+        auto const n = fn(out, in, len);
+        out += n / 4 * 3;
+        in += n;
+        len -= n;
+    }
+
     while(len-- && *in != '=')
     {
         auto const v = inverse[*in];
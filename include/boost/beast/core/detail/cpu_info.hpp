@@ -11,9 +11,19 @@
 #define BOOST_BEAST_DETAIL_CPU_INFO_HPP
 
 #include <boost/config.hpp>
+#include <cstdint>
 
+/*  Intrinsics are compiled in whenever the target is x86 and the
+    compiler can generate code for instruction sets beyond the ones
+    enabled on the command line. Each kernel is tagged with the
+    matching BOOST_BEAST_TARGET_* attribute and only called after
+    get_cpu_info() reports support at run time.
+*/
 #ifndef BOOST_BEAST_NO_INTRINSICS
-# if defined(BOOST_MSVC) || ((defined(BOOST_GCC) || defined(BOOST_CLANG)) && defined(__SSE4_2__))
+# if defined(BOOST_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+#  define BOOST_BEAST_NO_INTRINSICS 0
+# elif (defined(BOOST_GCC) || defined(BOOST_CLANG)) && \
+    (defined(__x86_64__) || defined(__i386__))
 #  define BOOST_BEAST_NO_INTRINSICS 0
 # else
 #  define BOOST_BEAST_NO_INTRINSICS 1
@@ -24,8 +34,22 @@
 
 #ifdef BOOST_MSVC
 #include <intrin.h> // __cpuid
+#include <immintrin.h>
+# define BOOST_BEAST_TARGET_SSE2
+# define BOOST_BEAST_TARGET_SSSE3
+# define BOOST_BEAST_TARGET_SSE42
+# define BOOST_BEAST_TARGET_AVX2
+# define BOOST_BEAST_TARGET_PCLMUL
+# define BOOST_BEAST_TARGET_SHA
 #else
 #include <cpuid.h>  // __get_cpuid
+#include <immintrin.h>
+# define BOOST_BEAST_TARGET_SSE2 __attribute__((target("sse2")))
+# define BOOST_BEAST_TARGET_SSSE3 __attribute__((target("ssse3")))
+# define BOOST_BEAST_TARGET_SSE42 __attribute__((target("sse4.2")))
+# define BOOST_BEAST_TARGET_AVX2 __attribute__((target("avx2")))
+# define BOOST_BEAST_TARGET_PCLMUL __attribute__((target("sse4.2,pclmul")))
+# define BOOST_BEAST_TARGET_SHA __attribute__((target("sse4.1,sha")))
 #endif
 
 namespace boost {
@@ -42,23 +66,45 @@ cpuid(
     std::uint32_t& eax,
     std::uint32_t& ebx,
     std::uint32_t& ecx,
-    std::uint32_t& edx)
+    std::uint32_t& edx,
+    std::uint32_t subleaf = 0)
 {
 #ifdef BOOST_MSVC
     int regs[4];
-    __cpuid(regs, id);
+    __cpuidex(regs, id, subleaf);
     eax = regs[0];
     ebx = regs[1];
     ecx = regs[2];
     edx = regs[3];
 #else
-    __get_cpuid(id, &eax, &ebx, &ecx, &edx);
+    __cpuid_count(id, subleaf, eax, ebx, ecx, edx);
+#endif
+}
+
+// Returns the OS-enabled register state mask (XCR0)
+template<class = void>
+std::uint64_t
+xgetbv()
+{
+#ifdef BOOST_MSVC
+    return _xgetbv(0);
+#else
+    std::uint32_t eax;
+    std::uint32_t edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
 #endif
 }
 
 struct cpu_info
 {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
     bool sse42 = false;
+    bool avx2 = false;
+    bool pclmul = false;
+    bool sha = false;
 
     cpu_info();
 };
@@ -67,7 +113,17 @@ inline
 cpu_info::
 cpu_info()
 {
+    constexpr std::uint32_t SSE2 = 1 << 26;
+    constexpr std::uint32_t SSSE3 = 1 << 9;
+    constexpr std::uint32_t SSE41 = 1 << 19;
     constexpr std::uint32_t SSE42 = 1 << 20;
+    constexpr std::uint32_t PCLMUL = 1 << 1;
+    constexpr std::uint32_t OSXSAVE = 1 << 27;
+    constexpr std::uint32_t AVX = 1 << 28;
+    constexpr std::uint32_t AVX2 = 1 << 5;
+    constexpr std::uint32_t SHA = 1 << 29;
+    // XMM and YMM state saved by the OS
+    constexpr std::uint64_t YMM_STATE = 0x6;
 
     std::uint32_t eax = 0;
     std::uint32_t ebx = 0;
@@ -75,10 +131,24 @@ cpu_info()
     std::uint32_t edx = 0;
 
     cpuid(0, eax, ebx, ecx, edx);
-    if(eax >= 1)
+    auto const max_leaf = eax;
+    if(max_leaf >= 1)
     {
         cpuid(1, eax, ebx, ecx, edx);
+        sse2 = (edx & SSE2) != 0;
+        ssse3 = (ecx & SSSE3) != 0;
+        sse41 = (ecx & SSE41) != 0;
         sse42 = (ecx & SSE42) != 0;
+        pclmul = (ecx & PCLMUL) != 0;
+        bool const ymm =
+            (ecx & (OSXSAVE | AVX)) == (OSXSAVE | AVX) &&
+            (xgetbv() & YMM_STATE) == YMM_STATE;
+        if(max_leaf >= 7)
+        {
+            cpuid(7, eax, ebx, ecx, edx);
+            avx2 = ymm && (ebx & AVX2) != 0;
+            sha = (ebx & SHA) != 0;
+        }
     }
 }
 
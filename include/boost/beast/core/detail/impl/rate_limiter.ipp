@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_DETAIL_IMPL_RATE_LIMITER_IPP
+#define BOOST_BEAST_CORE_DETAIL_IMPL_RATE_LIMITER_IPP
+
+#include <boost/beast/core/detail/rate_limiter.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+rate_limiter_root::
+rate_limiter_root(duration resolution)
+    : origin(clock_type::now())
+    , res(resolution)
+{
+    if(res <= duration::zero())
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "invalid resolution"});
+}
+
+//------------------------------------------------------------------------------
+
+rate_limiter_node::
+rate_limiter_node(
+    std::shared_ptr<rate_limiter_root> root,
+    std::shared_ptr<rate_limiter_node> parent)
+    : root_(std::move(root))
+    , parent_(std::move(parent))
+{
+}
+
+void
+rate_limiter_node::
+limit(bool is_read, std::size_t bytes_per_second)
+{
+    std::lock_guard<std::mutex> lock(root_->m);
+    auto& b = get(is_read);
+    b.limit = bytes_per_second;
+    if(bytes_per_second == all)
+    {
+        b.quantum = all;
+        b.remain = all;
+        return;
+    }
+    using period = rate_limiter_root::duration::period;
+    auto const q = static_cast<double>(bytes_per_second) *
+        static_cast<double>(root_->res.count()) *
+        period::num / period::den;
+    if(q < 1)
+        b.quantum = 1;
+    else if(q >= static_cast<double>(all))
+        b.quantum = all - 1;
+    else
+        b.quantum = static_cast<std::size_t>(q);
+    if(b.remain > b.quantum)
+        b.remain = b.quantum;
+}
+
+std::size_t
+rate_limiter_node::
+available(bool is_read, ticket& tk)
+{
+    std::lock_guard<std::mutex> lock(root_->m);
+    if(tk.waiting)
+    {
+        unwait(is_read);
+        tk.waiting = false;
+    }
+    auto const t = root_->tick(
+        rate_limiter_root::clock_type::now());
+    settle(is_read, tk, 0, t);
+    std::size_t share = all;
+    for(auto p = this; p; p = p->parent_.get())
+    {
+        auto& b = p->get(is_read);
+        if(b.limit == all)
+            continue;
+        if(b.tick < t)
+        {
+            b.remain = b.quantum;
+            b.tick = t;
+        }
+        // leave an equal part to each waiting stream
+        auto const n = b.remain / (b.waiting + 1);
+        if(share > n)
+            share = n;
+    }
+    if(share == 0)
+    {
+        tk.waiting = true;
+        for(auto p = this; p; p = p->parent_.get())
+            ++p->get(is_read).waiting;
+        return 0;
+    }
+    if(share == all)
+        return share;
+    for(auto p = this; p; p = p->parent_.get())
+    {
+        auto& b = p->get(is_read);
+        if(b.limit != all)
+            b.remain -= share;
+    }
+    tk.granted = share;
+    tk.tick = t;
+    return share;
+}
+
+void
+rate_limiter_node::
+transfer(bool is_read, ticket& tk, std::size_t n)
+{
+    std::lock_guard<std::mutex> lock(root_->m);
+    settle(is_read, tk, n, root_->tick(
+        rate_limiter_root::clock_type::now()));
+}
+
+void
+rate_limiter_node::
+leave(bool is_read, ticket& tk) noexcept
+{
+    if(! tk.waiting && tk.granted == 0)
+        return;
+    std::lock_guard<std::mutex> lock(root_->m);
+    if(tk.waiting)
+    {
+        unwait(is_read);
+        tk.waiting = false;
+    }
+    settle(is_read, tk, 0, root_->tick(
+        rate_limiter_root::clock_type::now()));
+}
+
+auto
+rate_limiter_node::
+refill_time() const ->
+    time_point
+{
+    auto const t = root_->tick(
+        rate_limiter_root::clock_type::now());
+    return root_->origin + root_->res *
+        static_cast<rate_limiter_root::duration::rep>(t + 1);
+}
+
+void
+rate_limiter_node::
+unwait(bool is_read) noexcept
+{
+    for(auto p = this; p; p = p->parent_.get())
+    {
+        auto& b = p->get(is_read);
+        BOOST_ASSERT(b.waiting > 0);
+        --b.waiting;
+    }
+}
+
+void
+rate_limiter_node::
+settle(
+    bool is_read,
+    ticket& tk,
+    std::size_t n,
+    std::uint64_t t) noexcept
+{
+    for(auto p = this; p; p = p->parent_.get())
+    {
+        auto& b = p->get(is_read);
+        if(b.limit == all)
+            continue;
+        if(n < tk.granted)
+        {
+            // a bucket refilled since the grant owes nothing back
+            auto const r = tk.granted - n;
+            if(b.tick == tk.tick)
+                b.remain = (b.quantum - b.remain > r) ?
+                    b.remain + r : b.quantum;
+            continue;
+        }
+        if(b.tick < t)
+        {
+            b.remain = b.quantum;
+            b.tick = t;
+        }
+        auto const m = n - tk.granted;
+        b.remain = (m < b.remain) ? b.remain - m : 0;
+    }
+    tk.granted = 0;
+}
+
+} // detail
+} // beast
+} // boost
+
+#endif
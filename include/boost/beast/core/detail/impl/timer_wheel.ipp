@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_DETAIL_IMPL_TIMER_WHEEL_IPP
+#define BOOST_BEAST_CORE_DETAIL_IMPL_TIMER_WHEEL_IPP
+
+#include <boost/beast/core/detail/timer_wheel.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+timer_wheel_impl::
+timer_wheel_impl(
+    net::any_io_executor ex,
+    duration resolution,
+    std::size_t slots)
+    : timer_(std::move(ex))
+    , res_(resolution)
+    , origin_(clock_type::now())
+{
+    if(res_ <= duration::zero())
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "invalid resolution"});
+    // round up to a power of two
+    std::size_t n = 1;
+    while(n < slots)
+        n <<= 1;
+    mask_ = n - 1;
+    slots_.reset(new timer_wheel_entry[n]);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto& head = slots_[i];
+        head.prev = &head;
+        head.next = &head;
+    }
+}
+
+timer_wheel_impl::
+~timer_wheel_impl()
+{
+    // Streams hold a reference to the wheel,
+    // so every entry has been removed by now.
+    BOOST_ASSERT(size_ == 0);
+}
+
+void
+timer_wheel_impl::
+insert(timer_wheel_entry& e, time_point expiry)
+{
+    BOOST_ASSERT(! e.linked());
+    BOOST_ASSERT(e.on_expire);
+    if(! running_)
+        start();
+    auto tick = tick_of(expiry);
+    if(tick <= now_)
+        tick = now_ + 1;
+    e.tick = tick;
+    auto& head = slots_[static_cast<std::size_t>(tick) & mask_];
+    e.prev = &head;
+    e.next = head.next;
+    head.next->prev = &e;
+    head.next = &e;
+    ++size_;
+}
+
+bool
+timer_wheel_impl::
+remove(timer_wheel_entry& e) noexcept
+{
+    if(! e.linked())
+        return false;
+    unlink(e);
+    --size_;
+    return true;
+}
+
+void
+timer_wheel_impl::
+advance(time_point now)
+{
+    std::uint64_t last = 0;
+    if(now > origin_)
+        last = static_cast<std::uint64_t>(
+            (now - origin_) / res_);
+    if(last <= now_)
+        return;
+
+    // Move what is due to a local list first, so the
+    // handlers are free to insert and remove entries.
+    timer_wheel_entry expired;
+    expired.prev = &expired;
+    expired.next = &expired;
+    auto first = now_ + 1;
+    if(last - first > mask_)
+        first = last - mask_;
+    for(auto t = first; t <= last; ++t)
+    {
+        auto& head = slots_[static_cast<std::size_t>(t) & mask_];
+        auto e = head.next;
+        while(e != &head)
+        {
+            auto const next = e->next;
+            if(e->tick <= last)
+            {
+                unlink(*e);
+                e->prev = expired.prev;
+                e->next = &expired;
+                expired.prev->next = e;
+                expired.prev = e;
+            }
+            e = next;
+        }
+    }
+    now_ = last;
+
+    while(expired.next != &expired)
+    {
+        auto& e = *expired.next;
+        unlink(e);
+        --size_;
+        e.on_expire(e);
+    }
+}
+
+void
+timer_wheel_impl::
+unlink(timer_wheel_entry& e) noexcept
+{
+    e.prev->next = e.next;
+    e.next->prev = e.prev;
+    e.prev = nullptr;
+    e.next = nullptr;
+}
+
+void
+timer_wheel_impl::
+start()
+{
+    BOOST_ASSERT(! running_);
+    BOOST_ASSERT(size_ == 0);
+    running_ = true;
+    // nothing is linked, so the
+    // wheel can skip the idle time
+    auto const now = clock_type::now();
+    if(now > origin_)
+        now_ = static_cast<std::uint64_t>(
+            (now - origin_) / res_);
+    wait();
+}
+
+void
+timer_wheel_impl::
+wait()
+{
+    timer_.expires_at(origin_ + res_ *
+        static_cast<duration::rep>(now_ + 1));
+    std::weak_ptr<timer_wheel_impl> wp(shared_from_this());
+    timer_.async_wait(
+        [wp](error_code ec)
+        {
+            if(auto sp = wp.lock())
+                sp->on_timer(ec);
+        });
+}
+
+void
+timer_wheel_impl::
+on_timer(error_code ec)
+{
+    if(ec == net::error::operation_aborted)
+        return;
+    advance(clock_type::now());
+    if(size_ == 0)
+    {
+        running_ = false;
+        return;
+    }
+    wait();
+}
+
+} // detail
+} // beast
+} // boost
+
+#endif
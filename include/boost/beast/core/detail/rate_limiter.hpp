@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_DETAIL_RATE_LIMITER_HPP
+#define BOOST_BEAST_CORE_DETAIL_RATE_LIMITER_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+// The clock and lock shared by every node of a tree of limiters.
+//
+// There is no timer: the tick number is computed from the clock,
+// and each bucket refills the first time it is used in a new tick.
+//
+struct rate_limiter_root
+{
+    using clock_type = std::chrono::steady_clock;
+    using duration = clock_type::duration;
+    using time_point = clock_type::time_point;
+
+    std::mutex m;
+    time_point const origin;
+    duration const res;
+
+    BOOST_BEAST_DECL
+    explicit
+    rate_limiter_root(duration resolution);
+
+    std::uint64_t
+    tick(time_point now) const noexcept
+    {
+        if(now <= origin)
+            return 0;
+        return static_cast<std::uint64_t>(
+            (now - origin) / res);
+    }
+};
+
+// A pair of token buckets in a tree of limiters.
+//
+// Bytes transferred are taken from every bucket between the
+// node of a stream and the root. While streams wait on a
+// bucket, the bytes it has left are shared evenly by them.
+//
+class rate_limiter_node
+{
+public:
+    static std::size_t constexpr all =
+        (std::numeric_limits<std::size_t>::max)();
+
+    using time_point = rate_limiter_root::time_point;
+
+    BOOST_BEAST_DECL
+    explicit
+    rate_limiter_node(
+        std::shared_ptr<rate_limiter_root> root,
+        std::shared_ptr<rate_limiter_node> parent = nullptr);
+
+    std::shared_ptr<rate_limiter_root> const&
+    root() const noexcept
+    {
+        return root_;
+    }
+
+    BOOST_BEAST_DECL
+    void
+    limit(bool is_read, std::size_t bytes_per_second);
+
+    // What one stream holds in the buckets of one direction
+    struct ticket
+    {
+        std::size_t granted = 0;    // bytes taken and not yet settled
+        std::uint64_t tick = 0;     // tick in which they were taken
+        bool waiting = false;       // counted as waiting
+    };
+
+    // Returns the share of a stream using this node and takes it
+    // from every limited bucket up to the root, so that streams
+    // asking before the transfer is settled do not get the same
+    // bytes. Bytes granted earlier and not settled are returned
+    // first. If the share is zero, the stream is counted as
+    // waiting on every limited bucket until its next call.
+    BOOST_BEAST_DECL
+    std::size_t
+    available(bool is_read, ticket& t);
+
+    // Settle the bytes granted against the n transferred
+    BOOST_BEAST_DECL
+    void
+    transfer(bool is_read, ticket& t, std::size_t n);
+
+    // Stop counting a stream as waiting and return its grant
+    BOOST_BEAST_DECL
+    void
+    leave(bool is_read, ticket& t) noexcept;
+
+    // Returns the time at which the buckets refill next
+    BOOST_BEAST_DECL
+    time_point
+    refill_time() const;
+
+private:
+    struct bucket
+    {
+        std::size_t limit = all;    // bytes per second
+        std::size_t quantum = all;  // bytes per tick
+        std::size_t remain = all;   // bytes left in the tick
+        std::size_t waiting = 0;    // streams waiting on it
+        std::uint64_t tick = 0;     // tick of the last refill
+    };
+
+    bucket&
+    get(bool is_read) noexcept
+    {
+        return is_read ? rd_ : wr_;
+    }
+
+    BOOST_BEAST_DECL
+    void
+    unwait(bool is_read) noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    settle(bool is_read, ticket& t,
+        std::size_t n, std::uint64_t now) noexcept;
+
+    std::shared_ptr<rate_limiter_root> root_;
+    std::shared_ptr<rate_limiter_node> parent_;
+    bucket rd_;
+    bucket wr_;
+};
+
+} // detail
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/core/detail/impl/rate_limiter.ipp>
+#endif
+
+#endif
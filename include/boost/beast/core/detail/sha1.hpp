@@ -11,6 +11,7 @@
 #define BOOST_BEAST_DETAIL_SHA1_HPP
 
 #include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
 #include <cstdint>
 #include <cstddef>
 
@@ -34,6 +35,30 @@ static std::size_t constexpr BLOCK_INTS = 16;
 static std::size_t constexpr BLOCK_BYTES = 64;
 static std::size_t constexpr DIGEST_BYTES = 20;
 
+// Hash `n` consecutive blocks of 64 bytes into `digest`
+using transform_fn = void(*)(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n);
+
+BOOST_BEAST_DECL
+void
+transform_portable(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n) noexcept;
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+// Requires SHA and SSE4.1
+BOOST_BEAST_DECL
+BOOST_BEAST_TARGET_SHA
+void
+transform_shani(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n) noexcept;
+#endif
+
 } // sha1
 
 struct sha1_context
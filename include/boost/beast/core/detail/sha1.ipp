@@ -215,6 +215,235 @@ transform(
     digest[4] += e;
 }
 
+void
+transform_portable(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n) noexcept
+{
+    std::uint32_t block[BLOCK_INTS];
+    for(; n > 0; --n, p += BLOCK_BYTES)
+    {
+        make_block(p, block);
+        transform(digest, block);
+    }
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+// The SHA extensions compute four rounds per instruction,
+// and expand the message schedule four words at a time.
+BOOST_BEAST_TARGET_SHA
+void
+transform_shani(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n) noexcept
+{
+    // loads the big endian words of a block
+    // with the first one in the highest lane
+    auto const mask = _mm_set_epi64x(
+        0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(digest)), 0x1b);
+    auto e0 = _mm_set_epi32(
+        static_cast<int>(digest[4]), 0, 0, 0);
+    __m128i e1, m0, m1, m2, m3;
+    for(; n > 0; --n, p += BLOCK_BYTES)
+    {
+        auto const abcd0 = abcd;
+        auto const e00 = e0;
+
+        // rounds 0-3
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 0)), mask);
+        e0 = _mm_add_epi32(e0, m0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        // rounds 4-7
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 16)), mask);
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        m0 = _mm_sha1msg1_epu32(m0, m1);
+
+        // rounds 8-11
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 32)), mask);
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        m1 = _mm_sha1msg1_epu32(m1, m2);
+        m0 = _mm_xor_si128(m0, m2);
+
+        // rounds 12-15
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p + 48)), mask);
+        e1 = _mm_sha1nexte_epu32(e1, m3);
+        e0 = abcd;
+        m0 = _mm_sha1msg2_epu32(m0, m3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        m2 = _mm_sha1msg1_epu32(m2, m3);
+        m1 = _mm_xor_si128(m1, m3);
+
+        // rounds 16-19
+        e0 = _mm_sha1nexte_epu32(e0, m0);
+        e1 = abcd;
+        m1 = _mm_sha1msg2_epu32(m1, m0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        m3 = _mm_sha1msg1_epu32(m3, m0);
+        m2 = _mm_xor_si128(m2, m0);
+
+        // rounds 20-23
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        m2 = _mm_sha1msg2_epu32(m2, m1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        m0 = _mm_sha1msg1_epu32(m0, m1);
+        m3 = _mm_xor_si128(m3, m1);
+
+        // rounds 24-27
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        m3 = _mm_sha1msg2_epu32(m3, m2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        m1 = _mm_sha1msg1_epu32(m1, m2);
+        m0 = _mm_xor_si128(m0, m2);
+
+        // rounds 28-31
+        e1 = _mm_sha1nexte_epu32(e1, m3);
+        e0 = abcd;
+        m0 = _mm_sha1msg2_epu32(m0, m3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        m2 = _mm_sha1msg1_epu32(m2, m3);
+        m1 = _mm_xor_si128(m1, m3);
+
+        // rounds 32-35
+        e0 = _mm_sha1nexte_epu32(e0, m0);
+        e1 = abcd;
+        m1 = _mm_sha1msg2_epu32(m1, m0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        m3 = _mm_sha1msg1_epu32(m3, m0);
+        m2 = _mm_xor_si128(m2, m0);
+
+        // rounds 36-39
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        m2 = _mm_sha1msg2_epu32(m2, m1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        m0 = _mm_sha1msg1_epu32(m0, m1);
+        m3 = _mm_xor_si128(m3, m1);
+
+        // rounds 40-43
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        m3 = _mm_sha1msg2_epu32(m3, m2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        m1 = _mm_sha1msg1_epu32(m1, m2);
+        m0 = _mm_xor_si128(m0, m2);
+
+        // rounds 44-47
+        e1 = _mm_sha1nexte_epu32(e1, m3);
+        e0 = abcd;
+        m0 = _mm_sha1msg2_epu32(m0, m3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        m2 = _mm_sha1msg1_epu32(m2, m3);
+        m1 = _mm_xor_si128(m1, m3);
+
+        // rounds 48-51
+        e0 = _mm_sha1nexte_epu32(e0, m0);
+        e1 = abcd;
+        m1 = _mm_sha1msg2_epu32(m1, m0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        m3 = _mm_sha1msg1_epu32(m3, m0);
+        m2 = _mm_xor_si128(m2, m0);
+
+        // rounds 52-55
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        m2 = _mm_sha1msg2_epu32(m2, m1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        m0 = _mm_sha1msg1_epu32(m0, m1);
+        m3 = _mm_xor_si128(m3, m1);
+
+        // rounds 56-59
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        m3 = _mm_sha1msg2_epu32(m3, m2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        m1 = _mm_sha1msg1_epu32(m1, m2);
+        m0 = _mm_xor_si128(m0, m2);
+
+        // rounds 60-63
+        e1 = _mm_sha1nexte_epu32(e1, m3);
+        e0 = abcd;
+        m0 = _mm_sha1msg2_epu32(m0, m3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        m2 = _mm_sha1msg1_epu32(m2, m3);
+        m1 = _mm_xor_si128(m1, m3);
+
+        // rounds 64-67
+        e0 = _mm_sha1nexte_epu32(e0, m0);
+        e1 = abcd;
+        m1 = _mm_sha1msg2_epu32(m1, m0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        m3 = _mm_sha1msg1_epu32(m3, m0);
+        m2 = _mm_xor_si128(m2, m0);
+
+        // rounds 68-71
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        m2 = _mm_sha1msg2_epu32(m2, m1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        m3 = _mm_xor_si128(m3, m1);
+
+        // rounds 72-75
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        m3 = _mm_sha1msg2_epu32(m3, m2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+        // rounds 76-79
+        e1 = _mm_sha1nexte_epu32(e1, m3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, e00);
+        abcd = _mm_add_epi32(abcd, abcd0);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digest),
+        _mm_shuffle_epi32(abcd, 0x1b));
+    digest[4] = static_cast<std::uint32_t>(
+        _mm_extract_epi32(e0, 3));
+}
+
+#endif
+
+inline
+transform_fn
+select_transform()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = get_cpu_info();
+    if(ci.sha && ci.sse41)
+        return &transform_shani;
+#endif
+    return &transform_portable;
+}
+
+inline
+void
+transform_blocks(
+    std::uint32_t* digest,
+    std::uint8_t const* p,
+    std::size_t n)
+{
+    static transform_fn const fn = select_transform();
+    fn(digest, p, n);
+}
+
 } // sha1
 
 void
@@ -237,22 +466,34 @@ update(
 {
     auto p = static_cast<
         std::uint8_t const*>(message);
-    for(;;)
+    if(ctx.buflen > 0)
     {
         auto const n = (std::min)(
             size, sizeof(ctx.buf) - ctx.buflen);
         std::memcpy(ctx.buf + ctx.buflen, p, n);
         ctx.buflen += n;
-        if(ctx.buflen != 64)
+        if(ctx.buflen != sizeof(ctx.buf))
             return;
         p += n;
         size -= n;
         ctx.buflen = 0;
-        std::uint32_t block[sha1::BLOCK_INTS];
-        sha1::make_block(ctx.buf, block);
-        sha1::transform(ctx.digest, block);
+        sha1::transform_blocks(ctx.digest, ctx.buf, 1);
         ++ctx.blocks;
     }
+    // whole blocks are hashed without a copy
+    auto const blocks = size / sha1::BLOCK_BYTES;
+    if(blocks > 0)
+    {
+        sha1::transform_blocks(ctx.digest, p, blocks);
+        ctx.blocks += blocks;
+        p += blocks * sha1::BLOCK_BYTES;
+        size -= blocks * sha1::BLOCK_BYTES;
+    }
+    if(size > 0)
+    {
+        std::memcpy(ctx.buf, p, size);
+        ctx.buflen = size;
+    }
 }
 
 void
@@ -260,29 +501,27 @@ finish(
     sha1_context& ctx,
     void* digest) noexcept
 {
-    using sha1::BLOCK_INTS;
     using sha1::BLOCK_BYTES;
 
     std::uint64_t total_bits =
         (ctx.blocks*64 + ctx.buflen) * 8;
     // pad
     ctx.buf[ctx.buflen++] = 0x80;
-    auto const buflen = ctx.buflen;
-    while(ctx.buflen < 64)
-        ctx.buf[ctx.buflen++] = 0x00;
-    std::uint32_t block[BLOCK_INTS];
-    sha1::make_block(ctx.buf, block);
-    if(buflen > BLOCK_BYTES - 8)
+    if(ctx.buflen > BLOCK_BYTES - 8)
     {
-        sha1::transform(ctx.digest, block);
-        for(size_t i = 0; i < BLOCK_INTS - 2; i++)
-            block[i] = 0;
+        std::memset(ctx.buf + ctx.buflen, 0,
+            BLOCK_BYTES - ctx.buflen);
+        sha1::transform_blocks(ctx.digest, ctx.buf, 1);
+        ctx.buflen = 0;
     }
+    std::memset(ctx.buf + ctx.buflen, 0,
+        BLOCK_BYTES - 8 - ctx.buflen);
 
-    /* Append total_bits, split this uint64_t into two uint32_t */
-    block[BLOCK_INTS - 1] = total_bits & 0xffffffff;
-    block[BLOCK_INTS - 2] = (total_bits >> 32);
-    sha1::transform(ctx.digest, block);
+    /* Append total_bits, big endian */
+    for(std::size_t i = 0; i < 8; ++i)
+        ctx.buf[BLOCK_BYTES - 1 - i] =
+            static_cast<std::uint8_t>(total_bits >> (8 * i));
+    sha1::transform_blocks(ctx.digest, ctx.buf, 1);
     for(std::size_t i = 0; i < sha1::DIGEST_BYTES/4; i++)
     {
         std::uint8_t* d =
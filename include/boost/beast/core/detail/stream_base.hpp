@@ -10,6 +10,7 @@
 #ifndef BOOST_BEAST_CORE_DETAIL_STREAM_BASE_HPP
 #define BOOST_BEAST_CORE_DETAIL_STREAM_BASE_HPP
 
+#include <boost/beast/core/detail/timer_wheel.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/assert.hpp>
 #include <boost/core/exchange.hpp>
@@ -47,6 +48,7 @@ struct stream_base
                 net::wait_traits<
                         std::chrono::steady_clock>,
                 Executor> timer;    // for timing out
+        timer_wheel_entry entry;    // for timing out on a wheel
         tick_type tick = 0;         // counts waits
         bool pending = false;       // if op is pending
         bool timeout = false;       // if timed out
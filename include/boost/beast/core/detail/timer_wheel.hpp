@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_BEAST_CORE_DETAIL_TIMER_WHEEL_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace beast {
+namespace detail {
+
+// A deadline kept on a timer wheel.
+//
+// Entries are linked into the slot of the tick at which they
+// expire, so arming and disarming one is a constant time list
+// operation which never allocates. Copies start out unlinked.
+//
+struct timer_wheel_entry
+{
+    timer_wheel_entry* prev = nullptr;
+    timer_wheel_entry* next = nullptr;
+    std::uint64_t tick = 0;     // tick at which the entry expires
+    void* owner = nullptr;      // passed back to on_expire
+    void (*on_expire)(timer_wheel_entry&) = nullptr;
+
+    timer_wheel_entry() = default;
+
+    timer_wheel_entry(timer_wheel_entry const&) noexcept
+    {
+    }
+
+    timer_wheel_entry& operator=(timer_wheel_entry const&) = delete;
+
+    bool
+    linked() const noexcept
+    {
+        return prev != nullptr;
+    }
+};
+
+// The state shared by copies of a timer_wheel.
+//
+// A steady timer ticks at the resolution of the wheel while
+// any entry is armed. Each tick expires the entries in the
+// slots passed since the previous one; entries further out
+// stay in their slot until the wheel comes around again.
+//
+class timer_wheel_impl
+    : public std::enable_shared_from_this<timer_wheel_impl>
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using duration = clock_type::duration;
+    using time_point = clock_type::time_point;
+
+    BOOST_BEAST_DECL
+    timer_wheel_impl(
+        net::any_io_executor ex,
+        duration resolution,
+        std::size_t slots);
+
+    timer_wheel_impl(timer_wheel_impl const&) = delete;
+    timer_wheel_impl& operator=(timer_wheel_impl const&) = delete;
+
+    BOOST_BEAST_DECL
+    ~timer_wheel_impl();
+
+    duration
+    resolution() const noexcept
+    {
+        return res_;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    // Link `e` so that it expires at the first tick at or
+    // after `expiry`, which may be late by up to one tick
+    // but is never early.
+    BOOST_BEAST_DECL
+    void
+    insert(timer_wheel_entry& e, time_point expiry);
+
+    // Unlink `e`. Returns `false` if it was not linked,
+    // because it expired or was never inserted.
+    BOOST_BEAST_DECL
+    bool
+    remove(timer_wheel_entry& e) noexcept;
+
+    // Expire every entry due at `now`
+    BOOST_BEAST_DECL
+    void
+    advance(time_point now);
+
+private:
+    std::uint64_t
+    tick_of(time_point t) const noexcept
+    {
+        if(t <= origin_)
+            return 0;
+        return static_cast<std::uint64_t>(
+            (t - origin_ + res_ - duration(1)) / res_);
+    }
+
+    BOOST_BEAST_DECL
+    void
+    unlink(timer_wheel_entry& e) noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    start();
+
+    BOOST_BEAST_DECL
+    void
+    wait();
+
+    BOOST_BEAST_DECL
+    void
+    on_timer(error_code ec);
+
+    net::steady_timer timer_;
+    duration res_;
+    time_point origin_;
+    std::uint64_t now_ = 0;     // last tick processed
+    std::size_t size_ = 0;      // number of linked entries
+    std::size_t mask_;          // number of slots minus one
+    bool running_ = false;
+    std::unique_ptr<timer_wheel_entry[]> slots_;
+};
+
+} // detail
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/core/detail/impl/timer_wheel.ipp>
+#endif
+
+#endif
@@ -26,6 +26,21 @@
 namespace boost {
 namespace beast {
 
+namespace detail {
+
+// Used by the write operation of basic_stream in place of a
+// buffer sequence. Instead of writing buffers, the operation
+// calls `f(socket, amount, handler)`, which must write at most
+// `amount` bytes to the socket and then invoke the handler
+// with the error and number of bytes written.
+template<class WriteFn>
+struct stream_write_fn
+{
+    WriteFn f;
+};
+
+} // detail
+
 //------------------------------------------------------------------------------
 
 template<class Protocol, class Executor, class RatePolicy>
@@ -58,6 +73,18 @@ impl_type(std::true_type,
     reset();
 }
 
+template<class Protocol, class Executor, class RatePolicy>
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+~impl_type()
+{
+    if(wheel)
+    {
+        wheel->remove(read.entry);
+        wheel->remove(write.entry);
+    }
+}
+
 template<class Protocol, class Executor, class RatePolicy>
 template<class Executor2>
 void
@@ -67,6 +94,14 @@ on_timer(Executor2 const& ex2)
 {
     BOOST_ASSERT(waiting > 0);
 
+    // the policy refills on a schedule of its own
+    if(rate_policy_access::has_refill_time<RatePolicy>::value)
+    {
+        --waiting;
+        rate_policy_access::on_timer(policy());
+        return;
+    }
+
     // the last waiter starts the new slice
     if(--waiting > 0)
         return;
@@ -118,6 +153,40 @@ on_timer(Executor2 const& ex2)
     timer.async_wait(handler(ex2, this->shared_from_this()));
 }
 
+template<class Protocol, class Executor, class RatePolicy>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+add_waiter()
+{
+    add_waiter(policy(), rate_policy_access::
+        has_refill_time<RatePolicy>{});
+}
+
+template<class Protocol, class Executor, class RatePolicy>
+template<class Policy>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+add_waiter(Policy& policy, std::true_type)
+{
+    // the first waiter sets the timer to the next
+    // refill, any other waiter is already on it
+    if(waiting++ == 0)
+        timer.expires_at(
+            rate_policy_access::refill_time(policy));
+}
+
+template<class Protocol, class Executor, class RatePolicy>
+template<class Policy>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+add_waiter(Policy&, std::false_type)
+{
+    ++waiting;
+}
+
 template<class Protocol, class Executor, class RatePolicy>
 void
 basic_stream<Protocol, Executor, RatePolicy>::
@@ -208,6 +277,55 @@ struct basic_stream<Protocol, Executor, RatePolicy>::
     }
 };
 
+template<class Protocol, class Executor, class RatePolicy>
+template<class Executor2>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+arm(op_state& state, Executor2 const& ex2)
+{
+    if(wheel)
+    {
+        state.entry.owner = this;
+        state.entry.on_expire = &impl_type::on_wheel_timeout;
+        wheel->insert(state.entry, state.timer.expiry());
+        return;
+    }
+    state.timer.async_wait(
+        timeout_handler<Executor2>{
+            state,
+            this->shared_from_this(),
+            state.tick,
+            ex2});
+}
+
+template<class Protocol, class Executor, class RatePolicy>
+std::size_t
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+disarm(op_state& state)
+{
+    if(wheel)
+        return wheel->remove(state.entry) ? 1 : 0;
+    return state.timer.cancel();
+}
+
+template<class Protocol, class Executor, class RatePolicy>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+impl_type::
+on_wheel_timeout(detail::timer_wheel_entry& e)
+{
+    // The wheel runs on the strand of the stream, and the entry
+    // is removed when the operation completes, so this is never
+    // stale.
+    auto& impl = *static_cast<impl_type*>(e.owner);
+    auto& state = &e == &impl.read.entry ? impl.read : impl.write;
+    BOOST_ASSERT(! state.timeout);
+    impl.close();
+    state.timeout = true;
+}
+
 //------------------------------------------------------------------------------
 
 template<class Protocol, class Executor, class RatePolicy>
@@ -268,12 +386,48 @@ class transfer_op
     void
     async_perform(
         std::size_t amount, std::false_type)
+    {
+        async_perform_write(amount, b_);
+    }
+
+    template<class ConstBufferSequence>
+    void
+    async_perform_write(
+        std::size_t amount,
+        ConstBufferSequence const& b)
     {
         impl_->socket.async_write_some(
-            beast::buffers_prefix(amount, b_),
+            beast::buffers_prefix(amount, b),
                 std::move(*this));
     }
 
+    template<class WriteFn>
+    void
+    async_perform_write(
+        std::size_t amount,
+        detail::stream_write_fn<WriteFn> const& b)
+    {
+        // *this is moved from by the call
+        auto const f = b.f;
+        f(impl_->socket, amount, std::move(*this));
+    }
+
+    template<class ConstBufferSequence>
+    static
+    bool
+    is_empty(ConstBufferSequence const& b)
+    {
+        return detail::buffers_empty(b);
+    }
+
+    template<class WriteFn>
+    static
+    bool
+    is_empty(detail::stream_write_fn<WriteFn> const&)
+    {
+        return false;
+    }
+
     static bool never_pending_;
 
 public:
@@ -289,7 +443,7 @@ public:
         , b_(b)
     {
         this->set_allowed_cancellation(net::cancellation_type::all);
-        if (buffer_bytes(b_) == 0 && state().pending)
+        if (is_empty(b_) && state().pending)
         {
             // Workaround:
             // Corner case discovered in https://github.com/boostorg/beast/issues/2065
@@ -335,7 +489,7 @@ public:
             }
 
             // handle empty buffers
-            if(detail::buffers_empty(b_))
+            if(is_empty(b_))
             {
                 // make sure we perform the no-op
                 BOOST_ASIO_CORO_YIELD
@@ -358,12 +512,7 @@ public:
                     (isRead ? "basic_stream::async_read_some"
                         : "basic_stream::async_write_some")));
 
-                state().timer.async_wait(
-                    timeout_handler<decltype(this->get_executor())>{
-                        state(),
-                        impl_,
-                        state().tick,
-                        this->get_executor()});
+                impl_->arm(state(), this->get_executor());
             }
 
             // check rate limit, maybe wait
@@ -371,7 +520,7 @@ public:
             amount = available_bytes();
             if(amount == 0)
             {
-                ++impl_->waiting;
+                impl_->add_waiter();
                 BOOST_ASIO_CORO_YIELD
                 {
                     BOOST_ASIO_HANDLER_LOCATION((
@@ -419,7 +568,7 @@ public:
 
                 // try cancelling timer
                 auto const n =
-                    state().timer.cancel();
+                    impl_->disarm(state());
                 if(n == 0)
                 {
                     // timeout handler invoked?
@@ -478,12 +627,7 @@ public:
                 __FILE__, __LINE__,
                 "basic_stream::async_connect"));
 
-            impl_->write.timer.async_wait(
-                timeout_handler<decltype(this->get_executor())>{
-                    state(),
-                    impl_,
-                    state().tick,
-                    this->get_executor()});
+            impl_->arm(state(), this->get_executor());
         }
 
         BOOST_ASIO_HANDLER_LOCATION((
@@ -516,12 +660,7 @@ public:
                 __FILE__, __LINE__,
                 "basic_stream::async_connect"));
 
-            impl_->write.timer.async_wait(
-                timeout_handler<decltype(this->get_executor())>{
-                    state(),
-                    impl_,
-                    state().tick,
-                    this->get_executor()});
+            impl_->arm(state(), this->get_executor());
         }
 
         BOOST_ASIO_HANDLER_LOCATION((
@@ -554,12 +693,7 @@ public:
                 __FILE__, __LINE__,
                 "basic_stream::async_connect"));
 
-            impl_->write.timer.async_wait(
-                timeout_handler<decltype(this->get_executor())>{
-                    state(),
-                    impl_,
-                    state().tick,
-                    this->get_executor()});
+            impl_->arm(state(), this->get_executor());
         }
 
         BOOST_ASIO_HANDLER_LOCATION((
@@ -581,7 +715,7 @@ public:
 
             // try cancelling timer
             auto const n =
-                impl_->write.timer.cancel();
+                impl_->disarm(state());
             if(n == 0)
             {
                 // timeout handler invoked?
@@ -910,6 +1044,22 @@ expires_never()
     impl_->reset();
 }
 
+template<class Protocol, class Executor, class RatePolicy>
+void
+basic_stream<Protocol, Executor, RatePolicy>::
+set_timer_wheel(timer_wheel const& wheel)
+{
+    // If assert goes off, it means that there are
+    // read or write (or connect) operations outstanding,
+    // whose timeouts would be lost.
+    //
+    BOOST_ASSERT(
+        ! impl_->read.pending &&
+        ! impl_->write.pending);
+
+    impl_->wheel = wheel.impl_;
+}
+
 template<class Protocol, class Executor, class RatePolicy>
 void
 basic_stream<Protocol, Executor, RatePolicy>::
@@ -1072,6 +1222,39 @@ async_write_some(
             buffers);
 }
 
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// Lets other parts of the library write to the socket of a
+// basic_stream themselves, under the write timeout and rate
+// limit of the stream.
+struct basic_stream_access
+{
+    template<
+        class Protocol, class Executor, class RatePolicy,
+        class WriteFn,
+        BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+    static
+    BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+    async_write_some(
+        basic_stream<Protocol, Executor, RatePolicy>& stream,
+        WriteFn const& f,
+        WriteHandler&& handler)
+    {
+        using ops = typename basic_stream<
+            Protocol, Executor, RatePolicy>::ops;
+        return net::async_initiate<
+            WriteHandler,
+            void(error_code, std::size_t)>(
+                typename ops::run_write_op{&stream},
+                handler,
+                stream_write_fn<WriteFn>{f});
+    }
+};
+
+} // detail
+
 //------------------------------------------------------------------------------
 //
 // Customization points
@@ -11,8 +11,12 @@
 #define BOOST_BEAST_CORE_RATE_POLICY_HPP
 
 #include <boost/beast/core/detail/config.hpp>
+#include <boost/type_traits/make_void.hpp>
+#include <chrono>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace beast {
@@ -87,6 +91,28 @@ private:
     {
         return policy.on_timer();
     }
+
+    // Policies with a `refill_time()` member are refilled on a
+    // schedule of their own, and streams waiting for bytes wait
+    // until that time instead of running a timer every second.
+    template<class Policy, class = void>
+    struct has_refill_time : std::false_type
+    {
+    };
+
+    template<class Policy>
+    struct has_refill_time<Policy, boost::void_t<decltype(
+        std::declval<Policy&>().refill_time())>> : std::true_type
+    {
+    };
+
+    template<class Policy>
+    static
+    std::chrono::steady_clock::time_point
+    refill_time(Policy& policy)
+    {
+        return policy.refill_time();
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,282 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_SHARED_RATE_POLICY_HPP
+#define BOOST_BEAST_CORE_SHARED_RATE_POLICY_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/detail/rate_limiter.hpp>
+#include <boost/beast/core/rate_policy.hpp>
+#include <boost/core/exchange.hpp>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+namespace boost {
+namespace beast {
+
+/** A limit on the combined throughput of many streams.
+
+    A rate limiter holds a pair of token buckets, for reads and
+    for writes, from which every stream using it through a
+    @ref shared_rate_policy takes the bytes it transfers. Limiters
+    form a tree: a limiter made with @ref child also counts the
+    bytes against its parent, so a stream can be subject to a
+    per-tenant limit under a global one, or a limit of its own
+    under both.
+
+    The buckets of a tree refill together once every resolution
+    of the root, on a tick computed from the clock rather than
+    driven by a timer, and hold at most one tick worth of bytes.
+    When streams are waiting for a bucket to refill, each one
+    is allowed an equal share of what the bucket has left, so
+    that a busy stream cannot starve the others.
+
+    Objects of this type are handles: copies refer to the same
+    limiter, which lives as long as any copy, child or policy
+    using it.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe. Streams using the same limiter
+    may run on different threads.
+
+    @par Example
+    @code
+    beast::rate_limiter global;
+    global.write_limit(100 * 1024 * 1024);
+
+    beast::rate_limiter tenant = global.child();
+    tenant.write_limit(1024 * 1024);
+
+    beast::basic_stream<
+        net::ip::tcp,
+        net::any_io_executor,
+        beast::shared_rate_policy> stream(
+            beast::shared_rate_policy(tenant), ioc);
+    @endcode
+
+    @see shared_rate_policy
+*/
+class rate_limiter
+{
+    friend class shared_rate_policy;
+
+    std::shared_ptr<detail::rate_limiter_node> impl_;
+
+    explicit
+    rate_limiter(std::shared_ptr<
+        detail::rate_limiter_node> impl) noexcept
+        : impl_(std::move(impl))
+    {
+    }
+
+public:
+    /// The type of duration used for the resolution
+    using duration = std::chrono::steady_clock::duration;
+
+    /** Constructor
+
+        This creates the root of a new tree of limiters,
+        initially without limits.
+
+        @param resolution The interval at which the buckets
+        refill. Shorter intervals spread the transfers more
+        evenly over time.
+
+        @throws std::invalid_argument if `resolution` is not positive.
+    */
+    explicit
+    rate_limiter(
+        duration resolution = std::chrono::milliseconds(100))
+        : impl_(std::make_shared<detail::rate_limiter_node>(
+            std::make_shared<detail::rate_limiter_root>(resolution)))
+    {
+    }
+
+    /** Return a new limiter below this one.
+
+        Bytes transferred by streams using the returned limiter
+        also count against this limiter and its ancestors. The
+        new limiter is initially without limits of its own.
+    */
+    rate_limiter
+    child() const
+    {
+        return rate_limiter(
+            std::make_shared<detail::rate_limiter_node>(
+                impl_->root(), impl_));
+    }
+
+    /// Set the limit of bytes per second to read
+    void
+    read_limit(std::size_t bytes_per_second)
+    {
+        impl_->limit(true, bytes_per_second);
+    }
+
+    /// Set the limit of bytes per second to write
+    void
+    write_limit(std::size_t bytes_per_second)
+    {
+        impl_->limit(false, bytes_per_second);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** A rate policy which draws from a shared @ref rate_limiter.
+
+    Streams using this policy take the bytes they read and write
+    from the buckets of a limiter and its ancestors. The bytes
+    offered to an operation are taken when it starts, and those it
+    did not transfer are returned when it completes, so operations
+    running at the same time never share the same bytes. A stream
+    which finds the buckets empty waits until the next tick of the
+    limiter, at the same time as every other stream waiting on the
+    tree, so no stream keeps a timer running once per second.
+
+    A default constructed policy applies no limit.
+
+    @par Concepts
+
+    @li <em>RatePolicy</em>
+
+    @see beast::basic_stream, rate_limiter
+*/
+class shared_rate_policy
+{
+#ifndef BOOST_BEAST_DOXYGEN
+    friend class rate_policy_access;
+#endif
+
+    std::shared_ptr<detail::rate_limiter_node> impl_;
+    detail::rate_limiter_node::ticket rd_;
+    detail::rate_limiter_node::ticket wr_;
+
+    static std::size_t constexpr all =
+        (std::numeric_limits<std::size_t>::max)();
+
+    std::size_t
+    available_read_bytes()
+    {
+        if(! impl_)
+            return all;
+        return impl_->available(true, rd_);
+    }
+
+    std::size_t
+    available_write_bytes()
+    {
+        if(! impl_)
+            return all;
+        return impl_->available(false, wr_);
+    }
+
+    void
+    transfer_read_bytes(std::size_t n)
+    {
+        if(impl_)
+            impl_->transfer(true, rd_, n);
+    }
+
+    void
+    transfer_write_bytes(std::size_t n)
+    {
+        if(impl_)
+            impl_->transfer(false, wr_, n);
+    }
+
+    void
+    on_timer() const noexcept
+    {
+    }
+
+    std::chrono::steady_clock::time_point
+    refill_time() const
+    {
+        if(! impl_)
+            return std::chrono::steady_clock::now();
+        return impl_->refill_time();
+    }
+
+    void
+    leave() noexcept
+    {
+        if(impl_)
+        {
+            impl_->leave(true, rd_);
+            impl_->leave(false, wr_);
+        }
+    }
+
+public:
+    /// Constructor
+    shared_rate_policy() = default;
+
+    /** Constructor
+
+        @param limiter The limiter to draw from.
+    */
+    explicit
+    shared_rate_policy(rate_limiter const& limiter) noexcept
+        : impl_(limiter.impl_)
+    {
+    }
+
+    /// Constructor
+    shared_rate_policy(shared_rate_policy const& other) noexcept
+        : impl_(other.impl_)
+    {
+    }
+
+    /// Constructor
+    shared_rate_policy(shared_rate_policy&& other) noexcept
+        : impl_(std::move(other.impl_))
+        , rd_(boost::exchange(other.rd_, {}))
+        , wr_(boost::exchange(other.wr_, {}))
+    {
+    }
+
+    /// Destructor
+    ~shared_rate_policy()
+    {
+        leave();
+    }
+
+    /// Assignment
+    shared_rate_policy&
+    operator=(shared_rate_policy const& other) noexcept
+    {
+        if(this != &other)
+        {
+            leave();
+            impl_ = other.impl_;
+        }
+        return *this;
+    }
+
+    /** Draw from a different limiter.
+
+        This function may only be called when no read or
+        write operation is outstanding on the stream.
+    */
+    void
+    set_limiter(rate_limiter const& limiter)
+    {
+        leave();
+        impl_ = limiter.impl_;
+    }
+};
+
+} // beast
+} // boost
+
+#endif
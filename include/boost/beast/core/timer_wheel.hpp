@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_CORE_TIMER_WHEEL_HPP
+#define BOOST_BEAST_CORE_TIMER_WHEEL_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/detail/timer_wheel.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace beast {
+
+#if ! BOOST_BEAST_DOXYGEN
+template<class, class, class>
+class basic_stream;
+#endif
+
+/** A hashed timing wheel shared by the timeouts of many streams.
+
+    By default, each @ref basic_stream waits on a timer of its own
+    for every operation which has a timeout, which puts an entry
+    in the timer queue of the execution context for each read and
+    write. A stream given a timing wheel with
+    @ref basic_stream::set_timer_wheel instead links its deadlines
+    into the slots of the wheel. Arming and disarming a deadline
+    then takes constant time and never allocates, and the wheel
+    itself waits on a single timer, which ticks at the resolution
+    of the wheel while any deadline is armed.
+
+    Timeouts are rounded up to the next tick, so they may expire
+    late by up to the resolution of the wheel, but never early.
+
+    Objects of this type are handles: copies refer to the same
+    wheel, which lives as long as any copy or any stream using it.
+
+    @par Thread Safety
+    The wheel is not protected by a lock. It must be used only
+    from the implicit or explicit strand of the executor it was
+    constructed with, and every stream using it must perform its
+    operations on that same strand. A typical arrangement is one
+    wheel per single-threaded `io_context`.
+
+    @par Example
+    @code
+    net::io_context ioc(1);
+    beast::timer_wheel wheel(ioc.get_executor());
+
+    beast::tcp_stream stream(ioc);
+    stream.set_timer_wheel(wheel);
+    stream.expires_after(std::chrono::seconds(30));
+    @endcode
+*/
+class timer_wheel
+{
+    template<class, class, class>
+    friend class basic_stream;
+
+    std::shared_ptr<detail::timer_wheel_impl> impl_;
+
+public:
+    /// The type of duration used for the resolution
+    using duration = std::chrono::steady_clock::duration;
+
+    /** Constructor
+
+        A default constructed wheel refers to no wheel. Giving
+        it to a stream makes the stream use its own timers.
+    */
+    timer_wheel() = default;
+
+    /** Constructor
+
+        @param ex The executor on which the wheel ticks.
+
+        @param resolution The interval between ticks, which is
+        the precision of the timeouts.
+
+        @param slots The number of slots, rounded up to a power
+        of two. Deadlines further out than this many ticks are
+        visited once per revolution of the wheel.
+
+        @throws std::invalid_argument if `resolution` is not positive.
+    */
+    explicit
+    timer_wheel(
+        net::any_io_executor ex,
+        duration resolution = std::chrono::milliseconds(100),
+        std::size_t slots = 512)
+        : impl_(std::make_shared<detail::timer_wheel_impl>(
+            std::move(ex), resolution, slots))
+    {
+    }
+
+    /// Returns `true` if this refers to a wheel
+    explicit
+    operator bool() const noexcept
+    {
+        return impl_ != nullptr;
+    }
+
+    /// Returns the interval between ticks
+    duration
+    resolution() const noexcept
+    {
+        return impl_->resolution();
+    }
+
+    /// Returns the number of deadlines currently armed
+    std::size_t
+    size() const noexcept
+    {
+        return impl_->size();
+    }
+};
+
+} // beast
+} // boost
+
+#endif
@@ -79,7 +79,9 @@ class basic_parser
     std::unique_ptr<char[]> buf_;           // temp storage
     std::size_t buf_len_ = 0;               // size of buf_
     std::uint32_t header_limit_ = 8192;     // max header size
+    std::uint32_t skip_ = 0;                // octets already scanned
     unsigned short status_ = 0;             // response status
+    unsigned char scan_ = 0;                // header scan state
     state state_ = state::nothing_yet;      // initial state
     unsigned f_ = 0;                        // flags
 
@@ -639,6 +641,11 @@ private:
         ConstBufferSequence const& buffers,
         error_code& ec);
 
+    bool
+    resume_header(
+        char const* p, char const* last,
+            error_code& ec);
+
     void
     inner_parse_start_line(
         char const*& p, char const* last,
@@ -0,0 +1,450 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DEFLATE_BODY_HPP
+#define BOOST_BEAST_HTTP_DEFLATE_BODY_HPP
+
+#include <boost/beast/http/deflate_body_fwd.hpp>
+
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/core/buffers_suffix.hpp>
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/type_traits.hpp>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/error.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A <em>Body</em> adaptor which applies a Content-Encoding
+
+    This wraps another body type, compressing its payload while
+    the message is serialized and decompressing the payload into
+    it while the message is parsed. The work is done in fixed size
+    pieces as the serializer pulls buffers or the parser pushes
+    them, so the encoded payload is never held in memory as a whole.
+
+    The caller is responsible for the header: the Content-Encoding
+    field should name the format, and since the encoded size is not
+    known in advance, @ref message::prepare_payload selects the
+    chunked Transfer-Encoding for HTTP/1.1 messages. When parsing,
+    the body limit of the parser applies to the encoded payload,
+    and the decoded payload is limited separately, see
+    @ref value_type.
+
+    Messages using this body type may be serialized and parsed if
+    the wrapped body type supports it.
+
+    @tparam Body The body type holding the decoded payload.
+
+    @tparam Format The encoding, either @ref zlib::Format::zlib
+    for `Content-Encoding: deflate` or @ref zlib::Format::gzip
+    for `Content-Encoding: gzip`.
+
+    @see deflate_body, gzip_body
+*/
+template<class Body, zlib::Format Format>
+struct basic_deflate_body
+{
+    static_assert(Format != zlib::Format::raw,
+        "Format requirements not met");
+
+    /** The type of container used for the body
+
+        This is the container of the wrapped body, holding the
+        decoded payload, together with the settings used when
+        the payload is encoded or decoded.
+    */
+    class value_type : public Body::value_type
+    {
+    public:
+        using Body::value_type::value_type;
+        using Body::value_type::operator=;
+
+        /** The compression level used when serializing
+
+            This is a value from 0 to 9, where 0 stores the
+            payload without compressing it, and 9 compresses
+            it the most.
+        */
+        int level = 6;
+
+        /** The window size used when serializing
+
+            This is the base two logarithm of the window size,
+            from 9 to 15. Smaller windows use less memory on both
+            sides, at the cost of compressing less.
+        */
+        int window_bits = 15;
+
+        /** The largest decoded payload accepted when parsing
+
+            Parsing fails with @ref error::body_limit when the
+            payload decodes to more octets than this, which
+            protects against a small message which expands to
+            an excessive size.
+        */
+        std::uint64_t decoded_limit = 8 * 1024 * 1024;
+    };
+
+    /** The algorithm for parsing the body
+
+        Meets the requirements of <em>BodyReader</em>.
+    */
+#if BOOST_BEAST_DOXYGEN
+    using reader = __implementation_defined__;
+#else
+    class reader
+    {
+        static std::size_t constexpr buffer_size = 8192;
+
+        value_type const& body_;
+        typename Body::reader inner_;
+        zlib::inflate_stream is_;
+        std::unique_ptr<char[]> buf_;
+        std::uint64_t remain_ = 0;  // decoded octets still allowed
+        std::size_t pos_ = 0;       // decoded octets given to inner_
+        std::size_t end_ = 0;       // decoded octets in buf_
+        bool pending_ = false;      // is_ has more decoded octets
+        bool started_ = false;      // some input was received
+        bool done_ = false;         // end of the encoded stream
+
+        // Decode into buf_, returning the number of octets consumed
+        std::size_t
+        decode(void const* data, std::size_t size, error_code& ec)
+        {
+            zlib::z_params zs;
+            zs.next_in = data;
+            zs.avail_in = size;
+            zs.next_out = buf_.get();
+            zs.avail_out = buffer_size;
+            is_.write(zs, zlib::Flush::sync, ec);
+            pos_ = 0;
+            end_ = buffer_size - zs.avail_out;
+            pending_ = zs.avail_out == 0;
+            if(ec == zlib::error::end_of_stream)
+            {
+                ec = {};
+                done_ = true;
+                pending_ = false;
+            }
+            else if(ec == zlib::error::need_buffers)
+            {
+                ec = {};
+            }
+            if(! ec)
+            {
+                if(end_ > remain_)
+                {
+                    BOOST_BEAST_ASSIGN_EC(ec, error::body_limit);
+                    end_ = 0;
+                    pending_ = false;
+                }
+                else
+                {
+                    remain_ -= end_;
+                }
+            }
+            return size - zs.avail_in;
+        }
+
+        // Give the decoded octets to the wrapped reader,
+        // returning `false` if some of them were not taken.
+        bool
+        drain(error_code& ec)
+        {
+            for(;;)
+            {
+                while(pos_ < end_)
+                {
+                    auto const n = inner_.put(net::const_buffer(
+                        buf_.get() + pos_, end_ - pos_), ec);
+                    pos_ += n;
+                    if(ec || n == 0)
+                        return false;
+                }
+                if(! pending_)
+                    return true;
+                decode(nullptr, 0, ec);
+                if(ec)
+                    return false;
+            }
+        }
+
+    public:
+        template<bool isRequest, class Fields>
+        explicit
+        reader(header<isRequest, Fields>& h, value_type& b)
+            : body_(b)
+            , inner_(h, b)
+        {
+            is_.reset(15, Format);
+        }
+
+        void
+        init(boost::optional<std::uint64_t> const&, error_code& ec)
+        {
+            buf_.reset(new char[buffer_size]);
+            remain_ = body_.decoded_limit;
+            // the decoded size is not known
+            inner_.init(boost::none, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        put(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            ec = {};
+            // Decoded octets left over from the last
+            // call are delivered before any new input
+            // is decoded.
+            if(! drain(ec))
+                return 0;
+            auto remain = buffer_bytes(buffers);
+            std::size_t used = 0;
+            for(net::const_buffer b :
+                    beast::buffers_range_ref(buffers))
+            {
+                while(b.size() > 0)
+                {
+                    if(done_)
+                    {
+                        // gzip members may be concatenated
+                        if(Format != zlib::Format::gzip)
+                        {
+                            BOOST_BEAST_ASSIGN_EC(ec,
+                                zlib::error::stream_error);
+                            return used;
+                        }
+                        is_.reset();
+                        done_ = false;
+                    }
+                    started_ = true;
+                    // The last octet of the input is decoded on its
+                    // own, once everything before it was taken by the
+                    // wrapped reader. Otherwise the parser could see
+                    // all of the input consumed and finish the body
+                    // while decoded octets are still waiting.
+                    auto const size = remain > 1 && b.size() == remain ?
+                        b.size() - 1 : b.size();
+                    auto const n = decode(b.data(), size, ec);
+                    b += n;
+                    used += n;
+                    remain -= n;
+                    if(ec)
+                        return used;
+                    if(! drain(ec))
+                        return used;
+                }
+            }
+            return used;
+        }
+
+        void
+        finish(error_code& ec)
+        {
+            ec = {};
+            if(! drain(ec))
+            {
+                // the wrapped reader did not take the last octets
+                if(! ec)
+                    BOOST_BEAST_ASSIGN_EC(ec, error::need_buffer);
+                return;
+            }
+            if(started_ && ! done_)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::partial_message);
+                return;
+            }
+            inner_.finish(ec);
+        }
+    };
+#endif
+
+    /** The algorithm for serializing the body
+
+        Meets the requirements of <em>BodyWriter</em>.
+    */
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer
+    {
+        static std::size_t constexpr buffer_size = 8192;
+
+        using inner_buffers_type =
+            typename Body::writer::const_buffers_type;
+
+        typename Body::writer inner_;
+        zlib::deflate_stream ds_;
+        std::unique_ptr<char[]> buf_;
+        boost::optional<
+            buffers_suffix<inner_buffers_type>> in_;
+        bool more_ = true;          // inner_ has more buffers
+        bool sync_ = false;         // inner_ is waiting for the caller
+        bool done_ = false;         // end of the encoded stream
+
+        // Flush what was compressed so far, so the peer sees
+        // it before the caller supplies more of the body.
+        bool
+        flush(zlib::z_params& zs)
+        {
+            auto const avail_out = zs.avail_out;
+            error_code ec;
+            zs.next_in = nullptr;
+            zs.avail_in = 0;
+            ds_.write(zs, zlib::Flush::sync, ec);
+            return zs.avail_out != avail_out;
+        }
+
+    public:
+        using const_buffers_type =
+            net::const_buffer;
+
+        // Constructible the same way as the wrapped writer
+        template<class Header, class Value,
+            class = typename std::enable_if<
+                std::is_constructible<typename Body::writer,
+                    Header&, Value&>::value>::type>
+        explicit
+        writer(Header& h, Value& b)
+            : inner_(h, b)
+        {
+            ds_.reset(b.level, b.window_bits, 8,
+                zlib::Strategy::normal, Format);
+        }
+
+        void
+        init(error_code& ec)
+        {
+            buf_.reset(new char[buffer_size]);
+            inner_.init(ec);
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(error_code& ec)
+        {
+            ec = {};
+            if(done_)
+                return boost::none;
+            zlib::z_params zs;
+            zs.next_out = buf_.get();
+            zs.avail_out = buffer_size;
+            if(sync_)
+            {
+                // The wrapped writer is not asked again until
+                // the caller has seen error::need_buffer.
+                if(! flush(zs))
+                {
+                    sync_ = false;
+                    BOOST_BEAST_ASSIGN_EC(ec, error::need_buffer);
+                    return boost::none;
+                }
+                return {{const_buffers_type{buf_.get(),
+                    buffer_size - zs.avail_out}, true}};
+            }
+            for(;;)
+            {
+                if(in_ && buffer_bytes(*in_) == 0)
+                    in_.reset();
+                if(! in_ && more_)
+                {
+                    auto result = inner_.get(ec);
+                    if(ec == error::need_buffer)
+                    {
+                        flush(zs);
+                        if(zs.avail_out == buffer_size)
+                            return boost::none;
+                        ec = {};
+                        sync_ = true;
+                        break;
+                    }
+                    if(ec)
+                        return boost::none;
+                    if(result)
+                    {
+                        in_.emplace(result->first);
+                        more_ = result->second;
+                        continue;
+                    }
+                    more_ = false;
+                }
+                net::const_buffer b;
+                if(in_)
+                {
+                    for(net::const_buffer cb :
+                            beast::buffers_range_ref(*in_))
+                    {
+                        if(cb.size() > 0)
+                        {
+                            b = cb;
+                            break;
+                        }
+                    }
+                }
+                zs.next_in = b.data();
+                zs.avail_in = b.size();
+                ds_.write(zs, in_ || more_ ?
+                    zlib::Flush::none : zlib::Flush::finish, ec);
+                if(in_)
+                    in_->consume(b.size() - zs.avail_in);
+                if(ec == zlib::error::end_of_stream)
+                {
+                    ec = {};
+                    done_ = true;
+                    break;
+                }
+                if(ec == zlib::error::need_buffers)
+                    ec = {};
+                else if(ec)
+                    return boost::none;
+                if(zs.avail_out == 0)
+                    break;
+            }
+            return {{const_buffers_type{buf_.get(),
+                buffer_size - zs.avail_out}, ! done_}};
+        }
+    };
+#endif
+};
+
+#if BOOST_BEAST_DOXYGEN
+/** A body adaptor for `Content-Encoding: deflate`
+
+    The payload of the wrapped body is sent and received in
+    the zlib format (rfc1950).
+*/
+template<class Body>
+using deflate_body = basic_deflate_body<Body, zlib::Format::zlib>;
+
+/** A body adaptor for `Content-Encoding: gzip`
+
+    The payload of the wrapped body is sent and received in
+    the gzip format (rfc1952).
+*/
+template<class Body>
+using gzip_body = basic_deflate_body<Body, zlib::Format::gzip>;
+#endif
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DEFLATE_BODY_FWD_HPP
+#define BOOST_BEAST_HTTP_DEFLATE_BODY_FWD_HPP
+
+#include <boost/beast/zlib/zlib.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Body, zlib::Format Format>
+struct basic_deflate_body;
+
+#ifndef BOOST_BEAST_DOXYGEN
+template<class Body>
+using deflate_body = basic_deflate_body<Body, zlib::Format::zlib>;
+
+template<class Body>
+using gzip_body = basic_deflate_body<Body, zlib::Format::gzip>;
+#endif
+
+} // http
+} // beast
+} // boost
+
+#endif
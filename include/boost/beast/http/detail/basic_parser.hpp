@@ -48,6 +48,28 @@ struct basic_parser_base
         complete
     };
 
+    // States of scan_header
+    enum : unsigned char
+    {
+        scan_method0 = 0,
+        scan_method,
+        scan_target0,
+        scan_target,
+        scan_version,                           // "HTTP/1.x"
+        scan_request_cr = scan_version + 8,
+        scan_request_lf,
+        scan_status_sp,
+        scan_status,                            // 3DIGIT SP
+        scan_reason = scan_status + 4,
+        scan_reason_lf,
+        scan_field0,
+        scan_field,
+        scan_name,
+        scan_value,
+        scan_value_lf,
+        scan_end_lf
+    };
+
     static
     bool
     is_digit(char c)
@@ -102,6 +124,13 @@ struct basic_parser_base
         char const* ranges,
         size_t ranges_size);
 
+    BOOST_BEAST_DECL
+    static
+    char const*
+    find_char(
+        char const* it, char const* last,
+            char c);
+
     BOOST_BEAST_DECL
     static
     char const*
@@ -181,6 +210,16 @@ struct basic_parser_base
         beast::detail::char_buffer<max_obs_fold>& buf,
         error_code& ec);
 
+    BOOST_BEAST_DECL
+    static
+    bool
+    scan_header(
+        char const* p,
+        char const* last,
+        bool isRequest,
+        unsigned char& state,
+        error_code& ec);
+
     BOOST_BEAST_DECL
     static
     void
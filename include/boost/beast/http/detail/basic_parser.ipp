@@ -11,7 +11,13 @@
 #define BOOST_BEAST_HTTP_DETAIL_BASIC_PARSER_IPP
 
 #include <boost/beast/http/detail/basic_parser.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
 #include <limits>
+#include <tuple>
 
 namespace boost {
 namespace beast {
@@ -104,6 +110,172 @@ unhex(unsigned char& d, char c)
 
 //--------------------------------------------------------------------------
 
+/*  Range scanning kernels for find_fast.
+
+    `ranges` holds up to eight inclusive [lo, hi] pairs of unsigned
+    octets, and must point to at least 16 readable bytes. Each kernel
+    only examines whole blocks; on a miss it returns the position where
+    it stopped, and the caller finishes the tail one octet at a time.
+*/
+using find_fast_fn = std::pair<char const*, bool>(*)(
+    char const*, char const*, char const*, std::size_t);
+
+inline
+std::pair<char const*, bool>
+find_fast_swar(
+    char const* buf,
+    char const* buf_end,
+    char const* ranges,
+    std::size_t ranges_size)
+{
+    // The high bit of each octet of a comparison result holds the
+    // answer for that octet. Subtracting seven-bit values with the
+    // high bit forced on never borrows across octets.
+    std::uint64_t constexpr ones = 0x0101010101010101;
+    std::uint64_t constexpr high = 0x8080808080808080;
+    auto const n = ranges_size / 2;
+    BOOST_ASSERT(n <= 8);
+    std::uint64_t lo[8];
+    std::uint64_t hi[8];
+    bool lo_high[8];
+    bool hi_high[8];
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const l = static_cast<unsigned char>(ranges[2 * i]);
+        auto const h = static_cast<unsigned char>(ranges[2 * i + 1]);
+        lo[i] = ones * (l & 0x7f);
+        hi[i] = ones * (h | 0x80);
+        lo_high[i] = l >= 0x80;
+        hi_high[i] = h >= 0x80;
+    }
+    while(buf_end - buf >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, buf, sizeof(w));
+        w = endian::native_to_little(w);
+        auto const x7 = w & ~high;
+        std::uint64_t m = 0;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            // w >= lo
+            auto const ge = (w | high) - lo[i];
+            auto const above = lo_high[i] ?
+                (w & ge) : (w | ge);
+            // w <= hi
+            auto const le = hi[i] - x7;
+            auto const below = hi_high[i] ?
+                (~w | le) : (~w & le);
+            m |= above & below;
+        }
+        m &= high;
+        if(m != 0)
+            return {buf + (core::countr_zero(m) >> 3), true};
+        buf += 8;
+    }
+    return {buf, false};
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET_SSE42
+inline
+std::pair<char const*, bool>
+find_fast_sse42(
+    char const* buf,
+    char const* buf_end,
+    char const* ranges,
+    std::size_t ranges_size)
+{
+    auto const ranges16 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(ranges));
+    auto const nranges = static_cast<int>(ranges_size);
+    while(buf_end - buf >= 16)
+    {
+        auto const b16 = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(buf));
+        int const r = _mm_cmpestri(ranges16, nranges, b16, 16,
+            _SIDD_LEAST_SIGNIFICANT |
+            _SIDD_CMP_RANGES |
+            _SIDD_UBYTE_OPS);
+        if(r != 16)
+            return {buf + r, true};
+        buf += 16;
+    }
+    return {buf, false};
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+std::pair<char const*, bool>
+find_fast_avx2(
+    char const* buf,
+    char const* buf_end,
+    char const* ranges,
+    std::size_t ranges_size)
+{
+    // x is in [lo, hi] when (x - lo) <= (hi - lo), unsigned
+    auto const n = ranges_size / 2;
+    BOOST_ASSERT(n <= 8);
+    __m256i lo[8];
+    __m256i width[8];
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        lo[i] = _mm256_set1_epi8(ranges[2 * i]);
+        width[i] = _mm256_set1_epi8(static_cast<char>(
+            ranges[2 * i + 1] - ranges[2 * i]));
+    }
+    while(buf_end - buf >= 32)
+    {
+        auto const b32 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(buf));
+        auto m = _mm256_setzero_si256();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto const d = _mm256_sub_epi8(b32, lo[i]);
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(
+                _mm256_min_epu8(d, width[i]), d));
+        }
+        auto const mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(m));
+        if(mask != 0)
+            return {buf + core::countr_zero(mask), true};
+        buf += 32;
+    }
+    return find_fast_sse42(buf, buf_end, ranges, ranges_size);
+}
+
+#endif
+
+inline
+std::pair<char const*, bool>
+find_fast_none(
+    char const* buf,
+    char const*,
+    char const*,
+    std::size_t)
+{
+    return {buf, false};
+}
+
+// The vector kernels test every range on each block, so
+// pcmpestri wins on wide range sets while AVX2 and SWAR
+// only pay off when there are few ranges to check.
+inline
+find_fast_fn
+select_find_fast(std::size_t nranges)
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2 && nranges <= 4)
+        return &find_fast_avx2;
+    if(ci.sse42)
+        return &find_fast_sse42;
+#endif
+    if(nranges <= 2)
+        return &find_fast_swar;
+    return &find_fast_none;
+}
+
 std::pair<char const*, bool>
 basic_parser_base::
 find_fast(
@@ -112,44 +284,153 @@ find_fast(
     char const* ranges,
     size_t ranges_size)
 {
-    bool found = false;
-    boost::ignore_unused(buf_end, ranges, ranges_size);
-    return {buf, found};
+    struct table
+    {
+        find_fast_fn fn[9];
+
+        table()
+        {
+            for(std::size_t i = 0; i < 9; ++i)
+                fn[i] = select_find_fast(i);
+        }
+    };
+
+    BOOST_ASSERT(ranges_size <= 16);
+    static table const tab;
+    return tab.fn[ranges_size / 2](
+        buf, buf_end, ranges, ranges_size);
+}
+
+/*  Single character search kernels for find_char.
+
+    Each returns a pointer to the first c in [buf, buf_end),
+    or buf_end if there is none.
+*/
+using find_char_fn = char const*(*)(char const*, char const*, char);
+
+inline
+char const*
+find_char_swar(
+    char const* buf,
+    char const* buf_end,
+    char c)
+{
+    // A zero octet in w ^ c sets its high bit in the result.
+    // Borrows only produce false positives above a real match,
+    // so the lowest set bit is exact.
+    std::uint64_t constexpr ones = 0x0101010101010101;
+    std::uint64_t constexpr high = 0x8080808080808080;
+    auto const cc = ones * static_cast<unsigned char>(c);
+    while(buf_end - buf >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, buf, sizeof(w));
+        w = endian::native_to_little(w) ^ cc;
+        auto const m = (w - ones) & ~w & high;
+        if(m != 0)
+            return buf + (core::countr_zero(m) >> 3);
+        buf += 8;
+    }
+    while(buf != buf_end && *buf != c)
+        ++buf;
+    return buf;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET_SSE2
+inline
+char const*
+find_char_sse2(
+    char const* buf,
+    char const* buf_end,
+    char c)
+{
+    auto const cc = _mm_set1_epi8(c);
+    while(buf_end - buf >= 16)
+    {
+        auto const mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(cc, _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(buf)))));
+        if(mask != 0)
+            return buf + core::countr_zero(mask);
+        buf += 16;
+    }
+    return find_char_swar(buf, buf_end, c);
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+char const*
+find_char_avx2(
+    char const* buf,
+    char const* buf_end,
+    char c)
+{
+    auto const cc = _mm256_set1_epi8(c);
+    while(buf_end - buf >= 32)
+    {
+        auto const mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(cc, _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(buf)))));
+        if(mask != 0)
+            return buf + core::countr_zero(mask);
+        buf += 32;
+    }
+    return find_char_sse2(buf, buf_end, c);
+}
+
+#endif
+
+inline
+find_char_fn
+select_find_char()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        return &find_char_avx2;
+    if(ci.sse2)
+        return &find_char_sse2;
+#endif
+    return &find_char_swar;
+}
+
+char const*
+basic_parser_base::
+find_char(
+    char const* it, char const* last, char c)
+{
+    static find_char_fn const fn = select_find_char();
+    return fn(it, last, c);
 }
 
-// VFALCO Can SIMD help this?
 char const*
 basic_parser_base::
 find_eol(
     char const* it, char const* last,
         error_code& ec)
 {
-    for(;;)
+    it = find_char(it, last, '\r');
+    if(it == last)
     {
-        if(it == last)
-        {
-            ec = {};
-            return nullptr;
-        }
-        if(*it == '\r')
-        {
-            if(++it == last)
-            {
-                ec = {};
-                return nullptr;
-            }
-            if(*it != '\n')
-            {
-                BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
-                return nullptr;
-            }
-            ec = {};
-            return ++it;
-        }
-        // VFALCO Should we handle the legacy case
-        // for lines terminated with a single '\n'?
-        ++it;
+        ec = {};
+        return nullptr;
     }
+    if(++it == last)
+    {
+        ec = {};
+        return nullptr;
+    }
+    if(*it != '\n')
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
+        return nullptr;
+    }
+    // VFALCO Should we handle the legacy case
+    // for lines terminated with a single '\n'?
+    ec = {};
+    return ++it;
 }
 
 bool
@@ -211,6 +492,13 @@ parse_token_to_eol(
     char const*& token_last,
     error_code& ec)
 {
+    // control characters except HTAB
+    BOOST_ALIGNMENT(16) static char const ranges[16] =
+        "\x00\x08"  /* 0x00-0x08 */
+        "\x0a\x1f"  /* 0x0a-0x1f */
+        "\x7f\x7f"; /* DEL */
+    bool found;
+    std::tie(p, found) = find_fast(p, last, ranges, 6);
     for(;; ++p)
     {
         if(p >= last)
@@ -311,7 +599,12 @@ parse_target(
     string_view& result, error_code& ec)
 {
     // parse target SP
+    BOOST_ALIGNMENT(16) static char const ranges[16] =
+        "\x00 "     /* control chars and up to SP */
+        "\x7f\x7f"; /* DEL */
     auto const first = it;
+    bool found;
+    std::tie(it, found) = find_fast(it, last, ranges, 4);
     for(;; ++it)
     {
         if(it + 1 > last)
@@ -634,6 +927,208 @@ parse_field(
 }
 
 
+bool
+basic_parser_base::
+scan_header(
+    char const* p,
+    char const* last,
+    bool isRequest,
+    unsigned char& state,
+    error_code& ec)
+{
+    // Octets which may appear in a reason-phrase or
+    // field-value: anything but CTLs, except HTAB
+    BOOST_ALIGNMENT(16) static char const text_ranges[16] =
+        "\x00\x08"  /* 0x00-0x08 */
+        "\x0a\x1f"  /* 0x0a-0x1f */
+        "\x7f\x7f"; /* DEL */
+    BOOST_ALIGNMENT(16) static char const path_ranges[16] =
+        "\x00 "     /* control chars and up to SP */
+        "\x7f\x7f"; /* DEL */
+    auto const is_text =
+        [](char c)
+        {
+            return static_cast<unsigned char>(c) >= 32 ?
+                c != 127 : c == '\t';
+        };
+    for(; p < last; ++p)
+    {
+        switch(state)
+        {
+        case scan_method0:
+        case scan_method:
+            if(detail::is_token_char(*p))
+            {
+                state = scan_method;
+                break;
+            }
+            if(*p != ' ' || state == scan_method0)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_method);
+                return false;
+            }
+            state = scan_target0;
+            break;
+
+        case scan_target0:
+        case scan_target:
+            if(is_pathchar(*p))
+            {
+                state = scan_target;
+                if(last - p >= 16)
+                    p = find_fast(p, last, path_ranges, 4).first;
+                while(p < last && is_pathchar(*p))
+                    ++p;
+                --p;
+                break;
+            }
+            if(*p != ' ' || state == scan_target0)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_target);
+                return false;
+            }
+            state = scan_version;
+            break;
+
+        case scan_request_cr:
+            if(*p != '\r')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_version);
+                return false;
+            }
+            state = scan_request_lf;
+            break;
+
+        case scan_request_lf:
+            if(*p != '\n')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_version);
+                return false;
+            }
+            return true;
+
+        case scan_status_sp:
+            if(*p != ' ')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_version);
+                return false;
+            }
+            state = scan_status;
+            break;
+
+        case scan_status + 3:
+            if(*p != ' ')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_status);
+                return false;
+            }
+            state = scan_reason;
+            break;
+
+        case scan_reason:
+        case scan_value:
+            if(is_text(*p))
+            {
+                if(last - p >= 16)
+                    p = find_fast(p, last, text_ranges, 6).first;
+                while(p < last && is_text(*p))
+                    ++p;
+                --p;
+                break;
+            }
+            if(*p != '\r')
+            {
+                if(state == scan_reason)
+                    BOOST_BEAST_ASSIGN_EC(ec, error::bad_reason);
+                else
+                    BOOST_BEAST_ASSIGN_EC(ec, error::bad_value);
+                return false;
+            }
+            state = state == scan_reason ?
+                scan_reason_lf : scan_value_lf;
+            break;
+
+        case scan_reason_lf:
+        case scan_end_lf:
+            if(*p != '\n')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
+                return false;
+            }
+            return true;
+
+        case scan_value_lf:
+            if(*p != '\n')
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_line_ending);
+                return false;
+            }
+            state = scan_field;
+            break;
+
+        case scan_field:
+            // obs-fold continues the value, anything
+            // else means the field before is complete
+            if(*p != ' ' && *p != '\t')
+                return true;
+            state = scan_value;
+            break;
+
+        case scan_field0:
+            if(*p == '\r')
+            {
+                state = scan_end_lf;
+                break;
+            }
+            BOOST_FALLTHROUGH;
+
+        case scan_name:
+            if(*p == ':' && state == scan_name)
+            {
+                state = scan_value;
+                break;
+            }
+            if(! detail::is_token_char(*p))
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_field);
+                return false;
+            }
+            state = scan_name;
+            break;
+
+        default:
+            if(state < scan_request_cr)
+            {
+                // HTTP-version, which must be 1.0 or 1.1
+                auto const i = state - scan_version;
+                if(i < 7 ? *p != "HTTP/1."[i] :
+                    (*p != '0' && *p != '1'))
+                {
+                    BOOST_BEAST_ASSIGN_EC(ec, error::bad_version);
+                    return false;
+                }
+                if(i < 7)
+                    ++state;
+                else if(isRequest)
+                    state = scan_request_cr;
+                else
+                    state = scan_status_sp;
+                break;
+            }
+            // status-code
+            BOOST_ASSERT(state < scan_status + 3);
+            if(! is_digit(*p))
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::bad_status);
+                return false;
+            }
+            ++state;
+            break;
+        }
+    }
+    return false;
+}
+
 void
 basic_parser_base::
 parse_chunk_extensions(
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_DETAIL_PERFECT_HASH_HPP
+#define BOOST_BEAST_HTTP_DETAIL_PERFECT_HASH_HPP
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace beast {
+namespace http {
+namespace detail {
+
+template<class T>
+T
+load_unaligned(char const* p) noexcept
+{
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    return endian::native_to_little(v);
+}
+
+// Load up to 8 bytes as a little endian word, zero filling the rest.
+// Short tails use two overlapping fixed-size loads,
+// which avoids a variable length memcpy.
+inline
+std::uint64_t
+load_word(char const* p, std::size_t n) noexcept
+{
+    if(n >= 8)
+        return load_unaligned<std::uint64_t>(p);
+    if(n >= 4)
+        return
+            std::uint64_t{load_unaligned<std::uint32_t>(p)} |
+            (std::uint64_t{load_unaligned<std::uint32_t>(
+                p + n - 4)} << ((n - 4) * 8));
+    if(n >= 2)
+        return
+            std::uint64_t{load_unaligned<std::uint16_t>(p)} |
+            (std::uint64_t{load_unaligned<std::uint16_t>(
+                p + n - 2)} << ((n - 2) * 8));
+    if(n == 1)
+        return static_cast<unsigned char>(*p);
+    return 0;
+}
+
+// Convert 'A'...'Z' in each byte to lowercase
+inline
+std::uint64_t
+ascii_tolower(std::uint64_t v) noexcept
+{
+    std::uint64_t constexpr ones = 0x0101010101010101;
+    std::uint64_t constexpr high = 0x8080808080808080;
+    auto const c = v & ~high;
+    auto const ge_a = c + (0x80 - 'A') * ones;
+    auto const gt_z = c + (0x7f - 'Z') * ones;
+    auto const upper = (ge_a ^ gt_z) & ~v & high;
+    return v | (upper >> 2);
+}
+
+inline
+std::uint64_t
+hash_mix(std::uint64_t h, std::uint64_t v) noexcept
+{
+    return (h ^ v) * 0x9e3779b97f4a7c15;
+}
+
+/*  A minimal perfect hash over a fixed set of N keys.
+
+    This uses hash-and-displace: keys are split into B buckets using
+    the high half of their digest, and each key has a home slot taken
+    from a second mix of the digest. Each bucket, largest first, is
+    then given the smallest displacement which moves all of its keys
+    to free slots. Two keys sharing both a bucket and a home slot can
+    never be separated, so the second mix is salted and the salt is
+    changed until every bucket fits.
+
+    A lookup is one multiply, one displacement load and one slot
+    load, after which the caller compares the key once.
+*/
+template<std::size_t N, std::size_t B>
+class perfect_hash
+{
+    std::uint64_t salt_ = 0;
+    std::uint16_t disp_[B];
+    std::uint16_t slot_[N];
+
+    static
+    std::size_t
+    reduce(std::uint64_t x, std::size_t n) noexcept
+    {
+        // maps a 32-bit value onto [0, n)
+        return static_cast<std::size_t>(
+            ((x & 0xffffffff) * n) >> 32);
+    }
+
+    static
+    std::size_t
+    bucket(std::uint64_t h) noexcept
+    {
+        return reduce(h >> 32, B);
+    }
+
+    std::size_t
+    home(std::uint64_t h) const noexcept
+    {
+        return reduce(((h ^ salt_) *
+            0xbf58476d1ce4e5b9) >> 32, N);
+    }
+
+    static
+    std::size_t
+    place(std::size_t home, std::size_t d) noexcept
+    {
+        home += d;
+        if(home >= N)
+            home -= N;
+        return home;
+    }
+
+    bool
+    build(std::uint64_t const* digests,
+        std::size_t const* order) noexcept
+    {
+        bool used[N] = {};
+        std::size_t keys[N];
+        std::size_t pos[N];
+        for(std::size_t n = 0; n < B; ++n)
+        {
+            auto const b = order[n];
+            disp_[b] = 0;
+            std::size_t m = 0;
+            for(std::size_t i = 0; i < N; ++i)
+                if(bucket(digests[i]) == b)
+                    keys[m++] = i;
+            std::size_t d = 0;
+            for(; m > 0 && d < N; ++d)
+            {
+                std::size_t k = 0;
+                for(; k < m; ++k)
+                {
+                    auto const j = place(home(digests[keys[k]]), d);
+                    if(used[j])
+                        break;
+                    used[j] = true;
+                    pos[k] = j;
+                }
+                if(k == m)
+                {
+                    for(k = 0; k < m; ++k)
+                        slot_[pos[k]] =
+                            static_cast<std::uint16_t>(keys[k]);
+                    disp_[b] = static_cast<std::uint16_t>(d);
+                    break;
+                }
+                while(k--)
+                    used[pos[k]] = false;
+            }
+            if(d == N)
+                return false;
+        }
+        return true;
+    }
+
+public:
+    // digests[i] is the digest of key i, all distinct
+    explicit
+    perfect_hash(std::uint64_t const* digests) noexcept
+    {
+        std::size_t count[B] = {};
+        std::size_t order[B];
+        for(std::size_t i = 0; i < N; ++i)
+            ++count[bucket(digests[i])];
+        for(std::size_t b = 0; b < B; ++b)
+            order[b] = b;
+        std::stable_sort(order, order + B,
+            [&](std::size_t lhs, std::size_t rhs)
+            {
+                return count[lhs] > count[rhs];
+            });
+        while(! build(digests, order))
+            salt_ += 0x9e3779b97f4a7c15;
+    }
+
+    // Returns the only key which can have this digest
+    std::size_t
+    operator()(std::uint64_t h) const noexcept
+    {
+        return slot_[place(home(h), disp_[bucket(h)])];
+    }
+};
+
+} // detail
+} // http
+} // beast
+} // boost
+
+#endif
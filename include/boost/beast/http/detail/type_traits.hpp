@@ -13,6 +13,7 @@
 #include <boost/beast/core/detail/type_traits.hpp>
 #include <boost/beast/http/message_fwd.hpp>
 #include <boost/beast/http/parser_fwd.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/optional.hpp>
 #include <cstdint>
 
@@ -38,8 +39,8 @@ using is_header = typename is_header_impl<T>::type;
 template<class T>
 struct is_parser : std::false_type {};
 
-template<bool isRequest, class Body, class Fields>
-struct is_parser<parser<isRequest, Body, Fields>> : std::true_type {};
+template<bool isRequest, class Body, class Allocator, class Fields>
+struct is_parser<parser<isRequest, Body, Allocator, Fields>> : std::true_type {};
 
 struct fields_model
 {
@@ -88,6 +89,21 @@ struct is_body_sized<T, beast::detail::void_t<
         T::size(std::declval<typename T::value_type const&>())
     )>> : std::true_type {};
 
+/** Determine if a <em>FieldsWriter</em> can flatten the header
+
+    This metafunction is equivalent to `std::true_type` if
+    the writer has a member function called `flatten` which
+    accepts a mutable buffer.
+*/
+template<class T, class = void>
+struct has_flatten : std::false_type {};
+
+template<class T>
+struct has_flatten<T, beast::detail::void_t<decltype(
+    std::declval<T&>().flatten(
+        std::declval<net::mutable_buffer>())
+    )>> : std::true_type {};
+
 template<class T>
 struct is_fields_helper : T
 {
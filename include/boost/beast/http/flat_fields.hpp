@@ -0,0 +1,823 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_FLAT_FIELDS_HPP
+#define BOOST_BEAST_HTTP_FLAT_FIELDS_HPP
+
+#include <boost/beast/http/flat_fields_fwd.hpp>
+
+#include <boost/beast/core/detail/allocator.hpp>
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A container for storing HTTP header fields in a single allocation.
+
+    This container holds the same information as @ref basic_fields
+    and offers the same interface, but keeps everything in one
+    growable block of memory obtained from the allocator: the
+    request-method, the request-target or reason-phrase, and every
+    field already formatted as `name: value\r\n` in iteration order.
+    A compact index sorted on the @ref field value of each element
+    (and on the name string, for unknown fields) is kept in the same
+    block for lookup. A typical header is built with a single
+    allocation, copied with a single allocation, and serialized as
+    one buffer for all of its fields.
+
+    When the container is iterated the fields are presented in the
+    order of insertion, with fields having the same name following
+    each other consecutively.
+
+    Unlike @ref basic_fields, modifying the container invalidates
+    all iterators and all string views previously obtained from it.
+
+    Meets the requirements of <em>Fields</em>
+
+    @tparam Allocator The allocator to use.
+*/
+template<class Allocator>
+class basic_flat_fields
+#if ! BOOST_BEAST_DOXYGEN
+    : private boost::empty_value<Allocator>
+#endif
+{
+    // Fancy pointers are not supported
+    static_assert(std::is_pointer<typename
+        std::allocator_traits<Allocator>::pointer>::value,
+        "Allocator must use regular pointers");
+
+    using pos_t = std::uint32_t;
+
+    // One per field, in iteration order
+    struct entry
+    {
+        pos_t off;          // offset of the line in the text
+        std::uint16_t nlen; // size of the name
+        std::uint16_t vlen; // size of the value
+        field f;
+    };
+
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /// The type of element used to represent a field
+    class value_type
+    {
+#ifndef BOOST_BEAST_DOXYGEN
+        friend class basic_flat_fields;
+#endif
+
+        field f_;
+        string_view name_;
+        string_view value_;
+
+        value_type(field name,
+            string_view sname, string_view value)
+            : f_(name)
+            , name_(sname)
+            , value_(value)
+        {
+        }
+
+    public:
+        /// Returns the field enum, which can be @ref boost::beast::http::field::unknown
+        field
+        name() const
+        {
+            return f_;
+        }
+
+        /// Returns the field name as a string
+        string_view const
+        name_string() const
+        {
+            return name_;
+        }
+
+        /// Returns the value of the field
+        string_view const
+        value() const
+        {
+            return value_;
+        }
+    };
+
+    /// The algorithm used to serialize the header
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer;
+#endif
+
+private:
+    using rebind_type = typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<entry>;
+
+    using alloc_traits =
+        beast::detail::allocator_traits<rebind_type>;
+
+    using pocma = typename
+        alloc_traits::propagate_on_container_move_assignment;
+
+    using pocca = typename
+        alloc_traits::propagate_on_container_copy_assignment;
+
+    using pocs = typename
+        alloc_traits::propagate_on_container_swap;
+
+public:
+    /// Maximum field name size
+    static std::size_t constexpr max_name_size =
+        (std::numeric_limits<std::uint16_t>::max)() - 2;
+
+    /// Maximum field value size
+    static std::size_t constexpr max_value_size =
+        (std::numeric_limits<std::uint16_t>::max)() - 2;
+
+    /// Destructor
+    ~basic_flat_fields();
+
+    /// Constructor.
+    basic_flat_fields() = default;
+
+    /** Constructor.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_flat_fields(Allocator const& alloc) noexcept;
+
+    /** Move constructor.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+    */
+    basic_flat_fields(basic_flat_fields&&) noexcept;
+
+    /** Move constructor.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+
+        @param alloc The allocator to use.
+    */
+    basic_flat_fields(basic_flat_fields&&, Allocator const& alloc);
+
+    /// Copy constructor.
+    basic_flat_fields(basic_flat_fields const&);
+
+    /** Copy constructor.
+
+        @param alloc The allocator to use.
+    */
+    basic_flat_fields(basic_flat_fields const&, Allocator const& alloc);
+
+    /// Copy constructor.
+    template<class OtherAlloc>
+    basic_flat_fields(basic_flat_fields<OtherAlloc> const&);
+
+    /** Copy constructor.
+
+        @param alloc The allocator to use.
+    */
+    template<class OtherAlloc>
+    basic_flat_fields(basic_flat_fields<OtherAlloc> const&,
+        Allocator const& alloc);
+
+    /** Move assignment.
+
+        The state of the moved-from object is
+        as if constructed using the same allocator.
+    */
+    basic_flat_fields& operator=(basic_flat_fields&&) noexcept(
+        pocma::value && std::is_nothrow_move_assignable<Allocator>::value);
+
+    /// Copy assignment.
+    basic_flat_fields& operator=(basic_flat_fields const&);
+
+    /// Copy assignment.
+    template<class OtherAlloc>
+    basic_flat_fields& operator=(basic_flat_fields<OtherAlloc> const&);
+
+public:
+    /// A constant iterator to the field sequence.
+#if BOOST_BEAST_DOXYGEN
+    using const_iterator = __implementation_defined__;
+#else
+    class const_iterator;
+#endif
+
+    /// A constant iterator to the field sequence.
+    using iterator = const_iterator;
+
+    /// Return a copy of the allocator associated with the container.
+    allocator_type
+    get_allocator() const
+    {
+        return this->get();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Element access
+    //
+    //--------------------------------------------------------------------------
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(field name) const;
+
+    /** Returns the value for a field, or throws an exception.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+
+        @return The field value.
+
+        @throws std::out_of_range if the field is not found.
+    */
+    string_view const
+    at(string_view name) const;
+
+    /** Returns the value for a field, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+    */
+    string_view const
+    operator[](field name) const;
+
+    /** Returns the value for a case-insensitive matching header, or `""` if it does not exist.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The name of the field.
+    */
+    string_view const
+    operator[](string_view name) const;
+
+    //--------------------------------------------------------------------------
+    //
+    // Iterators
+    //
+    //--------------------------------------------------------------------------
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    begin() const;
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    end() const;
+
+    /// Return a const iterator to the beginning of the field sequence.
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    /// Return a const iterator to the end of the field sequence.
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Capacity
+    //
+    //--------------------------------------------------------------------------
+
+    /// Returns `true` if there are no fields in the container.
+    bool
+    empty() const
+    {
+        return n_ == 0;
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Modifiers
+    //
+    //--------------------------------------------------------------------------
+
+    /** Remove all fields from the container
+
+        All references, pointers, or iterators referring to contained
+        elements are invalidated. All past-the-end iterators are also
+        invalidated. The memory block is retained for reuse.
+
+        @par Postconditions:
+        @code
+        std::distance(this->begin(), this->end()) == 0
+        @endcode
+    */
+    void
+    clear();
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error if name size exceeds
+        @ref max_name_size or value size exceeds @ref max_value_size.
+    */
+    void
+    insert(field name, string_view value);
+
+    void
+    insert(field, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error if name size exceeds
+        @ref max_name_size or value size exceeds @ref max_value_size.
+    */
+    void
+    insert(string_view name, string_view value);
+
+    void
+    insert(string_view, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param name_string The literal text corresponding to the
+        field name. If `name != field::unknown`, then this value
+        must be equal to `to_string(name)` using a case-insensitive
+        comparison, otherwise the behavior is undefined.
+
+        @param value The field value.
+
+        @throws boost::system::system_error if name size exceeds
+        @ref max_name_size or value size exceeds @ref max_value_size.
+    */
+    void
+    insert(field name, string_view name_string,
+        string_view value);
+
+    void
+    insert(field, string_view, std::nullptr_t) = delete;
+
+    /** Insert a field.
+
+        If one or more fields with the same name already exist,
+        the new field will be inserted after the last field with
+        the matching name, in serialization order.
+        The value can be an empty string.
+
+        @param name The field name.
+
+        @param name_string The literal text corresponding to the
+        field name. If `name != field::unknown`, then this value
+        must be equal to `to_string(name)` using a case-insensitive
+        comparison, otherwise the behavior is undefined.
+
+        @param value The field value.
+
+        @param ec Set to @ref error::header_field_name_too_large if
+        name size exceeds @ref max_name_size, or to
+        @ref error::header_field_value_too_large if value size exceeds
+        @ref max_value_size.
+    */
+    void
+    insert(field name, string_view name_string,
+        string_view value, error_code& ec);
+
+    void
+    insert(field, string_view, std::nullptr_t, error_code& ec) = delete;
+
+    /** Set a field value, removing any other instances of that field.
+
+        First removes any values with matching field names, then
+        inserts the new field value. The value can be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error if value size exceeds
+        @ref max_value_size.
+    */
+    void
+    set(field name, string_view value);
+
+    void
+    set(field, std::nullptr_t) = delete;
+
+    /** Set a field value, removing any other instances of that field.
+
+        First removes any values with matching field names, then
+        inserts the new field value. The value can be an empty string.
+
+        @param name The field name.
+
+        @param value The field value.
+
+        @throws boost::system::system_error if name size exceeds
+        @ref max_name_size or value size exceeds @ref max_value_size.
+    */
+    void
+    set(string_view name, string_view value);
+
+    void
+    set(string_view, std::nullptr_t) = delete;
+
+    /** Remove a field.
+
+        All references, pointers, or iterators referring to contained
+        elements are invalidated.
+
+        @param pos An iterator to the element to remove.
+
+        @return An iterator following the last removed element.
+        If the iterator refers to the last element, the end()
+        iterator is returned.
+    */
+    const_iterator
+    erase(const_iterator pos);
+
+    /** Remove all fields with the specified name.
+
+        All fields with the same field name are erased from the
+        container.
+
+        @param name The field name.
+
+        @return The number of fields removed.
+    */
+    std::size_t
+    erase(field name);
+
+    /** Remove all fields with the specified name.
+
+        All fields with the same field name are erased from the
+        container.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @return The number of fields removed.
+    */
+    std::size_t
+    erase(string_view name);
+
+    /// Swap this container with another
+    void
+    swap(basic_flat_fields& other);
+
+    /// Swap two field containers
+    template<class Alloc>
+    friend
+    void
+    swap(basic_flat_fields<Alloc>& lhs, basic_flat_fields<Alloc>& rhs);
+
+    //--------------------------------------------------------------------------
+    //
+    // Lookup
+    //
+    //--------------------------------------------------------------------------
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name.
+    */
+    std::size_t
+    count(field name) const;
+
+    /** Return the number of fields with the specified name.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+    */
+    std::size_t
+    count(string_view name) const;
+
+    /** Returns an iterator to the case-insensitive matching field.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The field name.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(field name) const;
+
+    /** Returns an iterator to the case-insensitive matching field name.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @param name The field name. It is interpreted as a case-insensitive string.
+
+        @return An iterator to the matching field, or `end()` if
+        no match was found.
+    */
+    const_iterator
+    find(string_view name) const;
+
+    /** Returns a range of iterators to the fields with the specified name.
+
+        The fields in the range are in insertion order.
+
+        @param name The field name.
+
+        @return A range of iterators to fields with the same name,
+        otherwise an empty range.
+    */
+    std::pair<const_iterator, const_iterator>
+    equal_range(field name) const;
+
+    /// @copydoc boost::beast::http::basic_flat_fields::equal_range(boost::beast::http::field) const
+    std::pair<const_iterator, const_iterator>
+    equal_range(string_view name) const;
+
+protected:
+    /** Returns the request-method string.
+
+        @note Only called for requests.
+    */
+    string_view
+    get_method_impl() const;
+
+    /** Returns the request-target string.
+
+        @note Only called for requests.
+    */
+    string_view
+    get_target_impl() const;
+
+    /** Returns the response reason-phrase string.
+
+        @note Only called for responses.
+    */
+    string_view
+    get_reason_impl() const;
+
+    /** Returns the chunked Transfer-Encoding setting
+    */
+    bool
+    get_chunked_impl() const;
+
+    /** Returns the keep-alive setting
+    */
+    bool
+    get_keep_alive_impl(unsigned version) const;
+
+    /** Returns `true` if the Content-Length field is present.
+    */
+    bool
+    has_content_length_impl() const;
+
+    /** Set or clear the method string.
+
+        @note Only called for requests.
+    */
+    void
+    set_method_impl(string_view s);
+
+    /** Set or clear the target string.
+
+        @note Only called for requests.
+    */
+    void
+    set_target_impl(string_view s);
+
+    /** Set or clear the reason string.
+
+        @note Only called for responses.
+    */
+    void
+    set_reason_impl(string_view s);
+
+    /** Adjusts the chunked Transfer-Encoding value
+    */
+    void
+    set_chunked_impl(bool value);
+
+    /** Sets or clears the Content-Length field
+    */
+    void
+    set_content_length_impl(
+        boost::optional<std::uint64_t> const& value);
+
+    /** Adjusts the Connection field
+    */
+    void
+    set_keep_alive_impl(
+        unsigned version, bool keep_alive);
+
+private:
+    template<class OtherAlloc>
+    friend class basic_flat_fields;
+
+    static
+    bool
+    key_less(
+        field f0, string_view s0,
+        field f1, string_view s1) noexcept;
+
+    entry*
+    table() const noexcept
+    {
+        return p_;
+    }
+
+    pos_t*
+    index() const noexcept
+    {
+        return reinterpret_cast<pos_t*>(p_ + slots_);
+    }
+
+    char*
+    text() const noexcept
+    {
+        return reinterpret_cast<char*>(p_) +
+            slots_ * (sizeof(entry) + sizeof(pos_t));
+    }
+
+    std::size_t
+    text_capacity() const noexcept
+    {
+        return units_ * sizeof(entry) -
+            slots_ * (sizeof(entry) + sizeof(pos_t));
+    }
+
+    std::size_t
+    fields_offset() const noexcept
+    {
+        return method_ + target_or_reason_;
+    }
+
+    value_type
+    element(std::size_t i) const noexcept;
+
+    bool
+    aliases(string_view s) const noexcept;
+
+    std::pair<std::size_t, std::size_t>
+    search(field name, string_view sname) const noexcept;
+
+    std::pair<std::size_t, std::size_t>
+    locate(field name, string_view sname) const noexcept;
+
+    bool
+    check_sizes(
+        string_view sname,
+        string_view value,
+        error_code& ec) const;
+
+    void
+    insert_element(
+        field name,
+        string_view sname,
+        string_view value);
+
+    void
+    set_element(
+        field name,
+        string_view sname,
+        string_view value);
+
+    void
+    insert_line(
+        std::size_t i,
+        std::size_t j,
+        field name,
+        string_view sname,
+        string_view value);
+
+    void
+    erase_lines(std::size_t first, std::size_t last);
+
+    void
+    set_start(
+        std::size_t off,
+        std::size_t& size,
+        string_view s,
+        bool space);
+
+    void
+    reserve(std::size_t slots, std::size_t text);
+
+    template<class OtherAlloc>
+    void
+    copy_all(basic_flat_fields<OtherAlloc> const&);
+
+    void
+    clear_all() noexcept;
+
+    void
+    release() noexcept;
+
+    void
+    steal(basic_flat_fields& other) noexcept;
+
+    void
+    move_assign(basic_flat_fields&, std::true_type);
+
+    void
+    move_assign(basic_flat_fields&, std::false_type);
+
+    void
+    copy_assign(basic_flat_fields const&, std::true_type);
+
+    void
+    copy_assign(basic_flat_fields const&, std::false_type);
+
+    void
+    swap(basic_flat_fields& other, std::true_type);
+
+    void
+    swap(basic_flat_fields& other, std::false_type);
+
+    /*  The block holds, in order:
+
+            entry[slots_]   the fields in iteration order
+            pos_t[slots_]   positions ordered by field and name
+            char[...]       method, target or reason, then
+                            "name: value\r\n" for each field
+    */
+    entry* p_ = nullptr;
+    std::size_t units_ = 0;             // size of the block in entries
+    std::size_t slots_ = 0;             // capacity of the tables
+    std::size_t n_ = 0;                 // number of fields
+    std::size_t size_ = 0;              // bytes of text in use
+    std::size_t method_ = 0;            // size of the method
+    std::size_t target_or_reason_ = 0;  // size of the target (with SP) or reason
+};
+
+#if BOOST_BEAST_DOXYGEN
+/// A header fields container which uses a single allocation
+using flat_fields = basic_flat_fields<std::allocator<char>>;
+#endif
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/flat_fields.hpp>
+
+#endif
@@ -223,6 +223,37 @@ put_eof(error_code& ec)
     this->on_finish_impl(ec);
 }
 
+template<bool isRequest>
+bool
+basic_parser<isRequest>::
+resume_header(
+    char const* p, char const* last, error_code& ec)
+{
+    // A header line can only complete once its LF has arrived.
+    // Unconsumed input is presented again on the next call, so
+    // only the octets not seen by the last call which needed more
+    // are scanned. The scan validates them as they arrive, and
+    // reports when a line the parse functions can complete is
+    // present. Each full parse starts a new scan at the line it
+    // stopped on.
+    auto const n = static_cast<std::size_t>(last - p);
+    if(skip_ == 0 || skip_ > n)
+    {
+        skip_ = 0;
+        if(state_ != state::start_line)
+            scan_ = scan_field0;
+        else if(is_request::value)
+            scan_ = scan_method0;
+        else
+            scan_ = scan_version;
+    }
+    if(scan_header(p + skip_, last,
+            is_request::value, scan_, ec))
+        return true;
+    skip_ = static_cast<std::uint32_t>(n);
+    return false;
+}
+
 template<bool isRequest>
 void
 basic_parser<isRequest>::
@@ -345,9 +376,18 @@ parse_start_line(
     char const*& in, std::size_t n, error_code& ec)
 {
     auto const p0 = in;
+    auto const last = in + (std::min<std::size_t>)
+        (n, header_limit_);
 
-    inner_parse_start_line(in, in + (std::min<std::size_t>)
-        (n, header_limit_), ec, is_request{});
+    if(resume_header(in, last, ec))
+    {
+        inner_parse_start_line(in, last, ec, is_request{});
+        skip_ = 0;
+    }
+    else if(! ec)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::need_more);
+    }
     if(ec == error::need_more && n >= header_limit_)
     {
         BOOST_BEAST_ASSIGN_EC(ec, error::header_limit);
@@ -402,9 +442,18 @@ basic_parser<isRequest>::
 parse_fields(char const*& in, std::size_t n, error_code& ec)
 {
     auto const p0 = in;
+    auto const last = in + (std::min<std::size_t>)
+        (n, header_limit_);
 
-    inner_parse_fields(in, in + (std::min<std::size_t>)
-        (n, header_limit_), ec);
+    if(resume_header(in, last, ec))
+    {
+        inner_parse_fields(in, last, ec);
+        skip_ = 0;
+    }
+    else if(! ec)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::need_more);
+    }
     if(ec == error::need_more && n >= header_limit_)
     {
         BOOST_BEAST_ASSIGN_EC(ec, error::header_limit);
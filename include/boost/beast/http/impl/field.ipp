@@ -11,6 +11,7 @@
 #define BOOST_BEAST_HTTP_IMPL_FIELD_IPP
 
 #include <boost/beast/http/field.hpp>
+#include <boost/beast/http/detail/perfect_hash.hpp>
 #include <boost/assert.hpp>
 #include <algorithm>
 #include <array>
@@ -27,88 +28,70 @@ namespace detail {
 
 struct field_table
 {
-    static
-    std::uint32_t
-    get_chars(
-        unsigned char const* p) noexcept
-    {
-        // VFALCO memcpy is endian-dependent
-        //std::memcpy(&v, p, 4);
-        // Compiler should be smart enough to
-        // optimize this down to one instruction.
-        return
-             p[0] |
-            (p[1] <<  8) |
-            (p[2] << 16) |
-            (p[3] << 24);
-    }
-
     using array_type =
         std::array<string_view, 357>;
 
-    // Strings are converted to lowercase
+    // The number of known fields
+    enum { N = 356 };
+
+    // Setting bit 5 of every byte folds case. It also folds
+    // some non-letters together, which only costs a mismatch
+    // in equals, since no two field names differ that way.
     static
-    std::uint32_t
-    digest(string_view s)
+    std::uint64_t
+    digest(string_view s) noexcept
     {
-        std::uint32_t r = 0;
+        std::uint64_t constexpr fold = 0x2020202020202020;
+        auto p = s.data();
         std::size_t n = s.size();
-        auto p = reinterpret_cast<
-            unsigned char const*>(s.data());
-        // consume N characters at a time
-        // VFALCO Can we do 8 on 64-bit systems?
-        while(n >= 4)
-        {
-            auto const v = get_chars(p);
-            r = (r * 5 + (
-                v | 0x20202020 )); // convert to lower
-            p += 4;
-            n -= 4;
-        }
-        // handle remaining characters
-        while( n > 0 )
+        std::uint64_t h = n;
+        // consume 8 characters at a time
+        while(n > 8)
         {
-            r = r * 5 + ( *p | 0x20 );
-            ++p;
-            --n;
+            h = hash_mix(h, load_word(p, 8) | fold);
+            p += 8;
+            n -= 8;
         }
-        return r;
+        return hash_mix(h, load_word(p, n) | fold);
     }
 
-    // This comparison is case-insensitive, and the
-    // strings must contain only valid http field characters.
     static
     bool
-    equals(string_view lhs, string_view rhs)
+    iequals(std::uint64_t v1, std::uint64_t v2) noexcept
     {
-        using Int = std::uint32_t; // VFALCO std::size_t?
-        auto n = lhs.size();
+        // names usually arrive in canonical case
+        return v1 == v2 ||
+            ascii_tolower(v1) == ascii_tolower(v2);
+    }
+
+    // This comparison is case-insensitive
+    static
+    bool
+    equals(string_view lhs, string_view rhs) noexcept
+    {
+        std::size_t n = lhs.size();
         if(n != rhs.size())
             return false;
-        auto p1 = reinterpret_cast<
-            unsigned char const*>(lhs.data());
-        auto p2 = reinterpret_cast<
-            unsigned char const*>(rhs.data());
-        auto constexpr S = sizeof(Int);
-        auto constexpr Mask = static_cast<Int>(
-            0xDFDFDFDFDFDFDFDF & ~Int{0});
-        for(; n >= S; p1 += S, p2 += S, n -= S)
-        {
-            Int const v1 = get_chars(p1);
-            Int const v2 = get_chars(p2);
-            if((v1 ^ v2) & Mask)
+        auto p1 = lhs.data();
+        auto p2 = rhs.data();
+        for(; n > 8; p1 += 8, p2 += 8, n -= 8)
+            if(! iequals(load_word(p1, 8), load_word(p2, 8)))
                 return false;
-        }
-        for(; n; ++p1, ++p2, --n)
-            if(( *p1 ^ *p2) & 0xDF)
-                return false;
-        return true;
+        return iequals(load_word(p1, n), load_word(p2, n));
     }
 
-    array_type by_name_;
+    static
+    std::array<std::uint64_t, N>
+    digests(array_type const& by_name) noexcept
+    {
+        std::array<std::uint64_t, N> v;
+        for(std::size_t i = 0; i < N; ++i)
+            v[i] = digest(by_name[i + 1]);
+        return v;
+    }
 
-    enum { N = 5155 };
-    unsigned char map_[ N ][ 2 ] = {};
+    array_type by_name_;
+    perfect_hash<N, 128> hash_;
 
 /*
     From:
@@ -476,42 +459,16 @@ struct field_table
             "X400-Trace",
             "Xref"
         }})
+        , hash_(digests(by_name_).data())
     {
-        for(std::size_t i = 1, n = 256; i < n; ++i)
-        {
-            auto sv = by_name_[ i ];
-            auto h = digest(sv);
-            auto j = h % N;
-            BOOST_ASSERT(map_[j][0] == 0);
-            map_[j][0] = static_cast<unsigned char>(i);
-        }
-
-        for(std::size_t i = 256, n = by_name_.size(); i < n; ++i)
-        {
-            auto sv = by_name_[i];
-            auto h = digest(sv);
-            auto j = h % N;
-            BOOST_ASSERT(map_[j][1] == 0);
-            map_[j][1] = static_cast<unsigned char>(i - 255);
-        }
     }
 
     field
-    string_to_field(string_view s) const
+    string_to_field(string_view s) const noexcept
     {
-        auto h = digest(s);
-        auto j = h % N;
-        int i = map_[j][0];
-        string_view s2 = by_name_[i];
-        if(i != 0 && equals(s, s2))
-            return static_cast<field>(i);
-        i = map_[j][1];
-        if(i == 0)
-            return field::unknown;
-        i += 255;
-        s2 = by_name_[i];
-
-        if(equals(s, s2))
+        // the hash yields the only candidate
+        auto const i = hash_(digest(s)) + 1;
+        if(equals(s, by_name_[i]))
             return static_cast<field>(i);
         return field::unknown;
     }
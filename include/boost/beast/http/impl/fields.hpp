@@ -23,6 +23,7 @@
 #include <boost/beast/http/chunk_encode.hpp>
 #include <boost/core/exchange.hpp>
 #include <boost/throw_exception.hpp>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -142,10 +143,16 @@ public:
         net::const_buffer,
         net::const_buffer,
         field_range,
-        chunk_crlf>;
+        net::const_buffer>;
+
+    using flat_type = std::basic_string<
+        char, std::char_traits<char>, typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<char>>;
 
     basic_fields const& f_;
     boost::optional<view_type> view_;
+    flat_type flat_;
     char buf_[13];
 
 public:
@@ -165,19 +172,51 @@ public:
     {
         return const_buffers_type(*view_);
     }
+
+    // Copy the header into one contiguous buffer, using
+    // `storage` if it is large enough and the allocator
+    // of the fields otherwise.
+    void
+    flatten(net::mutable_buffer storage);
 };
 
+template<class Allocator>
+void
+basic_fields<Allocator>::writer::
+flatten(net::mutable_buffer storage)
+{
+    auto const n = buffer_bytes(*view_);
+    char* p;
+    if(storage.size() >= n)
+    {
+        p = static_cast<char*>(storage.data());
+    }
+    else
+    {
+        flat_.resize(n);
+        p = &flat_[0];
+    }
+    net::buffer_copy(net::mutable_buffer(p, n), *view_);
+    view_.emplace(
+        net::const_buffer{p, n},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        field_range(f_.list_.end(), f_.list_.end()),
+        net::const_buffer{nullptr, 0});
+}
+
 template<class Allocator>
 basic_fields<Allocator>::writer::
 writer(basic_fields const& f)
     : f_(f)
+    , flat_(f.get_allocator())
 {
     view_.emplace(
         net::const_buffer{nullptr, 0},
         net::const_buffer{nullptr, 0},
         net::const_buffer{nullptr, 0},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf());
+        net::const_buffer{"\r\n", 2});
 }
 
 template<class Allocator>
@@ -185,6 +224,7 @@ basic_fields<Allocator>::writer::
 writer(basic_fields const& f,
         unsigned version, verb v)
     : f_(f)
+    , flat_(f.get_allocator())
 {
 /*
     request
@@ -219,7 +259,7 @@ writer(basic_fields const& f,
             f_.target_or_reason_.size()},
         net::const_buffer{buf_, 11},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf());
+        net::const_buffer{"\r\n", 2});
 }
 
 template<class Allocator>
@@ -227,6 +267,7 @@ basic_fields<Allocator>::writer::
 writer(basic_fields const& f,
         unsigned version, unsigned code)
     : f_(f)
+    , flat_(f.get_allocator())
 {
 /*
     response
@@ -259,7 +300,7 @@ writer(basic_fields const& f,
         net::const_buffer{sv.data(), sv.size()},
         net::const_buffer{"\r\n", 2},
         field_range(f_.list_.begin(), f_.list_.end()),
-        chunk_crlf{});
+        net::const_buffer{"\r\n", 2});
 }
 
 //------------------------------------------------------------------------------
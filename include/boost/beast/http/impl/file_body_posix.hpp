@@ -0,0 +1,941 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_FILE_BODY_POSIX_HPP
+#define BOOST_BEAST_HTTP_IMPL_FILE_BODY_POSIX_HPP
+
+#include <boost/beast/core/file_posix.hpp>
+
+#if ! defined(BOOST_BEAST_USE_POSIX_SENDFILE)
+# if BOOST_BEAST_USE_POSIX_FILE && defined(__linux__)
+#  define BOOST_BEAST_USE_POSIX_SENDFILE 1
+# else
+#  define BOOST_BEAST_USE_POSIX_SENDFILE 0
+# endif
+#endif
+
+#if BOOST_BEAST_USE_POSIX_SENDFILE
+
+#include <boost/beast/core/async_base.hpp>
+#include <boost/beast/core/basic_stream.hpp>
+#include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/core/detail/clamp.hpp>
+#include <boost/beast/core/detail/is_invocable.hpp>
+#include <boost/beast/http/error.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace detail {
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+sendfile_some(
+    net::basic_stream_socket<Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    std::size_t amount,
+    error_code& ec);
+} // detail
+
+template<>
+struct basic_file_body<file_posix>
+{
+    using file_type = file_posix;
+
+    class writer;
+    class reader;
+
+    //--------------------------------------------------------------------------
+
+    class value_type
+    {
+        friend class writer;
+        friend class reader;
+        friend struct basic_file_body<file_posix>;
+
+        template<
+            class Protocol, class Executor,
+            bool isRequest, class Fields>
+        friend
+        std::size_t
+        detail::sendfile_some(
+            net::basic_stream_socket<Protocol, Executor>& sock,
+            serializer<isRequest,
+                basic_file_body<file_posix>, Fields>& sr,
+            std::size_t amount,
+            error_code& ec);
+
+        file_posix file_;
+        std::uint64_t size_ = 0;    // cached file size
+        std::uint64_t first_ = 0;   // starting offset of the range
+        std::uint64_t last_ = 0;    // ending offset of the range
+
+    public:
+        ~value_type() = default;
+        value_type() = default;
+        value_type(value_type&& other) = default;
+        value_type& operator=(value_type&& other) = default;
+
+        file_posix& file()
+        {
+            return file_;
+        }
+
+        bool
+        is_open() const
+        {
+            return file_.is_open();
+        }
+
+        std::uint64_t
+        size() const
+        {
+            return last_ - first_;
+        }
+
+        void
+        close();
+
+        void
+        open(char const* path, file_mode mode, error_code& ec);
+
+        void
+        reset(file_posix&& file, error_code& ec);
+
+        void
+        seek(std::uint64_t offset, error_code& ec);
+    };
+
+    //--------------------------------------------------------------------------
+
+    class writer
+    {
+        template<
+            class Protocol, class Executor,
+            bool isRequest, class Fields>
+        friend
+        std::size_t
+        detail::sendfile_some(
+            net::basic_stream_socket<Protocol, Executor>& sock,
+            serializer<isRequest,
+                basic_file_body<file_posix>, Fields>& sr,
+            std::size_t amount,
+            error_code& ec);
+
+        value_type& body_;                       // The body we are reading from
+        std::uint64_t pos_;                      // The current position in the file
+        char buf_[BOOST_BEAST_FILE_BUFFER_SIZE]; // Small buffer for reading
+
+    public:
+        using const_buffers_type =
+            net::const_buffer;
+
+        template<bool isRequest, class Fields>
+        writer(header<isRequest, Fields>&, value_type& b)
+            : body_(b)
+            , pos_(body_.first_)
+        {
+            BOOST_ASSERT(body_.file_.is_open());
+        }
+
+        void
+        init(error_code& ec)
+        {
+            BOOST_ASSERT(body_.file_.is_open());
+            ec.clear();
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(error_code& ec)
+        {
+            std::size_t const n = (std::min)(sizeof(buf_),
+                beast::detail::clamp(body_.last_ - pos_));
+            if(n == 0)
+            {
+                ec = {};
+                return boost::none;
+            }
+            auto const nread = body_.file_.read(buf_, n, ec);
+            if(ec)
+                return boost::none;
+            if (nread == 0)
+            {
+                BOOST_BEAST_ASSIGN_EC(ec, error::short_read);
+                return boost::none;
+            }
+            BOOST_ASSERT(nread != 0);
+            pos_ += nread;
+            ec = {};
+            return {{
+                {buf_, nread},          // buffer to return.
+                pos_ < body_.last_}};   // `true` if there are more buffers.
+        }
+    };
+
+    //--------------------------------------------------------------------------
+
+    class reader
+    {
+        value_type& body_;
+
+    public:
+        template<bool isRequest, class Fields>
+        explicit
+        reader(header<isRequest, Fields>&, value_type& b)
+            : body_(b)
+        {
+        }
+
+        void
+        init(boost::optional<
+            std::uint64_t> const& content_length,
+                error_code& ec)
+        {
+            boost::ignore_unused(content_length);
+            BOOST_ASSERT(body_.file_.is_open());
+            ec = {};
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        put(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            std::size_t nwritten = 0;
+            for(auto buffer : beast::buffers_range_ref(buffers))
+            {
+                nwritten += body_.file_.write(
+                    buffer.data(), buffer.size(), ec);
+                if(ec)
+                    return nwritten;
+            }
+            ec = {};
+            return nwritten;
+        }
+
+        void
+        finish(error_code& ec)
+        {
+            ec = {};
+        }
+    };
+
+    //--------------------------------------------------------------------------
+
+    static
+    std::uint64_t
+    size(value_type const& body)
+    {
+        return body.size();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+inline
+void
+basic_file_body<file_posix>::
+value_type::
+close()
+{
+    error_code ignored;
+    file_.close(ignored);
+}
+
+inline
+void
+basic_file_body<file_posix>::
+value_type::
+open(char const* path, file_mode mode, error_code& ec)
+{
+    file_.open(path, mode, ec);
+    if(ec)
+        return;
+    size_ = file_.size(ec);
+    if(ec)
+    {
+        close();
+        return;
+    }
+    first_ = 0;
+    last_ = size_;
+}
+
+inline
+void
+basic_file_body<file_posix>::
+value_type::
+reset(file_posix&& file, error_code& ec)
+{
+    if(file_.is_open())
+    {
+        error_code ignored;
+        file_.close(ignored);
+    }
+    file_ = std::move(file);
+    size_ = 0;
+    first_ = 0;
+    last_ = 0;
+
+    auto const size = file_.size(ec);
+    if(ec)
+        return;
+
+    auto const pos = file_.pos(ec);
+    if(ec)
+        return;
+
+    size_ = size;
+    first_ = pos;
+    last_ = size;
+}
+
+inline
+void
+basic_file_body<file_posix>::
+value_type::
+seek(std::uint64_t offset, error_code& ec)
+{
+    file_.seek(offset, ec);
+    if(! ec)
+        first_ = offset;
+}
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+class null_lambda
+{
+public:
+    template<class ConstBufferSequence>
+    void
+    operator()(error_code&,
+        ConstBufferSequence const&) const
+    {
+        BOOST_ASSERT(false);
+    }
+};
+
+// Writes the header with a single gather write. When the body
+// follows in the same operation, MSG_MORE lets the kernel put the
+// start of the file in the same segment instead of sending the
+// header on its own.
+template<class Protocol, class Executor>
+class send_header_lambda
+{
+    net::basic_stream_socket<Protocol, Executor>& sock_;
+    int flags_;
+
+public:
+    bool invoked = false;
+    std::size_t bytes_transferred = 0;
+
+    send_header_lambda(
+        net::basic_stream_socket<Protocol, Executor>& sock,
+        int flags)
+        : sock_(sock)
+        , flags_(flags)
+    {
+    }
+
+    template<class ConstBufferSequence>
+    void
+    operator()(error_code& ec,
+        ConstBufferSequence const& buffers)
+    {
+        invoked = true;
+        bytes_transferred =
+            sock_.send(buffers, flags_, ec);
+    }
+};
+
+// The caller's split setting must be checked before the
+// header is split off: with split, as in write_header, the
+// body is not sent until the caller asks for it, and holding
+// back the header would delay it on the wire.
+template<bool isRequest, class Fields>
+int
+header_flags(
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr)
+{
+    if(! sr.split() && sr.get().body().size() > 0)
+        return MSG_MORE;
+    return 0;
+}
+
+inline
+bool
+is_would_block(error_code const& ec)
+{
+    return
+        ec == net::error::would_block ||
+        ec == net::error::try_again;
+}
+
+// Transfer at most `amount` bytes of the body from the file
+// to the socket in the kernel. The socket must be in
+// non-blocking mode when this is called from an asynchronous
+// operation.
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+sendfile_some(
+    net::basic_stream_socket<Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    std::size_t amount,
+    error_code& ec)
+{
+    // Linux transfers at most this many bytes per call
+    std::uint64_t constexpr max_sendfile = 0x7ffff000;
+
+    auto& w = sr.writer_impl();
+    std::size_t const n = static_cast<std::size_t>(
+        (std::min<std::uint64_t>)(
+            (std::min<std::uint64_t>)(w.body_.last_ - w.pos_, sr.limit()),
+            (std::min<std::uint64_t>)(amount, max_sendfile)));
+    std::size_t bytes_transferred = 0;
+    if(n > 0)
+    {
+        ::off_t offset = static_cast<::off_t>(w.pos_);
+        ::ssize_t result;
+        do
+        {
+            result = ::sendfile(
+                sock.native_handle(),
+                w.body_.file_.native_handle(),
+                &offset, n);
+        }
+        while(result < 0 && errno == EINTR);
+        if(result < 0)
+        {
+            ec.assign(errno, system_category());
+            return 0;
+        }
+        if(result == 0)
+        {
+            // the file was truncated
+            BOOST_BEAST_ASSIGN_EC(ec, error::short_read);
+            return 0;
+        }
+        bytes_transferred = static_cast<std::size_t>(result);
+        w.pos_ += bytes_transferred;
+    }
+    BOOST_ASSERT(w.pos_ <= w.body_.last_);
+    if(w.pos_ < w.body_.last_)
+    {
+        ec = {};
+    }
+    else
+    {
+        sr.next(ec, null_lambda{});
+        BOOST_ASSERT(! ec);
+        BOOST_ASSERT(sr.is_done());
+    }
+    return bytes_transferred;
+}
+
+// sendfile must not block the calling thread in an
+// asynchronous operation, so the socket is made non-blocking
+// for the duration of the call and then put back the way the
+// caller had it.
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+sendfile_some_non_blocking(
+    net::basic_stream_socket<Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    std::size_t amount,
+    error_code& ec)
+{
+    bool const non_blocking = sock.native_non_blocking();
+    if(! non_blocking)
+    {
+        sock.native_non_blocking(true, ec);
+        if(ec)
+            return 0;
+    }
+    auto const bytes_transferred =
+        sendfile_some(sock, sr, amount, ec);
+    if(! non_blocking)
+    {
+        error_code ignored;
+        sock.native_non_blocking(false, ignored);
+    }
+    return bytes_transferred;
+}
+
+//------------------------------------------------------------------------------
+
+// Sends at most `amount` bytes of the header
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields,
+    class Handler>
+class send_header_op
+    : public beast::async_base<Handler, Executor>
+{
+    net::basic_stream_socket<
+        Protocol, Executor>& sock_;
+
+    class lambda
+    {
+        send_header_op& op_;
+        std::size_t amount_;
+        int flags_;
+
+    public:
+        bool invoked = false;
+
+        lambda(
+            send_header_op& op,
+            std::size_t amount,
+            int flags)
+            : op_(op)
+            , amount_(amount)
+            , flags_(flags)
+        {
+        }
+
+        template<class ConstBufferSequence>
+        void
+        operator()(
+            error_code& ec,
+            ConstBufferSequence const& buffers)
+        {
+            BOOST_ASIO_HANDLER_LOCATION((
+                __FILE__, __LINE__,
+                "http::async_write_some"));
+
+            invoked = true;
+            ec = {};
+            op_.sock_.async_send(
+                beast::buffers_prefix(amount_, buffers),
+                    flags_, std::move(op_));
+        }
+    };
+
+public:
+    template<class Handler_>
+    send_header_op(
+        Handler_&& h,
+        net::basic_stream_socket<
+            Protocol, Executor>& sock,
+        serializer<isRequest,
+            basic_file_body<file_posix>, Fields>& sr,
+        int flags,
+        std::size_t amount)
+        : async_base<
+            Handler, Executor>(
+                std::forward<Handler_>(h),
+                sock.get_executor())
+        , sock_(sock)
+    {
+        error_code ec;
+        lambda f{*this, amount, flags};
+        sr.next(ec, f);
+        if(f.invoked)
+        {
+            // *this is now moved-from
+            return;
+        }
+        BOOST_ASSERT(ec);
+        this->complete(false, ec, 0);
+    }
+
+    void
+    operator()(
+        error_code ec,
+        std::size_t bytes_transferred)
+    {
+        this->complete_now(ec, bytes_transferred);
+    }
+};
+
+// Sends at most `amount` bytes of the body with sendfile,
+// waiting for the socket to become writable as needed
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields,
+    class Handler>
+class sendfile_op
+    : public beast::async_base<Handler, Executor>
+{
+    net::basic_stream_socket<
+        Protocol, Executor>& sock_;
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr_;
+    std::size_t amount_;
+
+    void
+    send(bool cont)
+    {
+        error_code ec;
+        auto const bytes_transferred =
+            sendfile_some_non_blocking(sock_, sr_, amount_, ec);
+        if(is_would_block(ec))
+        {
+            BOOST_ASIO_HANDLER_LOCATION((
+                __FILE__, __LINE__,
+                "http::async_write_some"));
+
+            return sock_.async_wait(
+                net::socket_base::wait_write,
+                    std::move(*this));
+        }
+        this->complete(cont, ec, bytes_transferred);
+    }
+
+public:
+    template<class Handler_>
+    sendfile_op(
+        Handler_&& h,
+        net::basic_stream_socket<
+            Protocol, Executor>& sock,
+        serializer<isRequest,
+            basic_file_body<file_posix>, Fields>& sr,
+        std::size_t amount)
+        : async_base<
+            Handler, Executor>(
+                std::forward<Handler_>(h),
+                sock.get_executor())
+        , sock_(sock)
+        , sr_(sr)
+        , amount_(amount)
+    {
+        send(false);
+    }
+
+    void
+    operator()(error_code ec)
+    {
+        if(ec)
+            return this->complete_now(ec, 0);
+        send(true);
+    }
+};
+
+// These start the operations above on the socket given to
+// them, writing at most `amount` bytes. The write operation
+// of basic_stream calls them with its rate limit and under
+// its write timeout.
+
+template<bool isRequest, class Fields>
+struct send_header_fn
+{
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr;
+    int flags;
+
+    template<class Protocol, class Executor, class Handler>
+    void
+    operator()(
+        net::basic_stream_socket<Protocol, Executor>& sock,
+        std::size_t amount,
+        Handler&& h) const
+    {
+        send_header_op<
+            Protocol, Executor,
+            isRequest, Fields,
+            typename std::decay<Handler>::type>(
+                std::forward<Handler>(h), sock, sr, flags, amount);
+    }
+};
+
+template<bool isRequest, class Fields>
+struct sendfile_fn
+{
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr;
+
+    template<class Protocol, class Executor, class Handler>
+    void
+    operator()(
+        net::basic_stream_socket<Protocol, Executor>& sock,
+        std::size_t amount,
+        Handler&& h) const
+    {
+        sendfile_op<
+            Protocol, Executor,
+            isRequest, Fields,
+            typename std::decay<Handler>::type>(
+                std::forward<Handler>(h), sock, sr, amount);
+    }
+};
+
+template<
+    class Protocol, class Executor,
+    class WriteFn, class Handler>
+void
+async_write_with(
+    net::basic_stream_socket<Protocol, Executor>& sock,
+    WriteFn const& f,
+    Handler&& h)
+{
+    f(sock, (std::numeric_limits<std::size_t>::max)(),
+        std::forward<Handler>(h));
+}
+
+template<
+    class Protocol, class Executor, class RatePolicy,
+    class WriteFn, class Handler>
+void
+async_write_with(
+    basic_stream<Protocol, Executor, RatePolicy>& stream,
+    WriteFn const& f,
+    Handler&& h)
+{
+    beast::detail::basic_stream_access::async_write_some(
+        stream, f, std::forward<Handler>(h));
+}
+
+//------------------------------------------------------------------------------
+
+template<
+    class Stream,
+    bool isRequest, class Fields,
+    class Handler>
+class write_some_posix_op
+    : public beast::async_base<
+        Handler, beast::executor_type<Stream>>
+{
+    Stream& s_;
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr_;
+    bool header_ = false;
+    bool split_ = false;
+
+public:
+    template<class Handler_>
+    write_some_posix_op(
+        Handler_&& h,
+        Stream& s,
+        serializer<isRequest,
+            basic_file_body<file_posix>,Fields>& sr)
+        : async_base<
+            Handler, beast::executor_type<Stream>>(
+                std::forward<Handler_>(h),
+                s.get_executor())
+        , s_(s)
+        , sr_(sr)
+    {
+        (*this)();
+    }
+
+    void
+    operator()()
+    {
+        BOOST_ASIO_HANDLER_LOCATION((
+            __FILE__, __LINE__,
+            "http::async_write_some"));
+
+        if(sr_.get().chunked())
+            return detail::async_write_some_impl(
+                s_, sr_, std::move(*this));
+        if(! sr_.is_header_done())
+        {
+            header_ = true;
+            auto const flags = header_flags(sr_);
+            split_ = sr_.split();
+            sr_.split(true);
+            return async_write_with(s_,
+                send_header_fn<isRequest, Fields>{sr_, flags},
+                std::move(*this));
+        }
+        async_write_with(s_,
+            sendfile_fn<isRequest, Fields>{sr_},
+            std::move(*this));
+    }
+
+    void
+    operator()(
+        error_code ec,
+        std::size_t bytes_transferred)
+    {
+        if(header_)
+        {
+            if(! ec)
+                sr_.consume(bytes_transferred);
+            sr_.split(split_);
+        }
+        this->complete_now(ec, bytes_transferred);
+    }
+};
+
+template<class Stream>
+struct run_write_some_posix_op
+{
+    Stream* stream;
+
+    using executor_type = beast::executor_type<Stream>;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return stream->get_executor();
+    }
+
+    template<bool isRequest, class Fields, class WriteHandler>
+    void
+    operator()(
+        WriteHandler&& h,
+        serializer<isRequest,
+            basic_file_body<file_posix>, Fields>* sr)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<WriteHandler,
+            void(error_code, std::size_t)>::value,
+            "WriteHandler type requirements not met");
+
+        write_some_posix_op<
+            Stream,
+            isRequest, Fields,
+            typename std::decay<WriteHandler>::type>(
+                std::forward<WriteHandler>(h), *stream, *sr);
+    }
+};
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields>
+std::size_t
+write_some(
+    net::basic_stream_socket<
+        Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    if(sr.get().chunked())
+        return detail::write_some_impl(sock, sr, ec);
+    if(! sr.is_header_done())
+    {
+        auto const split = sr.split();
+        detail::send_header_lambda<Protocol, Executor> f{
+            sock, detail::header_flags(sr)};
+        sr.split(true);
+        sr.next(ec, f);
+        if(! ec && f.invoked)
+            sr.consume(f.bytes_transferred);
+        sr.split(split);
+        return f.bytes_transferred;
+    }
+    for(;;)
+    {
+        auto const bytes_transferred =
+            detail::sendfile_some(sock, sr,
+                (std::numeric_limits<std::size_t>::max)(), ec);
+        // A socket left in non-blocking mode by an asynchronous
+        // operation still blocks here, unless the caller asked
+        // for non-blocking behavior.
+        if(! detail::is_would_block(ec) || sock.non_blocking())
+            return bytes_transferred;
+        sock.wait(net::socket_base::wait_write, ec);
+        if(ec)
+            return 0;
+    }
+}
+
+template<
+    class Protocol, class Executor, class RatePolicy,
+    bool isRequest, class Fields>
+std::size_t
+write_some(
+    basic_stream<Protocol, Executor, RatePolicy>& stream,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    error_code& ec)
+{
+    // Synchronous operations on basic_stream go
+    // straight to the socket, so this does too.
+    return write_some(stream.socket(), sr, ec);
+}
+
+template<
+    class Protocol, class Executor,
+    bool isRequest, class Fields,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write_some(
+    net::basic_stream_socket<
+        Protocol, Executor>& sock,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    WriteHandler&& handler)
+{
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            detail::run_write_some_posix_op<
+                net::basic_stream_socket<
+                    Protocol, Executor>>{&sock},
+            handler,
+            &sr);
+}
+
+template<
+    class Protocol, class Executor, class RatePolicy,
+    bool isRequest, class Fields,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write_some(
+    basic_stream<Protocol, Executor, RatePolicy>& stream,
+    serializer<isRequest,
+        basic_file_body<file_posix>, Fields>& sr,
+    WriteHandler&& handler)
+{
+    // The header and each sendfile call are performed by the
+    // write operation of the stream, so the write timeout covers
+    // waiting for the socket and each call is limited to the
+    // bytes the rate policy allows.
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            detail::run_write_some_posix_op<
+                basic_stream<Protocol, Executor, RatePolicy>>{&stream},
+            handler,
+            &sr);
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
+
+#endif
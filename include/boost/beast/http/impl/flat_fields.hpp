@@ -0,0 +1,1353 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_FLAT_FIELDS_HPP
+#define BOOST_BEAST_HTTP_IMPL_FLAT_FIELDS_HPP
+
+#include <boost/beast/core/buffers_cat.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/core/detail/buffers_ref.hpp>
+#include <boost/beast/core/detail/temporary_buffer.hpp>
+#include <boost/beast/core/static_string.hpp>
+#include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/rfc7230.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/detail/rfc7230.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/exchange.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Allocator>
+class basic_flat_fields<Allocator>::const_iterator
+{
+#ifndef BOOST_BEAST_DOXYGEN
+    friend class basic_flat_fields;
+#endif
+
+    basic_flat_fields const* f_ = nullptr;
+    std::size_t i_ = 0;
+
+    const_iterator(
+        basic_flat_fields const* f,
+        std::size_t i) noexcept
+        : f_(f)
+        , i_(i)
+    {
+    }
+
+public:
+    using value_type =
+        typename basic_flat_fields::value_type;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+    struct pointer
+    {
+        value_type v;
+
+        value_type const*
+        operator->() const noexcept
+        {
+            return &v;
+        }
+    };
+
+    const_iterator() = default;
+
+    bool
+    operator==(const_iterator const& other) const noexcept
+    {
+        return f_ == other.f_ && i_ == other.i_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return f_->element(i_);
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return pointer{**this};
+    }
+
+    const_iterator&
+    operator++() noexcept
+    {
+        ++i_;
+        return *this;
+    }
+
+    const_iterator
+    operator++(int) noexcept
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    const_iterator&
+    operator--() noexcept
+    {
+        --i_;
+        return *this;
+    }
+
+    const_iterator
+    operator--(int) noexcept
+    {
+        auto temp = *this;
+        --(*this);
+        return temp;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+class basic_flat_fields<Allocator>::writer
+{
+public:
+    // The fields are already formatted and
+    // contiguous, so they go out as one buffer.
+    using view_type = buffers_cat_view<
+        net::const_buffer,
+        net::const_buffer,
+        net::const_buffer,
+        net::const_buffer,
+        net::const_buffer>;
+
+private:
+    using flat_type = std::basic_string<
+        char, std::char_traits<char>, typename
+        beast::detail::allocator_traits<Allocator>::
+            template rebind_alloc<char>>;
+
+    basic_flat_fields const& f_;
+    boost::optional<view_type> view_;
+    flat_type flat_;
+    char buf_[13];
+
+    net::const_buffer
+    fields() const noexcept
+    {
+        auto const off = f_.fields_offset();
+        return {f_.text() + off, f_.size_ - off};
+    }
+
+public:
+    using const_buffers_type =
+        beast::detail::buffers_ref<view_type>;
+
+    writer(basic_flat_fields const& f,
+        unsigned version, verb v);
+
+    writer(basic_flat_fields const& f,
+        unsigned version, unsigned code);
+
+    writer(basic_flat_fields const& f);
+
+    const_buffers_type
+    get() const
+    {
+        return const_buffers_type(*view_);
+    }
+
+    // Copy the header into one contiguous buffer, using
+    // `storage` if it is large enough and the allocator
+    // of the fields otherwise.
+    void
+    flatten(net::mutable_buffer storage);
+};
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::writer::
+flatten(net::mutable_buffer storage)
+{
+    auto const n = buffer_bytes(*view_);
+    char* p;
+    if(storage.size() >= n)
+    {
+        p = static_cast<char*>(storage.data());
+    }
+    else
+    {
+        flat_.resize(n);
+        p = &flat_[0];
+    }
+    net::buffer_copy(net::mutable_buffer(p, n), *view_);
+    view_.emplace(
+        net::const_buffer{p, n},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0});
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::writer::
+writer(basic_flat_fields const& f)
+    : f_(f)
+    , flat_(f.get_allocator())
+{
+    view_.emplace(
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        net::const_buffer{nullptr, 0},
+        fields(),
+        net::const_buffer{"\r\n", 2});
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::writer::
+writer(basic_flat_fields const& f,
+        unsigned version, verb v)
+    : f_(f)
+    , flat_(f.get_allocator())
+{
+/*
+    request
+        "<method>"
+        " <target>"
+        " HTTP/X.Y\r\n" (11 chars)
+*/
+    string_view sv;
+    if(v == verb::unknown)
+        sv = f_.get_method_impl();
+    else
+        sv = to_string(v);
+
+    // the target has a leading SP
+
+    buf_[0] = ' ';
+    buf_[1] = 'H';
+    buf_[2] = 'T';
+    buf_[3] = 'T';
+    buf_[4] = 'P';
+    buf_[5] = '/';
+    buf_[6] = '0' + static_cast<char>(version / 10);
+    buf_[7] = '.';
+    buf_[8] = '0' + static_cast<char>(version % 10);
+    buf_[9] = '\r';
+    buf_[10]= '\n';
+
+    view_.emplace(
+        net::const_buffer{sv.data(), sv.size()},
+        net::const_buffer{
+            f_.text() + f_.method_,
+            f_.target_or_reason_},
+        net::const_buffer{buf_, 11},
+        fields(),
+        net::const_buffer{"\r\n", 2});
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::writer::
+writer(basic_flat_fields const& f,
+        unsigned version, unsigned code)
+    : f_(f)
+    , flat_(f.get_allocator())
+{
+/*
+    response
+        "HTTP/X.Y ### " (13 chars)
+        "<reason>"
+        "\r\n"
+*/
+    buf_[0] = 'H';
+    buf_[1] = 'T';
+    buf_[2] = 'T';
+    buf_[3] = 'P';
+    buf_[4] = '/';
+    buf_[5] = '0' + static_cast<char>(version / 10);
+    buf_[6] = '.';
+    buf_[7] = '0' + static_cast<char>(version % 10);
+    buf_[8] = ' ';
+    buf_[9] = '0' + static_cast<char>(code / 100);
+    buf_[10]= '0' + static_cast<char>((code / 10) % 10);
+    buf_[11]= '0' + static_cast<char>(code % 10);
+    buf_[12]= ' ';
+
+    string_view sv = f_.get_reason_impl();
+    if(sv.empty())
+        sv = obsolete_reason(static_cast<status>(code));
+
+    view_.emplace(
+        net::const_buffer{buf_, 13},
+        net::const_buffer{sv.data(), sv.size()},
+        net::const_buffer{"\r\n", 2},
+        fields(),
+        net::const_buffer{"\r\n", 2});
+}
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+~basic_flat_fields()
+{
+    release();
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+basic_flat_fields(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t(),
+        std::move(other.get()))
+{
+    steal(other);
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    if(this->get() != other.get())
+        copy_all(other);
+    else
+        steal(other);
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields const& other)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc_traits::
+        select_on_container_copy_construction(other.get()))
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields const& other,
+        Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields<OtherAlloc> const& other)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+basic_flat_fields<Allocator>::
+basic_flat_fields(basic_flat_fields<OtherAlloc> const& other,
+        Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t(), alloc)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+operator=(basic_flat_fields&& other) noexcept(
+    pocma::value && std::is_nothrow_move_assignable<Allocator>::value)
+    -> basic_flat_fields&
+{
+    if(this == &other)
+        return *this;
+    move_assign(other, pocma{});
+    return *this;
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+operator=(basic_flat_fields const& other) ->
+    basic_flat_fields&
+{
+    if(this == &other)
+        return *this;
+    copy_assign(other, pocca{});
+    return *this;
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+auto
+basic_flat_fields<Allocator>::
+operator=(basic_flat_fields<OtherAlloc> const& other) ->
+    basic_flat_fields&
+{
+    copy_all(other);
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+//
+// Element access
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+string_view const
+basic_flat_fields<Allocator>::
+at(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_flat_fields<Allocator>::
+at(string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{
+            "field not found"});
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_flat_fields<Allocator>::
+operator[](field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+template<class Allocator>
+string_view const
+basic_flat_fields<Allocator>::
+operator[](string_view name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return it->value();
+}
+
+//------------------------------------------------------------------------------
+//
+// Iterators
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+begin() const ->
+    const_iterator
+{
+    return const_iterator(this, 0);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+end() const ->
+    const_iterator
+{
+    return const_iterator(this, n_);
+}
+
+//------------------------------------------------------------------------------
+//
+// Modifiers
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+clear()
+{
+    size_ = fields_offset();
+    n_ = 0;
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+insert(field name, string_view value)
+{
+    BOOST_ASSERT(name != field::unknown);
+    insert(name, to_string(name), value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+insert(string_view sname, string_view value)
+{
+    insert(
+        string_to_field(sname), sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+insert(
+    field name,
+    string_view sname,
+    string_view value,
+    error_code& ec)
+{
+    ec = {};
+    if(! check_sizes(sname, value, ec))
+        return;
+    insert_element(name, sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+insert(field name,
+    string_view sname, string_view value)
+{
+    error_code ec;
+    if(! check_sizes(sname, value, ec))
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    insert_element(name, sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set(field name, string_view value)
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const sname = to_string(name);
+    error_code ec;
+    if(! check_sizes(sname, value, ec))
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    set_element(name, sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set(string_view sname, string_view value)
+{
+    error_code ec;
+    if(! check_sizes(sname, value, ec))
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    set_element(string_to_field(sname), sname, value);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+erase(const_iterator pos) ->
+    const_iterator
+{
+    BOOST_ASSERT(pos.f_ == this && pos.i_ < n_);
+    erase_lines(pos.i_, pos.i_ + 1);
+    return const_iterator(this, pos.i_);
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_fields<Allocator>::
+erase(field name)
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const r = locate(name, to_string(name));
+    erase_lines(r.first, r.second);
+    return r.second - r.first;
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_fields<Allocator>::
+erase(string_view name)
+{
+    auto const r = locate(string_to_field(name), name);
+    erase_lines(r.first, r.second);
+    return r.second - r.first;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+swap(basic_flat_fields<Allocator>& other)
+{
+    swap(other, pocs{});
+}
+
+template<class Allocator>
+void
+swap(
+    basic_flat_fields<Allocator>& lhs,
+    basic_flat_fields<Allocator>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+//------------------------------------------------------------------------------
+//
+// Lookup
+//
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+std::size_t
+basic_flat_fields<Allocator>::
+count(field name) const
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const r = search(name, to_string(name));
+    return r.second - r.first;
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_fields<Allocator>::
+count(string_view name) const
+{
+    auto const r = search(string_to_field(name), name);
+    return r.second - r.first;
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+find(field name) const ->
+    const_iterator
+{
+    BOOST_ASSERT(name != field::unknown);
+    return const_iterator(this,
+        locate(name, to_string(name)).first);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+find(string_view name) const ->
+    const_iterator
+{
+    return const_iterator(this,
+        locate(string_to_field(name), name).first);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+equal_range(field name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    BOOST_ASSERT(name != field::unknown);
+    auto const r = locate(name, to_string(name));
+    return {
+        const_iterator(this, r.first),
+        const_iterator(this, r.second)};
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+equal_range(string_view name) const ->
+    std::pair<const_iterator, const_iterator>
+{
+    auto const r = locate(string_to_field(name), name);
+    return {
+        const_iterator(this, r.first),
+        const_iterator(this, r.second)};
+}
+
+//------------------------------------------------------------------------------
+
+// Fields
+
+template<class Allocator>
+inline
+string_view
+basic_flat_fields<Allocator>::
+get_method_impl() const
+{
+    return {text(), method_};
+}
+
+template<class Allocator>
+inline
+string_view
+basic_flat_fields<Allocator>::
+get_target_impl() const
+{
+    if(target_or_reason_ == 0)
+        return {};
+    return {
+        text() + method_ + 1,
+        target_or_reason_ - 1};
+}
+
+template<class Allocator>
+inline
+string_view
+basic_flat_fields<Allocator>::
+get_reason_impl() const
+{
+    return {text() + method_, target_or_reason_};
+}
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+get_chunked_impl() const
+{
+    auto const te = token_list{
+        (*this)[field::transfer_encoding]};
+    for(auto it = te.begin(); it != te.end();)
+    {
+        auto const next = std::next(it);
+        if(next == te.end())
+            return beast::iequals(*it, "chunked");
+        it = next;
+    }
+    return false;
+}
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+get_keep_alive_impl(unsigned version) const
+{
+    auto const it = find(field::connection);
+    if(version < 11)
+    {
+        if(it == end())
+            return false;
+        return token_list{
+            it->value()}.exists("keep-alive");
+    }
+    if(it == end())
+        return true;
+    return ! token_list{
+        it->value()}.exists("close");
+}
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+has_content_length_impl() const
+{
+    return count(field::content_length) > 0;
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+set_method_impl(string_view s)
+{
+    set_start(0, method_, s, false);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+set_target_impl(string_view s)
+{
+    // The target is stored with an extra
+    // space at the beginning to help the
+    // writer class.
+    set_start(method_, target_or_reason_, s, true);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+set_reason_impl(string_view s)
+{
+    set_start(method_, target_or_reason_, s, false);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set_chunked_impl(bool value)
+{
+    beast::detail::temporary_buffer buf;
+    auto it = find(field::transfer_encoding);
+    if(value)
+    {
+        // append "chunked"
+        if(it == end())
+        {
+            set(field::transfer_encoding, "chunked");
+            return;
+        }
+        auto const te = token_list{it->value()};
+        for(auto itt = te.begin();;)
+        {
+            auto const next = std::next(itt);
+            if(next == te.end())
+            {
+                if(beast::iequals(*itt, "chunked"))
+                    return; // already set
+                break;
+            }
+            itt = next;
+        }
+
+        buf.append(it->value(), ", chunked");
+        set(field::transfer_encoding, buf.view());
+        return;
+    }
+    // filter "chunked"
+    if(it == end())
+        return;
+
+    detail::filter_token_list_last(buf, it->value(), {"chunked", {}});
+    if(! buf.empty())
+        set(field::transfer_encoding, buf.view());
+    else
+        erase(field::transfer_encoding);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set_content_length_impl(
+    boost::optional<std::uint64_t> const& value)
+{
+    if(! value)
+        erase(field::content_length);
+    else
+    {
+        auto s = to_static_string(*value);
+        set(field::content_length,
+            to_string_view(s));
+    }
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set_keep_alive_impl(
+    unsigned version, bool keep_alive)
+{
+    auto const value = (*this)[field::connection];
+    beast::detail::temporary_buffer buf;
+    detail::keep_alive_impl(buf, value, version, keep_alive);
+    if(buf.empty())
+        erase(field::connection);
+    else
+        set(field::connection, buf.view());
+}
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+key_less(
+    field f0, string_view s0,
+    field f1, string_view s1) noexcept
+{
+    // Known fields are ordered by their enum alone,
+    // unknown fields by name size then case-insensitive.
+    if(f0 != f1)
+        return f0 < f1;
+    if(f0 != field::unknown)
+        return false;
+    if(s0.size() != s1.size())
+        return s0.size() < s1.size();
+    return beast::iless{}(s0, s1);
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+element(std::size_t i) const noexcept ->
+    value_type
+{
+    BOOST_ASSERT(i < n_);
+    auto const& e = table()[i];
+    auto const p = text() + e.off;
+    return value_type(e.f,
+        string_view(p, e.nlen),
+        string_view(p + e.nlen + 2, e.vlen));
+}
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+aliases(string_view s) const noexcept
+{
+    auto const p = reinterpret_cast<char const*>(p_);
+    return ! s.empty() &&
+        std::less_equal<char const*>{}(p, s.data()) &&
+        std::less<char const*>{}(s.data(), p + units_ * sizeof(entry));
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+search(field name, string_view sname) const noexcept ->
+    std::pair<std::size_t, std::size_t>
+{
+    auto const t = table();
+    auto const s = text();
+    auto const ix = index();
+    auto const first = std::lower_bound(ix, ix + n_, name,
+        [&](pos_t i, field)
+        {
+            auto const& e = t[i];
+            return key_less(e.f,
+                string_view(s + e.off, e.nlen), name, sname);
+        });
+    auto const last = std::upper_bound(first, ix + n_, name,
+        [&](field, pos_t i)
+        {
+            auto const& e = t[i];
+            return key_less(name, sname,
+                e.f, string_view(s + e.off, e.nlen));
+        });
+    return {
+        static_cast<std::size_t>(first - ix),
+        static_cast<std::size_t>(last - ix)};
+}
+
+template<class Allocator>
+auto
+basic_flat_fields<Allocator>::
+locate(field name, string_view sname) const noexcept ->
+    std::pair<std::size_t, std::size_t>
+{
+    // Fields with the same name are adjacent in
+    // iteration order and indexed in that order.
+    auto const r = search(name, sname);
+    if(r.first == r.second)
+        return {n_, n_};
+    auto const ix = index();
+    return {ix[r.first], ix[r.second - 1] + std::size_t{1}};
+}
+
+template<class Allocator>
+bool
+basic_flat_fields<Allocator>::
+check_sizes(
+    string_view sname,
+    string_view value,
+    error_code& ec) const
+{
+    if(sname.size() > max_name_size)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::header_field_name_too_large);
+        return false;
+    }
+    if(value.size() > max_value_size)
+    {
+        BOOST_BEAST_ASSIGN_EC(ec, error::header_field_value_too_large);
+        return false;
+    }
+    return true;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+insert_element(
+    field name,
+    string_view sname,
+    string_view value)
+{
+    value = detail::trim(value);
+    if(aliases(sname) || aliases(value))
+    {
+        // the block may move or shift underneath
+        beast::detail::temporary_buffer buf;
+        buf.append(sname, value);
+        auto const s = buf.view();
+        return insert_element(name,
+            s.substr(0, sname.size()),
+            s.substr(sname.size()));
+    }
+    auto const r = search(name, sname);
+    if(r.first == r.second)
+        return insert_line(n_, r.second, name, sname, value);
+    // keep duplicate fields together
+    insert_line(index()[r.second - 1] + std::size_t{1},
+        r.second, name, sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set_element(
+    field name,
+    string_view sname,
+    string_view value)
+{
+    value = detail::trim(value);
+    if(aliases(sname) || aliases(value))
+    {
+        beast::detail::temporary_buffer buf;
+        buf.append(sname, value);
+        auto const s = buf.view();
+        return set_element(name,
+            s.substr(0, sname.size()),
+            s.substr(sname.size()));
+    }
+    auto const r = locate(name, sname);
+    erase_lines(r.first, r.second);
+    insert_line(n_, search(name, sname).first,
+        name, sname, value);
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+insert_line(
+    std::size_t i,
+    std::size_t j,
+    field name,
+    string_view sname,
+    string_view value)
+{
+    BOOST_ASSERT(i <= n_ && j <= n_);
+    auto const len = sname.size() + value.size() + 4;
+    reserve(n_ + 1, size_ + len);
+
+    // make room for the line
+    auto const t = table();
+    auto const off = i < n_ ? std::size_t{t[i].off} : size_;
+    auto p = text() + off;
+    std::memmove(p + len, p, size_ - off);
+    sname.copy(p, sname.size());
+    p += sname.size();
+    *p++ = ':';
+    *p++ = ' ';
+    value.copy(p, value.size());
+    p += value.size();
+    *p++ = '\r';
+    *p = '\n';
+    size_ += len;
+
+    // insert the entry, shifting the lines after it
+    std::memmove(t + i + 1, t + i, (n_ - i) * sizeof(entry));
+    for(auto k = i + 1; k <= n_; ++k)
+        t[k].off = static_cast<pos_t>(t[k].off + len);
+    t[i] = entry{
+        static_cast<pos_t>(off),
+        static_cast<std::uint16_t>(sname.size()),
+        static_cast<std::uint16_t>(value.size()),
+        name};
+
+    // renumber and insert into the index
+    auto const ix = index();
+    for(std::size_t k = 0; k < n_; ++k)
+        if(ix[k] >= i)
+            ++ix[k];
+    std::memmove(ix + j + 1, ix + j, (n_ - j) * sizeof(pos_t));
+    ix[j] = static_cast<pos_t>(i);
+    ++n_;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+erase_lines(std::size_t first, std::size_t last)
+{
+    BOOST_ASSERT(first <= last && last <= n_);
+    if(first == last)
+        return;
+    auto const t = table();
+    auto const s = text();
+    auto const off = std::size_t{t[first].off};
+    auto const end = last < n_ ? std::size_t{t[last].off} : size_;
+    auto const len = end - off;
+    auto const count = last - first;
+    std::memmove(s + off, s + end, size_ - end);
+    size_ -= len;
+
+    std::memmove(t + first, t + last, (n_ - last) * sizeof(entry));
+    for(auto k = first; k < n_ - count; ++k)
+        t[k].off = static_cast<pos_t>(t[k].off - len);
+
+    auto const ix = index();
+    std::size_t w = 0;
+    for(std::size_t k = 0; k < n_; ++k)
+    {
+        auto v = ix[k];
+        if(v >= first)
+        {
+            if(v < last)
+                continue;
+            v = static_cast<pos_t>(v - count);
+        }
+        ix[w++] = v;
+    }
+    n_ -= count;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+set_start(
+    std::size_t off,
+    std::size_t& size,
+    string_view s,
+    bool space)
+{
+    std::size_t const n = s.empty() ? 0 :
+        s.size() + (space ? 1 : 0);
+    if(n == 0 && size == 0)
+        return;
+    if(aliases(s))
+    {
+        beast::detail::temporary_buffer buf;
+        buf.append(s);
+        return set_start(off, size, buf.view(), space);
+    }
+    if(n > size)
+        reserve(n_, size_ + n - size);
+    auto const p = text() + off;
+    std::memmove(p + n, p + size, size_ - off - size);
+    if(n > 0)
+    {
+        if(space)
+            p[0] = ' ';
+        s.copy(p + (space ? 1 : 0), s.size());
+    }
+    // everything after the start line moved
+    auto const t = table();
+    for(std::size_t k = 0; k < n_; ++k)
+        t[k].off = static_cast<pos_t>(t[k].off + n - size);
+    size_ = size_ + n - size;
+    size = n;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+reserve(std::size_t slots, std::size_t text)
+{
+    auto const tc = text_capacity();
+    if(slots <= slots_ && text <= tc)
+        return;
+    if(text > (std::numeric_limits<pos_t>::max)())
+        BOOST_THROW_EXCEPTION(std::length_error{
+            "header too large"});
+    std::size_t ns = slots_;
+    if(slots > ns)
+        ns = (std::max)({slots, 2 * ns, std::size_t{16}});
+    std::size_t nt = tc;
+    if(text > nt)
+        nt = (std::max)({text, 2 * nt, std::size_t{512}});
+    auto const units =
+        (ns * (sizeof(entry) + sizeof(pos_t)) + nt +
+            sizeof(entry) - 1) / sizeof(entry);
+    rebind_type a(this->get());
+    auto const p = alloc_traits::allocate(a, units);
+    if(p_)
+    {
+        std::memcpy(p, p_, n_ * sizeof(entry));
+        std::memcpy(p + ns, index(), n_ * sizeof(pos_t));
+        std::memcpy(reinterpret_cast<char*>(p) +
+            ns * (sizeof(entry) + sizeof(pos_t)), this->text(), size_);
+        alloc_traits::deallocate(a, p_, units_);
+    }
+    p_ = p;
+    units_ = units;
+    slots_ = ns;
+}
+
+template<class Allocator>
+template<class OtherAlloc>
+void
+basic_flat_fields<Allocator>::
+copy_all(basic_flat_fields<OtherAlloc> const& other)
+{
+    // The layout does not depend on the allocator,
+    // so copying is one allocation and three copies.
+    clear_all();
+    if(other.size_ == 0)
+        return;
+    reserve(other.n_, other.size_);
+    std::memcpy(table(), other.table(), other.n_ * sizeof(entry));
+    std::memcpy(index(), other.index(), other.n_ * sizeof(pos_t));
+    std::memcpy(text(), other.text(), other.size_);
+    n_ = other.n_;
+    size_ = other.size_;
+    method_ = other.method_;
+    target_or_reason_ = other.target_or_reason_;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+clear_all() noexcept
+{
+    n_ = 0;
+    size_ = 0;
+    method_ = 0;
+    target_or_reason_ = 0;
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+release() noexcept
+{
+    if(p_)
+    {
+        rebind_type a(this->get());
+        alloc_traits::deallocate(a, p_, units_);
+    }
+    p_ = nullptr;
+    units_ = 0;
+    slots_ = 0;
+    clear_all();
+}
+
+template<class Allocator>
+void
+basic_flat_fields<Allocator>::
+steal(basic_flat_fields& other) noexcept
+{
+    p_ = boost::exchange(other.p_, nullptr);
+    units_ = boost::exchange(other.units_, 0);
+    slots_ = boost::exchange(other.slots_, 0);
+    n_ = boost::exchange(other.n_, 0);
+    size_ = boost::exchange(other.size_, 0);
+    method_ = boost::exchange(other.method_, 0);
+    target_or_reason_ = boost::exchange(other.target_or_reason_, 0);
+}
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+move_assign(basic_flat_fields& other, std::true_type)
+{
+    release();
+    this->get() = std::move(other.get());
+    steal(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+move_assign(basic_flat_fields& other, std::false_type)
+{
+    if(this->get() != other.get())
+    {
+        copy_all(other);
+    }
+    else
+    {
+        release();
+        steal(other);
+    }
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+copy_assign(basic_flat_fields const& other, std::true_type)
+{
+    if(this->get() != other.get())
+        release();
+    this->get() = other.get();
+    copy_all(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+copy_assign(basic_flat_fields const& other, std::false_type)
+{
+    copy_all(other);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+swap(basic_flat_fields& other, std::true_type)
+{
+    using std::swap;
+    swap(this->get(), other.get());
+    swap(p_, other.p_);
+    swap(units_, other.units_);
+    swap(slots_, other.slots_);
+    swap(n_, other.n_);
+    swap(size_, other.size_);
+    swap(method_, other.method_);
+    swap(target_or_reason_, other.target_or_reason_);
+}
+
+template<class Allocator>
+inline
+void
+basic_flat_fields<Allocator>::
+swap(basic_flat_fields& other, std::false_type)
+{
+    BOOST_ASSERT(this->get() == other.get());
+    using std::swap;
+    swap(p_, other.p_);
+    swap(units_, other.units_);
+    swap(slots_, other.slots_);
+    swap(n_, other.n_);
+    swap(size_, other.size_);
+    swap(method_, other.method_);
+    swap(target_or_reason_, other.target_or_reason_);
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
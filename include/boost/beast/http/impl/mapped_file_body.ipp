@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_MAPPED_FILE_BODY_IPP
+#define BOOST_BEAST_HTTP_IMPL_MAPPED_FILE_BODY_IPP
+
+#include <boost/beast/http/mapped_file_body.hpp>
+
+#if BOOST_BEAST_USE_POSIX_FILE
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace detail {
+
+file_mapping::
+~file_mapping()
+{
+    if(size_ > 0)
+        ::munmap(const_cast<void*>(data_), size_);
+}
+
+std::shared_ptr<file_mapping const>
+map_file(file_posix const& file, std::uint64_t size, error_code& ec)
+{
+    if(size > (std::numeric_limits<std::size_t>::max)())
+    {
+        ec = make_error_code(errc::file_too_large);
+        return nullptr;
+    }
+    // mmap rejects a length of zero
+    if(size == 0)
+    {
+        ec = {};
+        return std::make_shared<file_mapping>(nullptr, 0);
+    }
+    auto const p = ::mmap(nullptr, static_cast<std::size_t>(size),
+        PROT_READ, MAP_SHARED, file.native_handle(), 0);
+    if(p == MAP_FAILED)
+    {
+        ec.assign(errno, system_category());
+        return nullptr;
+    }
+    ec = {};
+    return std::make_shared<file_mapping>(
+        p, static_cast<std::size_t>(size));
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+std::size_t
+mapped_file_cache::
+size()
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return list_.size();
+}
+
+void
+mapped_file_cache::
+clear()
+{
+    std::list<entry> list;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        list.swap(list_);
+    }
+    // mappings are released outside the lock
+}
+
+std::shared_ptr<detail::file_mapping const>
+mapped_file_cache::
+get(char const* path, error_code& ec)
+{
+    file_posix f;
+    f.open(path, file_mode::read, ec);
+    if(ec)
+        return nullptr;
+    struct stat st;
+    if(::fstat(f.native_handle(), &st) != 0)
+    {
+        ec.assign(errno, system_category());
+        return nullptr;
+    }
+    entry e;
+    e.path = path;
+    e.dev = static_cast<std::uint64_t>(st.st_dev);
+    e.ino = static_cast<std::uint64_t>(st.st_ino);
+    e.size = static_cast<std::uint64_t>(st.st_size);
+    e.mtime_sec = static_cast<std::int64_t>(st.st_mtime);
+#if defined(__APPLE__)
+    e.mtime_nsec = static_cast<std::int64_t>(st.st_mtimespec.tv_nsec);
+#else
+    e.mtime_nsec = static_cast<std::int64_t>(st.st_mtim.tv_nsec);
+#endif
+
+    auto const same_file =
+        [&e](entry const& other)
+        {
+            return
+                other.dev == e.dev &&
+                other.ino == e.ino &&
+                other.size == e.size &&
+                other.mtime_sec == e.mtime_sec &&
+                other.mtime_nsec == e.mtime_nsec;
+        };
+
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        for(auto it = list_.begin(); it != list_.end(); ++it)
+        {
+            if(it->path != e.path)
+                continue;
+            if(same_file(*it))
+            {
+                list_.splice(list_.begin(), list_, it);
+                ec = {};
+                return it->map;
+            }
+            break;
+        }
+    }
+
+    // Map outside the lock, so a slow file
+    // does not hold up lookups of other files.
+    e.map = detail::map_file(f, e.size, ec);
+    if(ec)
+        return nullptr;
+    auto map = e.map;
+
+    std::list<entry> evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        for(auto it = list_.begin(); it != list_.end(); ++it)
+        {
+            if(it->path == e.path)
+            {
+                evicted.splice(evicted.end(), list_, it);
+                break;
+            }
+        }
+        if(capacity_ > 0)
+        {
+            list_.push_front(std::move(e));
+            while(list_.size() > capacity_)
+                evicted.splice(evicted.end(), list_,
+                    std::prev(list_.end()));
+        }
+    }
+    return map;
+}
+
+//------------------------------------------------------------------------------
+
+void
+mapped_file_body::
+value_type::
+open(char const* path, error_code& ec)
+{
+    file_posix f;
+    f.open(path, file_mode::read, ec);
+    if(ec)
+        return;
+    reset(f, ec);
+}
+
+void
+mapped_file_body::
+value_type::
+open(char const* path,
+    mapped_file_cache& cache, error_code& ec)
+{
+    auto map = cache.get(path, ec);
+    if(ec)
+        return;
+    map_ = std::move(map);
+    first_ = 0;
+    last_ = map_->size();
+}
+
+void
+mapped_file_body::
+value_type::
+reset(file_posix const& file, error_code& ec)
+{
+    auto const size = file.size(ec);
+    if(ec)
+        return;
+    auto const pos = file.pos(ec);
+    if(ec)
+        return;
+    auto map = detail::map_file(file, size, ec);
+    if(ec)
+        return;
+    map_ = std::move(map);
+    last_ = map_->size();
+    first_ = static_cast<std::size_t>(
+        (std::min<std::uint64_t>)(pos, last_));
+}
+
+void
+mapped_file_body::
+value_type::
+seek(std::uint64_t offset, error_code& ec)
+{
+    if(! map_)
+    {
+        ec = make_error_code(errc::bad_file_descriptor);
+        return;
+    }
+    if(offset > map_->size())
+    {
+        ec = make_error_code(errc::invalid_argument);
+        return;
+    }
+    first_ = static_cast<std::size_t>(offset);
+    ec = {};
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
+
+#endif
@@ -17,16 +17,16 @@ namespace boost {
 namespace beast {
 namespace http {
 
-template<bool isRequest, class Body, class Allocator>
-parser<isRequest, Body, Allocator>::
+template<bool isRequest, class Body, class Allocator, class Fields>
+parser<isRequest, Body, Allocator, Fields>::
 parser()
     : rd_(m_.base(), m_.body())
 {
 }
 
-template<bool isRequest, class Body, class Allocator>
+template<bool isRequest, class Body, class Allocator, class Fields>
 template<class Arg1, class... ArgN, class>
-parser<isRequest, Body, Allocator>::
+parser<isRequest, Body, Allocator, Fields>::
 parser(Arg1&& arg1, ArgN&&... argn)
     : m_(
         std::forward<Arg1>(arg1),
@@ -36,11 +36,11 @@ parser(Arg1&& arg1, ArgN&&... argn)
     m_.clear();
 }
 
-template<bool isRequest, class Body, class Allocator>
+template<bool isRequest, class Body, class Allocator, class Fields>
 template<class OtherBody, class... Args, class>
-parser<isRequest, Body, Allocator>::
+parser<isRequest, Body, Allocator, Fields>::
 parser(
-    parser<isRequest, OtherBody, Allocator>&& other,
+    parser<isRequest, OtherBody, Allocator, Fields>&& other,
     Args&&... args)
     : basic_parser<isRequest>(std::move(other))
     , m_(other.release(), std::forward<Args>(args)...)
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_HPP
+#define BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_HPP
+
+#include <boost/beast/core/buffer_traits.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+template<class Fields>
+prepared_header::
+prepared_header(header<false, Fields> const& h)
+{
+    header<false, Fields> copy(h);
+    copy.erase(field::date);
+    copy.erase(field::content_length);
+    copy.erase(field::transfer_encoding);
+
+    typename Fields::writer wr(
+        copy, copy.version(), copy.result_int());
+    auto const buffers = wr.get();
+    auto const n = buffer_bytes(buffers);
+
+    // Date is always 29 chars, Content-Length
+    // is at most 20 digits followed by "\r\n\r\n"
+    s_.reserve(n - 2 + 6 + 29 + 2 + 16 + 20 + 4);
+    s_.resize(n);
+    net::buffer_copy(
+        net::mutable_buffer(&s_[0], n), buffers);
+    s_.resize(n - 2);
+    s_.append("Date: ");
+    date_ = s_.size();
+    s_.append(29, ' ');
+    s_.append("\r\n");
+    auto const status = copy.result_int();
+    has_length_ = ! (
+        (status >= 100 && status < 200) ||
+        status == 204 || status == 304);
+    if(has_length_)
+        s_.append("Content-Length: ");
+    length_ = s_.size();
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_IPP
+#define BOOST_BEAST_HTTP_IMPL_PREPARED_HEADER_IPP
+
+#include <boost/beast/http/prepared_header.hpp>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// Writes the IMF-fixdate for `t` seconds since the
+// epoch, e.g. "Sun, 06 Nov 1994 08:49:37 GMT" (29 chars)
+inline
+void
+format_date(char* dest, std::int64_t t)
+{
+    static char const days[] =
+        "SunMonTueWedThuFriSat";
+    static char const months[] =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    auto secs = t % 86400;
+    auto z = t / 86400;
+    if(secs < 0)
+    {
+        secs += 86400;
+        --z;
+    }
+    // 1970-01-01 was a Thursday
+    auto const wday = ((z % 7) + 11) % 7;
+
+    // civil from days, after Howard Hinnant
+    z += 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = z - era * 146097;
+    auto const yoe = (doe - doe / 1460 +
+        doe / 36524 - doe / 146096) / 365;
+    auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const mday = doy - (153 * mp + 2) / 5 + 1;
+    auto const mon = mp < 10 ? mp + 2 : mp - 10;
+    auto const year = yoe + era * 400 + (mon < 2 ? 1 : 0);
+
+    auto const put2 =
+        [](char* p, std::int64_t v)
+        {
+            p[0] = static_cast<char>('0' + v / 10);
+            p[1] = static_cast<char>('0' + v % 10);
+        };
+    dest[0] = days[wday * 3];
+    dest[1] = days[wday * 3 + 1];
+    dest[2] = days[wday * 3 + 2];
+    dest[3] = ',';
+    dest[4] = ' ';
+    put2(dest + 5, mday);
+    dest[7] = ' ';
+    dest[8] = months[mon * 3];
+    dest[9] = months[mon * 3 + 1];
+    dest[10] = months[mon * 3 + 2];
+    dest[11] = ' ';
+    put2(dest + 12, (year / 100) % 100);
+    put2(dest + 14, year % 100);
+    dest[16] = ' ';
+    put2(dest + 17, secs / 3600);
+    dest[19] = ':';
+    put2(dest + 20, (secs / 60) % 60);
+    dest[22] = ':';
+    put2(dest + 23, secs % 60);
+    dest[25] = ' ';
+    dest[26] = 'G';
+    dest[27] = 'M';
+    dest[28] = 'T';
+}
+
+} // detail
+
+prepared_header::
+prepared_header(prepared_header const& other)
+    : date_(other.date_)
+    , length_(other.length_)
+    , time_(other.time_)
+    , has_length_(other.has_length_)
+{
+    s_.reserve(other.s_.capacity());
+    s_ = other.s_;
+}
+
+prepared_header&
+prepared_header::
+operator=(prepared_header const& other)
+{
+    if(this == &other)
+        return *this;
+    s_.reserve(other.s_.capacity());
+    s_ = other.s_;
+    date_ = other.date_;
+    length_ = other.length_;
+    time_ = other.time_;
+    has_length_ = other.has_length_;
+    return *this;
+}
+
+net::const_buffer
+prepared_header::
+get(std::uint64_t content_length,
+    std::chrono::system_clock::time_point now)
+{
+    auto const d = now.time_since_epoch();
+    auto t = std::chrono::duration_cast<
+        std::chrono::seconds>(d).count();
+    if(std::chrono::seconds(t) > d)
+        --t;
+    if(t != time_)
+    {
+        detail::format_date(&s_[date_], t);
+        time_ = t;
+    }
+
+    s_.resize(length_);
+    if(! has_length_)
+    {
+        s_.append("\r\n");
+        return {s_.data(), s_.size()};
+    }
+
+    char buf[20];
+    auto p = buf + sizeof(buf);
+    do
+    {
+        *--p = static_cast<char>('0' + content_length % 10);
+        content_length /= 10;
+    }
+    while(content_length > 0);
+    s_.append(p, buf + sizeof(buf));
+    s_.append("\r\n\r\n");
+    return {s_.data(), s_.size()};
+}
+
+} // http
+} // beast
+} // boost
+
+#endif
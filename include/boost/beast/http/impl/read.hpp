@@ -54,15 +54,16 @@ struct parser_is_header_done
 
 template<
     class Stream, class DynamicBuffer,
-    bool isRequest, class Body, class Allocator,
+    bool isRequest, class Body, class Fields,
     class Handler>
 class read_msg_op
     : public beast::stable_async_base<
         Handler, beast::executor_type<Stream>>
     , public asio::coroutine
 {
+    // The allocator is only used by the default Fields
     using parser_type =
-        parser<isRequest, Body, Allocator>;
+        parser<isRequest, Body, std::allocator<char>, Fields>;
 
     using message_type =
         typename parser_type::value_type;
@@ -132,13 +133,12 @@ struct run_read_msg_op
     template<
         class ReadHandler,
         class DynamicBuffer,
-        bool isRequest, class Body, class Allocator>
+        bool isRequest, class Body, class Fields>
     void
     operator()(
         ReadHandler&& h,
         DynamicBuffer* b,
-        message<isRequest, Body,
-            basic_fields<Allocator>>* m)
+        message<isRequest, Body, Fields>* m)
     {
         // If you get an error on the following line it means
         // that your handler does not meet the documented type
@@ -152,7 +152,7 @@ struct run_read_msg_op
         read_msg_op<
             AsyncReadStream,
             DynamicBuffer,
-            isRequest, Body, Allocator,
+            isRequest, Body, Fields,
             typename std::decay<ReadHandler>::type>(
                 std::forward<ReadHandler>(h), *stream, *b, *m);
     }
@@ -638,12 +638,12 @@ async_read(
 template<
     class SyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator>
+    bool isRequest, class Body, class Fields>
 std::size_t
 read(
     SyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg)
+    message<isRequest, Body, Fields>& msg)
 {
     static_assert(
         is_sync_read_stream<SyncReadStream>::value,
@@ -666,12 +666,12 @@ read(
 template<
     class SyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator>
+    bool isRequest, class Body, class Fields>
 std::size_t
 read(
     SyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg,
+    message<isRequest, Body, Fields>& msg,
     error_code& ec)
 {
     static_assert(
@@ -684,7 +684,8 @@ read(
         "Body type requirements not met");
     static_assert(is_body_reader<Body>::value,
         "BodyReader type requirements not met");
-    parser<isRequest, Body, Allocator> p(std::move(msg));
+    parser<isRequest, Body, std::allocator<char>, Fields> p(
+        std::move(msg));
     p.eager(true);
     auto const bytes_transferred =
         http::read(stream, buffer, p, ec);
@@ -697,13 +698,13 @@ read(
 template<
     class AsyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator,
+    bool isRequest, class Body, class Fields,
     BOOST_BEAST_ASYNC_TPARAM2 ReadHandler>
 BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
 async_read(
     AsyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg,
+    message<isRequest, Body, Fields>& msg,
     ReadHandler&& handler)
 {
     static_assert(
@@ -40,6 +40,23 @@ fwrinit(std::false_type)
     fwr_.emplace(m_, m_.version(), m_.result_int());
 }
 
+template<
+    bool isRequest, class Body, class Fields>
+void
+serializer<isRequest, Body, Fields>::
+fwrflatten(std::true_type)
+{
+    fwr_->flatten(flat_storage_);
+}
+
+template<
+    bool isRequest, class Body, class Fields>
+void
+serializer<isRequest, Body, Fields>::
+fwrflatten(std::false_type)
+{
+}
+
 template<
     bool isRequest, class Body, class Fields>
 template<std::size_t I, class Visit>
@@ -77,6 +94,9 @@ next(error_code& ec, Visit&& visit)
     {
         fwrinit(std::integral_constant<bool,
             isRequest>{});
+        if(flat_)
+            fwrflatten(detail::has_flatten<
+                typename Fields::writer>{});
         if(m_.chunked())
             goto go_init_c;
         s_ = do_init;
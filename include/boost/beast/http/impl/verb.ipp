@@ -11,7 +11,11 @@
 #define BOOST_BEAST_HTTP_IMPL_VERB_IPP
 
 #include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/detail/perfect_hash.hpp>
+#include <boost/assert.hpp>
 #include <boost/throw_exception.hpp>
+#include <array>
+#include <cstdint>
 #include <stdexcept>
 
 namespace boost {
@@ -71,229 +75,94 @@ to_string(verb v)
     BOOST_THROW_EXCEPTION(std::invalid_argument{"unknown verb"});
 }
 
-verb
-string_to_verb(string_view v)
-{
-/*
-    ACL
-    BIND
-    CHECKOUT
-    CONNECT
-    COPY
-    DELETE
-    GET
-    HEAD
-    LINK
-    LOCK
-    M-SEARCH
-    MERGE
-    MKACTIVITY
-    MKCALENDAR
-    MKCOL
-    MOVE
-    NOTIFY
-    OPTIONS
-    PATCH
-    POST
-    PROPFIND
-    PROPPATCH
-    PURGE
-    PUT
-    REBIND
-    REPORT
-    SEARCH
-    SUBSCRIBE
-    TRACE
-    UNBIND
-    UNLINK
-    UNLOCK
-    UNSUBSCRIBE
-*/
-    using namespace beast::detail::string_literals;
-    if(v.size() < 3)
-        return verb::unknown;
-    auto c = v[0];
-    v.remove_prefix(1);
-    switch(c)
-    {
-    case 'A':
-        if(v == "CL"_sv)
-            return verb::acl;
-        break;
-
-    case 'B':
-        if(v == "IND"_sv)
-            return verb::bind;
-        break;
-
-    case 'C':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case 'H':
-            if(v == "ECKOUT"_sv)
-                return verb::checkout;
-            break;
-
-        case 'O':
-            if(v == "NNECT"_sv)
-                return verb::connect;
-            if(v == "PY"_sv)
-                return verb::copy;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'D':
-        if(v == "ELETE"_sv)
-            return verb::delete_;
-        break;
-
-    case 'G':
-        if(v == "ET"_sv)
-            return verb::get;
-        break;
-
-    case 'H':
-        if(v == "EAD"_sv)
-            return verb::head;
-        break;
-
-    case 'L':
-        if(v == "INK"_sv)
-            return verb::link;
-        if(v == "OCK"_sv)
-            return verb::lock;
-        break;
-
-    case 'M':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case '-':
-            if(v == "SEARCH"_sv)
-                return verb::msearch;
-            break;
-
-        case 'E':
-            if(v == "RGE"_sv)
-                return verb::merge;
-            break;
-
-        case 'K':
-            if(v == "ACTIVITY"_sv)
-                return verb::mkactivity;
-            if(v[0] == 'C')
-            {
-                v.remove_prefix(1);
-                if(v == "ALENDAR"_sv)
-                    return verb::mkcalendar;
-                if(v == "OL"_sv)
-                    return verb::mkcol;
-                break;
-            }
-            break;
-
-        case 'O':
-            if(v == "VE"_sv)
-                return verb::move;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'N':
-        if(v == "OTIFY"_sv)
-            return verb::notify;
-        break;
-
-    case 'O':
-        if(v == "PTIONS"_sv)
-            return verb::options;
-        break;
+namespace detail {
 
-    case 'P':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case 'A':
-            if(v == "TCH"_sv)
-                return verb::patch;
-            break;
-
-        case 'O':
-            if(v == "ST"_sv)
-                return verb::post;
-            break;
+class verb_table
+{
+    // The number of known verbs
+    enum { N = static_cast<int>(verb::unlink) };
 
-        case 'R':
-            if(v == "OPFIND"_sv)
-                return verb::propfind;
-            if(v == "OPPATCH"_sv)
-                return verb::proppatch;
-            break;
+    // Method strings are case-sensitive and short
+    // enough to compare as two words and a size.
+    struct key
+    {
+        std::uint64_t w0;
+        std::uint64_t w1;
+        std::size_t n;
+    };
+
+    static
+    key
+    make_key(string_view s) noexcept
+    {
+        BOOST_ASSERT(s.size() <= 16);
+        return {
+            load_word(s.data(), s.size()),
+            s.size() > 8 ? load_word(
+                s.data() + 8, s.size() - 8) : 0,
+            s.size()};
+    }
 
-        case 'U':
-            if(v == "RGE"_sv)
-                return verb::purge;
-            if(v == "T"_sv)
-                return verb::put;
-            BOOST_FALLTHROUGH;
+    static
+    std::uint64_t
+    digest(key const& k) noexcept
+    {
+        return hash_mix(
+            hash_mix(k.n, k.w0), k.w1);
+    }
 
-        default:
-            break;
-        }
-        break;
+    static
+    std::array<std::uint64_t, N>
+    digests() noexcept
+    {
+        std::array<std::uint64_t, N> v;
+        for(std::size_t i = 0; i < N; ++i)
+            v[i] = digest(make_key(
+                to_string(static_cast<verb>(i + 1))));
+        return v;
+    }
 
-    case 'R':
-        if(v[0] != 'E')
-            break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
-            return verb::rebind;
-        if(v == "PORT"_sv)
-            return verb::report;
-        break;
+    key keys_[N];
+    perfect_hash<N, 8> hash_;
 
-    case 'S':
-        if(v == "EARCH"_sv)
-            return verb::search;
-        if(v == "UBSCRIBE"_sv)
-            return verb::subscribe;
-        break;
+public:
+    verb_table()
+        : hash_(digests().data())
+    {
+        for(std::size_t i = 0; i < N; ++i)
+            keys_[i] = make_key(
+                to_string(static_cast<verb>(i + 1)));
+    }
 
-    case 'T':
-        if(v == "RACE"_sv)
-            return verb::trace;
-        break;
+    verb
+    operator()(string_view s) const noexcept
+    {
+        if(s.size() < 3 || s.size() > 16)
+            return verb::unknown;
+        auto const k = make_key(s);
+        // the hash yields the only candidate
+        auto const i = hash_(digest(k));
+        auto const& k2 = keys_[i];
+        if(k.w0 == k2.w0 && k.w1 == k2.w1 && k.n == k2.n)
+            return static_cast<verb>(i + 1);
+        return verb::unknown;
+    }
+};
 
-    case 'U':
-        if(v[0] != 'N')
-            break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
-            return verb::unbind;
-        if(v == "LINK"_sv)
-            return verb::unlink;
-        if(v == "LOCK"_sv)
-            return verb::unlock;
-        if(v == "SUBSCRIBE"_sv)
-            return verb::unsubscribe;
-        break;
+inline
+verb_table const&
+get_verb_table()
+{
+    static verb_table const tab;
+    return tab;
+}
 
-    default:
-        break;
-    }
+} // detail
 
-    return verb::unknown;
+verb
+string_to_verb(string_view v)
+{
+    return detail::get_verb_table()(v);
 }
 
 } // http
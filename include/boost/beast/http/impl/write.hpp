@@ -12,6 +12,7 @@
 
 #include <boost/beast/http/type_traits.hpp>
 #include <boost/beast/core/async_base.hpp>
+#include <boost/beast/core/buffers_cat.hpp>
 #include <boost/beast/core/buffers_range.hpp>
 #include <boost/beast/core/make_printable.hpp>
 #include <boost/beast/core/stream_traits.hpp>
@@ -232,7 +233,7 @@ public:
                         __FILE__, __LINE__,
                         "http::async_write"));
 
-                    beast::http::async_write_some(
+                    async_write_some(
                         s_, sr_, std::move(*this));
                 }
                 bytes_transferred_ += bytes_transferred;
@@ -921,6 +922,66 @@ async_write(
 
 //------------------------------------------------------------------------------
 
+template<
+    class SyncWriteStream,
+    class ConstBufferSequence>
+std::size_t
+write(
+    SyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body)
+{
+    error_code ec;
+    auto const bytes_transferred =
+        write(stream, header, body, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return bytes_transferred;
+}
+
+template<
+    class SyncWriteStream,
+    class ConstBufferSequence>
+std::size_t
+write(
+    SyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body,
+    error_code& ec)
+{
+    static_assert(is_sync_write_stream<SyncWriteStream>::value,
+        "SyncWriteStream type requirements not met");
+    static_assert(net::is_const_buffer_sequence<
+        ConstBufferSequence>::value,
+        "ConstBufferSequence type requirements not met");
+    return net::write(stream, buffers_cat(
+        header.get(buffer_bytes(body)), body), ec);
+}
+
+template<
+    class AsyncWriteStream,
+    class ConstBufferSequence,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write(
+    AsyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body,
+    WriteHandler&& handler)
+{
+    static_assert(
+        is_async_write_stream<AsyncWriteStream>::value,
+        "AsyncWriteStream type requirements not met");
+    static_assert(net::is_const_buffer_sequence<
+        ConstBufferSequence>::value,
+        "ConstBufferSequence type requirements not met");
+    return net::async_write(stream, buffers_cat(
+        header.get(buffer_bytes(body)), body),
+        std::forward<WriteHandler>(handler));
+}
+
+//------------------------------------------------------------------------------
+
 namespace detail {
 
 template<class Serializer>
@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_MAPPED_FILE_BODY_HPP
+#define BOOST_BEAST_HTTP_MAPPED_FILE_BODY_HPP
+
+#include <boost/beast/http/mapped_file_body_fwd.hpp>
+
+#if BOOST_BEAST_USE_POSIX_FILE
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/file_posix.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// A read-only mapping of a whole file
+class file_mapping
+{
+    void const* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    file_mapping(void const* data, std::size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    file_mapping(file_mapping const&) = delete;
+    file_mapping& operator=(file_mapping const&) = delete;
+
+    BOOST_BEAST_DECL
+    ~file_mapping();
+
+    char const*
+    data() const noexcept
+    {
+        return static_cast<char const*>(data_);
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+};
+
+BOOST_BEAST_DECL
+std::shared_ptr<file_mapping const>
+map_file(file_posix const& file, std::uint64_t size, error_code& ec);
+
+} // detail
+
+/** A cache of read-only file mappings
+
+    Bodies of type @ref mapped_file_body opened through the
+    cache share one mapping per file, so concurrent responses
+    for the same file do not each map it. Entries are keyed
+    by path and validated against the device, inode, size and
+    modification time of the file, so a replaced or modified
+    file is mapped again. When the cache is full the least
+    recently used entry is dropped; responses still holding
+    its mapping keep it alive.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe.
+*/
+class mapped_file_cache
+{
+    struct entry
+    {
+        std::string path;
+        std::uint64_t dev;
+        std::uint64_t ino;
+        std::uint64_t size;
+        std::int64_t mtime_sec;
+        std::int64_t mtime_nsec;
+        std::shared_ptr<detail::file_mapping const> map;
+    };
+
+    std::mutex m_;
+    std::list<entry> list_;     // most recently used first
+    std::size_t capacity_;
+
+public:
+    /** Constructor
+
+        @param capacity The largest number of files
+        kept mapped by the cache.
+    */
+    explicit
+    mapped_file_cache(std::size_t capacity = 64)
+        : capacity_(capacity)
+    {
+    }
+
+    mapped_file_cache(mapped_file_cache const&) = delete;
+    mapped_file_cache& operator=(mapped_file_cache const&) = delete;
+
+    /// Returns the largest number of files kept mapped by the cache
+    std::size_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /// Returns the number of files currently in the cache
+    BOOST_BEAST_DECL
+    std::size_t
+    size();
+
+    /// Remove all entries from the cache
+    BOOST_BEAST_DECL
+    void
+    clear();
+
+    /** Return the mapping of a file
+
+        If the cache holds a mapping of the file at `path`
+        which is still current, it is returned. Otherwise
+        the file is mapped and the mapping is added to the
+        cache.
+
+        @param path The utf-8 encoded path to the file
+
+        @param ec Set to the error, if any occurred
+    */
+    BOOST_BEAST_DECL
+    std::shared_ptr<detail::file_mapping const>
+    get(char const* path, error_code& ec);
+};
+
+/** A message body represented by a memory-mapped file.
+
+    The file is mapped read-only, and the serializer is
+    given buffers which point straight into the mapping.
+    No part of the file is copied into user space by the
+    body, which makes it a good fit for streams that cannot
+    use `sendfile`, such as TLS streams.
+
+    Mappings are reference counted, so several messages may
+    share one mapping. A @ref mapped_file_cache lets
+    responses for the same file share the mapping it holds.
+
+    Messages using this body type may be serialized but not
+    parsed. Since the writer does not modify the body, one
+    message may be serialized by several threads at once.
+
+    @note If the file is truncated while it is mapped, reading
+    the missing pages raises `SIGBUS`. Files served this way
+    should be replaced rather than modified in place.
+*/
+struct mapped_file_body
+{
+    /** The type of the @ref message::body member.
+
+        This holds a shared reference to a mapping and the
+        range of the file which forms the payload.
+    */
+    class value_type
+    {
+        friend struct mapped_file_body;
+
+        std::shared_ptr<detail::file_mapping const> map_;
+        std::size_t first_ = 0;     // starting offset of the range
+        std::size_t last_ = 0;      // ending offset of the range
+
+    public:
+        /// Constructor
+        value_type() = default;
+
+        /// Returns `true` if a file is mapped
+        bool
+        is_open() const noexcept
+        {
+            return map_ != nullptr;
+        }
+
+        /// Returns the size of the range which forms the payload
+        std::uint64_t
+        size() const noexcept
+        {
+            return last_ - first_;
+        }
+
+        /// Returns a pointer to the start of the payload
+        char const*
+        data() const noexcept
+        {
+            return map_ ? map_->data() + first_ : nullptr;
+        }
+
+        /// Release the mapping
+        void
+        close() noexcept
+        {
+            map_.reset();
+            first_ = 0;
+            last_ = 0;
+        }
+
+        /** Map the file at the given path
+
+            @param path The utf-8 encoded path to the file
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        open(char const* path, error_code& ec);
+
+        /** Use the mapping of the file at the given path from a cache
+
+            @param path The utf-8 encoded path to the file
+
+            @param cache The cache to look in and add to
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        open(char const* path,
+            mapped_file_cache& cache, error_code& ec);
+
+        /** Map an open file
+
+            The payload starts at the current position of
+            the file. The file may be closed afterwards.
+
+            @param file The file to map, which must be open
+            for reading
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        reset(file_posix const& file, error_code& ec);
+
+        /** Set the offset at which the payload starts
+
+            @param offset The offset in bytes from the beginning
+            of the file
+
+            @param ec Set to the error, if any occurred
+        */
+        BOOST_BEAST_DECL
+        void
+        seek(std::uint64_t offset, error_code& ec);
+    };
+
+    /** Returns the size of the body
+
+        @param body The file body to use
+    */
+    static
+    std::uint64_t
+    size(value_type const& body) noexcept
+    {
+        return body.size();
+    }
+
+    /** The algorithm for serializing the body
+
+        Meets the requirements of <em>BodyWriter</em>.
+    */
+#if BOOST_BEAST_DOXYGEN
+    using writer = __implementation_defined__;
+#else
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        using const_buffers_type =
+            net::const_buffer;
+
+        template<bool isRequest, class Fields>
+        explicit
+        writer(header<isRequest, Fields> const&, value_type const& b)
+            : body_(b)
+        {
+        }
+
+        void
+        init(error_code& ec)
+        {
+            ec = {};
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(error_code& ec)
+        {
+            ec = {};
+            if(body_.size() == 0)
+                return boost::none;
+            return {{
+                { body_.data(),
+                  static_cast<std::size_t>(body_.size()) },
+                false}};
+        }
+    };
+#endif
+};
+
+} // http
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/impl/mapped_file_body.ipp>
+#endif
+
+#endif
+
+#endif
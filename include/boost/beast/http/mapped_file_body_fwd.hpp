@@ -0,0 +1,31 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_MAPPED_FILE_BODY_FWD_HPP
+#define BOOST_BEAST_HTTP_MAPPED_FILE_BODY_FWD_HPP
+
+#include <boost/beast/core/file_posix.hpp>
+
+#if BOOST_BEAST_USE_POSIX_FILE
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class mapped_file_cache;
+
+struct mapped_file_body;
+
+} // http
+} // beast
+} // boost
+
+#endif
+
+#endif
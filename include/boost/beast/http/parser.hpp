@@ -32,7 +32,8 @@ namespace http {
 
     This class uses the basic HTTP/1 wire format parser to convert
     a series of octets into a @ref message using the @ref basic_fields
-    container to represent the fields.
+    container, or another type meeting the requirements of
+    <em>Fields</em>, to represent the fields.
 
     @tparam isRequest Indicates whether a request or response
     will be parsed.
@@ -41,7 +42,15 @@ namespace http {
     meet the requirements of <em>Body</em>.
 
     @tparam Allocator The type of allocator used with the
-    @ref basic_fields container.
+    @ref basic_fields container. It is not used when another
+    Fields type is given.
+
+    @tparam Fields The type of container used to represent the
+    fields, such as @ref basic_flat_fields. It must provide an
+    `insert` overload accepting an `error_code`, like the one in
+    @ref basic_fields. The aliases @ref flat_request_parser and
+    @ref flat_response_parser select @ref basic_flat_fields with
+    the given allocator.
 
     @note A new instance of the parser is required for each message.
 */
@@ -49,12 +58,14 @@ namespace http {
 template<
     bool isRequest,
     class Body,
-    class Allocator = std::allocator<char>>
+    class Allocator = std::allocator<char>,
+    class Fields = basic_fields<Allocator>>
 #else
 template<
     bool isRequest,
     class Body,
-    class Allocator>
+    class Allocator,
+    class Fields>
 #endif
 class parser
     : public basic_parser<isRequest>
@@ -65,10 +76,10 @@ class parser
     static_assert(is_body_reader<Body>::value,
         "BodyReader type requirements not met");
 
-    template<bool, class, class>
+    template<bool, class, class, class>
     friend class parser;
 
-    message<isRequest, Body, basic_fields<Allocator>> m_;
+    message<isRequest, Body, Fields> m_;
     typename Body::reader rd_;
     bool rd_inited_ = false;
     bool used_ = false;
@@ -86,7 +97,7 @@ class parser
 public:
     /// The type of message returned by the parser
     using value_type =
-        message<isRequest, Body, basic_fields<Allocator>>;
+        message<isRequest, Body, Fields>;
 
     /// Destructor
     ~parser() = default;
@@ -165,7 +176,7 @@ public:
 #endif
     explicit
     parser(parser<isRequest, OtherBody,
-        Allocator>&& parser, Args&&... args);
+        Allocator, Fields>&& parser, Args&&... args);
 
     /** Returns the parsed message.
 
@@ -312,7 +323,7 @@ private:
             ! std::is_same<Body, OtherBody>::value>::type>
     parser(
         std::true_type,
-        parser<isRequest, OtherBody, Allocator>&& parser,
+        parser<isRequest, OtherBody, Allocator, Fields>&& parser,
         Args&&... args);
 
     template<class OtherBody, class... Args,
@@ -320,7 +331,7 @@ private:
             ! std::is_same<Body, OtherBody>::value>::type>
     parser(
         std::false_type,
-        parser<isRequest, OtherBody, Allocator>&& parser,
+        parser<isRequest, OtherBody, Allocator, Fields>&& parser,
         Args&&... args);
 
     template<class Arg1, class... ArgN,
@@ -506,6 +517,16 @@ using request_parser = parser<true, Body, Allocator>;
 /// An HTTP/1 parser for producing a response message.
 template<class Body, class Allocator = std::allocator<char>>
 using response_parser = parser<false, Body, Allocator>;
+
+/// An HTTP/1 parser for producing a request message using @ref basic_flat_fields.
+template<class Body, class Allocator = std::allocator<char>>
+using flat_request_parser = parser<true, Body, Allocator,
+    basic_flat_fields<Allocator>>;
+
+/// An HTTP/1 parser for producing a response message using @ref basic_flat_fields.
+template<class Body, class Allocator = std::allocator<char>>
+using flat_response_parser = parser<false, Body, Allocator,
+    basic_flat_fields<Allocator>>;
 #endif
 
 } // http
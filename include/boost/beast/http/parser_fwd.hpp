@@ -10,6 +10,9 @@
 #ifndef BOOST_BEAST_HTTP_PARSER_FWD_HPP
 #define BOOST_BEAST_HTTP_PARSER_FWD_HPP
 
+#include <boost/beast/http/fields_fwd.hpp>
+#include <boost/beast/http/flat_fields_fwd.hpp>
+
 #include <memory>
 
 namespace boost {
@@ -20,7 +23,8 @@ namespace http {
 template<
     bool isRequest,
     class Body,
-    class Allocator = std::allocator<char>>
+    class Allocator = std::allocator<char>,
+    class Fields = basic_fields<Allocator>>
 class parser;
 
 template<class Body, class Allocator = std::allocator<char>>
@@ -28,6 +32,14 @@ using request_parser = parser<true, Body, Allocator>;
 
 template<class Body, class Allocator = std::allocator<char>>
 using response_parser = parser<false, Body, Allocator>;
+
+template<class Body, class Allocator = std::allocator<char>>
+using flat_request_parser = parser<true, Body, Allocator,
+    basic_flat_fields<Allocator>>;
+
+template<class Body, class Allocator = std::allocator<char>>
+using flat_response_parser = parser<false, Body, Allocator,
+    basic_flat_fields<Allocator>>;
 #endif
 
 } // http
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_HTTP_PREPARED_HEADER_HPP
+#define BOOST_BEAST_HTTP_PREPARED_HEADER_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/asio/buffer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+/** A response header which is serialized once and sent many times.
+
+    Objects of this type hold the serialized representation of
+    a response header, for responses whose header is the same
+    every time except for the `Date` and `Content-Length` fields.
+    Those two fields are rendered at fixed locations at the end
+    of the header and patched in place before each use, so sending
+    the response costs neither a @ref basic_fields nor a
+    <em>FieldsWriter</em>.
+
+    The header is sent along with a body using the overloads of
+    @ref write and @ref async_write which accept a prepared header.
+
+    @par Example
+    @code
+    response<empty_body> res{status::ok, 11};
+    res.set(field::server, "Beast");
+    res.set(field::content_type, "text/plain");
+    prepared_header health{res.base()};
+    ...
+    http::write(sock, health, net::buffer("OK", 2));
+    @endcode
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Unsafe. Sending a response patches the
+    header, so an object may not be used by more than one write
+    operation at a time. A copy may be made for each connection.
+*/
+class prepared_header
+{
+    std::string s_;
+    std::size_t date_;          // offset of the Date value
+    std::size_t length_;        // offset of the Content-Length value
+    std::int64_t time_ =        // seconds in the rendered Date
+        (std::numeric_limits<std::int64_t>::min)();
+    bool has_length_;           // false for 1xx, 204 and 304
+
+public:
+    /** Constructor
+
+        The header is serialized. Any `Date`, `Content-Length`,
+        and `Transfer-Encoding` fields it contains are replaced
+        by the fields rendered when the header is used. No
+        `Content-Length` is rendered for a status of 1xx, 204,
+        or 304, since those responses have no body.
+
+        @param h The header to serialize.
+    */
+    template<class Fields>
+    explicit
+    prepared_header(header<false, Fields> const& h);
+
+    /// Move constructor
+    prepared_header(prepared_header&&) = default;
+
+    /// Move assignment
+    prepared_header& operator=(prepared_header&&) = default;
+
+    /** Copy constructor
+
+        The copy reserves the same capacity as the original,
+        so calling `get` on it does not allocate.
+    */
+    BOOST_BEAST_DECL
+    prepared_header(prepared_header const& other);
+
+    /// Copy assignment
+    BOOST_BEAST_DECL
+    prepared_header&
+    operator=(prepared_header const& other);
+
+    /** Return the serialized header.
+
+        The `Date` and `Content-Length` fields are updated
+        and the complete header is returned, including the
+        final carriage return linefeed sequence (`"\r\n"`).
+        The `Date` field is only rendered again when the
+        second it shows changes.
+
+        The returned buffer remains valid until the next call
+        to `get` or until the object is destroyed.
+
+        @param content_length The value of `Content-Length`.
+        This is ignored if the status does not allow a body.
+
+        @param now The time to use for the `Date` field.
+    */
+    BOOST_BEAST_DECL
+    net::const_buffer
+    get(std::uint64_t content_length,
+        std::chrono::system_clock::time_point now =
+            std::chrono::system_clock::now());
+};
+
+} // http
+} // beast
+} // boost
+
+#include <boost/beast/http/impl/prepared_header.hpp>
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/http/impl/prepared_header.ipp>
+#endif
+
+#endif
@@ -677,12 +677,12 @@ async_read(
 template<
     class SyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator>
+    bool isRequest, class Body, class Fields>
 std::size_t
 read(
     SyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg);
+    message<isRequest, Body, Fields>& msg);
 
 /** Read a complete message from a stream.
 
@@ -735,12 +735,12 @@ read(
 template<
     class SyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator>
+    bool isRequest, class Body, class Fields>
 std::size_t
 read(
     SyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg,
+    message<isRequest, Body, Fields>& msg,
     error_code& ec);
 
 /** Read a complete message asynchronously from a stream.
@@ -823,7 +823,7 @@ read(
 template<
     class AsyncReadStream,
     class DynamicBuffer,
-    bool isRequest, class Body, class Allocator,
+    bool isRequest, class Body, class Fields,
     BOOST_BEAST_ASYNC_TPARAM2 ReadHandler =
         net::default_completion_token_t<
             executor_type<AsyncReadStream>>>
@@ -831,7 +831,7 @@ BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
 async_read(
     AsyncReadStream& stream,
     DynamicBuffer& buffer,
-    message<isRequest, Body, basic_fields<Allocator>>& msg,
+    message<isRequest, Body, Fields>& msg,
     ReadHandler&& handler =
         net::default_completion_token_t<
             executor_type<AsyncReadStream>>{});
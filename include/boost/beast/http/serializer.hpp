@@ -20,6 +20,7 @@
 #include <boost/beast/core/string.hpp>
 #include <boost/beast/http/chunk_encode.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/optional.hpp>
 
@@ -117,6 +118,8 @@ private:
 
     void fwrinit(std::true_type);
     void fwrinit(std::false_type);
+    void fwrflatten(std::true_type);
+    void fwrflatten(std::false_type);
 
     template<std::size_t, class Visit>
     void
@@ -194,8 +197,10 @@ private:
         pcb5_t ,pcb6_t, pcb7_t, pcb8_t> pv_;
     std::size_t limit_ =
         (std::numeric_limits<std::size_t>::max)();
+    net::mutable_buffer flat_storage_;
     int s_ = do_construct;
     bool split_ = false;
+    bool flat_ = false;
     bool header_done_ = false;
     bool more_ = false;
 
@@ -295,6 +300,52 @@ public:
         split_ = v;
     }
 
+    /** Returns `true` if the header is written as one contiguous buffer.
+    */
+    bool
+    flatten()
+    {
+        return flat_;
+    }
+
+    /** Set whether the header is written as one contiguous buffer.
+
+        Normally the serialized header is presented as a sequence
+        of many small buffers, one for each field. When the flatten
+        feature is enabled, the implementation copies the complete
+        header into a single buffer allocated with the allocator
+        of the fields, so that it can be sent with fewer buffers.
+        The setting takes effect only if it is made before the first
+        call to @ref next, and only if the <em>FieldsWriter</em> of
+        the message supports it.
+
+        The default is to not flatten the header.
+    */
+    void
+    flatten(bool v)
+    {
+        flat_ = v;
+    }
+
+    /** Write the header as one contiguous buffer in the storage provided.
+
+        This enables the flatten feature, and copies the serialized
+        header into the caller-provided storage if it is large enough.
+        Otherwise, the allocator of the fields is used. The same storage
+        may be provided to the serializers of successive messages, to
+        avoid an allocation for each header.
+
+        @param storage The storage to use. Ownership is not transferred;
+        the caller is responsible for ensuring that the storage remains
+        valid until @ref is_header_done returns `true`.
+    */
+    void
+    flatten(net::mutable_buffer storage)
+    {
+        flat_ = true;
+        flat_storage_ = storage;
+    }
+
     /** Return `true` if serialization of the header is complete.
 
         This function indicates whether or not all buffers containing
@@ -12,6 +12,7 @@
 
 #include <boost/beast/core/detail/config.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/prepared_header.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/type_traits.hpp>
 #include <boost/beast/http/detail/chunk_encode.hpp>
@@ -780,6 +781,150 @@ async_write(
 #endif
     );
 
+//------------------------------------------------------------------------------
+
+/** Write a prepared header and a body to a stream.
+
+    This function is used to write a response to a stream using
+    HTTP/1, made of a @ref prepared_header and a body whose size
+    is known. The `Date` and `Content-Length` fields of the header
+    are updated, then the header and the body are sent together.
+    The call will block until one of the following conditions
+    is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to
+    the stream's `write_some` function.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the <em>SyncWriteStream</em> concept.
+
+    @param header The prepared header to write.
+
+    @param body The buffers holding the body.
+
+    @return The number of bytes written to the stream.
+
+    @throws system_error Thrown on failure.
+
+    @see prepared_header
+*/
+template<
+    class SyncWriteStream,
+    class ConstBufferSequence>
+std::size_t
+write(
+    SyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body);
+
+/** Write a prepared header and a body to a stream.
+
+    This function is used to write a response to a stream using
+    HTTP/1, made of a @ref prepared_header and a body whose size
+    is known. The `Date` and `Content-Length` fields of the header
+    are updated, then the header and the body are sent together.
+    The call will block until one of the following conditions
+    is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to
+    the stream's `write_some` function.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the <em>SyncWriteStream</em> concept.
+
+    @param header The prepared header to write.
+
+    @param body The buffers holding the body.
+
+    @param ec Set to the error, if any occurred.
+
+    @return The number of bytes written to the stream.
+
+    @see prepared_header
+*/
+template<
+    class SyncWriteStream,
+    class ConstBufferSequence>
+std::size_t
+write(
+    SyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body,
+    error_code& ec);
+
+/** Write a prepared header and a body to a stream asynchronously.
+
+    This function is used to write a response to a stream
+    asynchronously using HTTP/1, made of a @ref prepared_header
+    and a body whose size is known. The `Date` and `Content-Length`
+    fields of the header are updated, then the header and the body
+    are sent together. The function call always returns immediately.
+    The asynchronous operation will continue until one of the
+    following conditions is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of zero or more calls to the stream's
+    `async_write_some` function, and is known as a <em>composed operation</em>.
+    The program must ensure that the stream performs no other writes
+    until this operation completes.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the <em>AsyncWriteStream</em> concept.
+
+    @param header The prepared header to write.
+    The object must remain valid and must not be used by
+    another write at least until the handler is called;
+    ownership is not transferred.
+
+    @param body The buffers holding the body. Although the buffers
+    object may be copied as necessary, ownership of the underlying
+    memory blocks is retained by the caller, which must guarantee
+    that they remain valid until the handler is called.
+
+    @param handler The completion handler to invoke when the operation
+    completes. The implementation takes ownership of the handler by
+    performing a decay-copy. The equivalent function signature of
+    the handler must be:
+    @code
+    void handler(
+        error_code const& error,        // result of operation
+        std::size_t bytes_transferred   // the number of bytes written to the stream
+    );
+    @endcode
+    If the handler has an associated immediate executor,
+    an immediate completion will be dispatched to it.
+    Otherwise, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `net::post`.
+
+    @see prepared_header
+*/
+template<
+    class AsyncWriteStream,
+    class ConstBufferSequence,
+    BOOST_BEAST_ASYNC_TPARAM2 WriteHandler =
+        net::default_completion_token_t<
+            executor_type<AsyncWriteStream>>>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+async_write(
+    AsyncWriteStream& stream,
+    prepared_header& header,
+    ConstBufferSequence const& body,
+    WriteHandler&& handler =
+        net::default_completion_token_t<
+            executor_type<AsyncWriteStream>>{});
+
 
 //------------------------------------------------------------------------------
 
@@ -32,7 +32,9 @@ the program, with the macro BOOST_BEAST_SEPARATE_COMPILATION defined.
 
 #include <boost/beast/core/detail/base64.ipp>
 #include <boost/beast/core/detail/sha1.ipp>
+#include <boost/beast/core/detail/impl/rate_limiter.ipp>
 #include <boost/beast/core/detail/impl/temporary_buffer.ipp>
+#include <boost/beast/core/detail/impl/timer_wheel.ipp>
 #include <boost/beast/core/impl/error.ipp>
 #include <boost/beast/core/impl/file_posix.ipp>
 #include <boost/beast/core/impl/file_stdio.ipp>
@@ -48,18 +50,24 @@ the program, with the macro BOOST_BEAST_SEPARATE_COMPILATION defined.
 #include <boost/beast/http/impl/error.ipp>
 #include <boost/beast/http/impl/field.ipp>
 #include <boost/beast/http/impl/fields.ipp>
+#include <boost/beast/http/impl/mapped_file_body.ipp>
+#include <boost/beast/http/impl/prepared_header.ipp>
 #include <boost/beast/http/impl/rfc7230.ipp>
 #include <boost/beast/http/impl/status.ipp>
 #include <boost/beast/http/impl/verb.ipp>
 
+#include <boost/beast/websocket/detail/deflate_pool.ipp>
 #include <boost/beast/websocket/detail/hybi13.ipp>
 #include <boost/beast/websocket/detail/mask.ipp>
 #include <boost/beast/websocket/detail/pmd_extension.ipp>
 #include <boost/beast/websocket/detail/prng.ipp>
 #include <boost/beast/websocket/detail/service.ipp>
 #include <boost/beast/websocket/detail/utf8_checker.ipp>
+#include <boost/beast/websocket/impl/deflate_pool.ipp>
 #include <boost/beast/websocket/impl/error.ipp>
 
+#include <boost/beast/zlib/detail/adler32.ipp>
+#include <boost/beast/zlib/detail/crc32.ipp>
 #include <boost/beast/zlib/detail/deflate_stream.ipp>
 #include <boost/beast/zlib/detail/inflate_stream.ipp>
 #include <boost/beast/zlib/impl/error.ipp>
@@ -12,8 +12,10 @@
 
 #include <boost/beast/core/detail/config.hpp>
 
+#include <boost/beast/websocket/deflate_pool.hpp>
 #include <boost/beast/websocket/error.hpp>
 #include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/prepared_message.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DEFLATE_POOL_HPP
+#define BOOST_BEAST_WEBSOCKET_DEFLATE_POOL_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+/** Statistics of the permessage-deflate state pool.
+
+    Streams which negotiate the permessage-deflate extension
+    take a compressor and a decompressor from a process-wide
+    pool when the first compressed message is written or read,
+    instead of when the connection opens. They give them back
+    when the negotiated parameters say that the context is not
+    kept between messages, and when the stream closes.
+
+    The compressor is also given back once no message has been
+    written for @ref permessage_deflate::idle_release. The
+    decompressor is not: while the peer takes over context its
+    next message may refer to the previous ones, so an idle
+    connection whose peer keeps its context still holds the
+    decompressor and its window.
+
+    @see get_deflate_pool_stats, set_deflate_pool_limit
+*/
+struct deflate_pool_stats
+{
+    /// The number of compressors held by streams
+    std::size_t deflate_in_use = 0;
+
+    /// The number of compressors kept in the pool for reuse
+    std::size_t deflate_pooled = 0;
+
+    /// The number of decompressors held by streams
+    std::size_t inflate_in_use = 0;
+
+    /// The number of decompressors kept in the pool for reuse
+    std::size_t inflate_pooled = 0;
+
+    /// The number of compressors and decompressors created
+    std::uint64_t created = 0;
+
+    /// The number of requests which were served from the pool
+    std::uint64_t reused = 0;
+};
+
+/// Returns the current statistics of the permessage-deflate state pool
+BOOST_BEAST_DECL
+deflate_pool_stats
+get_deflate_pool_stats();
+
+/** Set the number of objects of each kind kept in the pool.
+
+    Compressors and decompressors given back while the pool
+    already holds this many of their kind are destroyed. The
+    pool is trimmed to the new limit. The default is 64.
+
+    @param n The largest number of compressors, and separately
+    of decompressors, to keep for reuse.
+*/
+BOOST_BEAST_DECL
+void
+set_deflate_pool_limit(std::size_t n);
+
+/// Destroy all compressors and decompressors kept in the pool
+BOOST_BEAST_DECL
+void
+shrink_deflate_pool();
+
+} // websocket
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/detail/deflate_pool.hpp>
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_POOL_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_POOL_HPP
+
+#include <boost/beast/websocket/deflate_pool.hpp>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// Gives a compressor or decompressor back to the pool
+struct deflate_pool_deleter
+{
+    BOOST_BEAST_DECL
+    void
+    operator()(zlib::deflate_stream* p) const noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    operator()(zlib::inflate_stream* p) const noexcept;
+};
+
+using pooled_deflate_stream = std::unique_ptr<
+    zlib::deflate_stream, deflate_pool_deleter>;
+
+using pooled_inflate_stream = std::unique_ptr<
+    zlib::inflate_stream, deflate_pool_deleter>;
+
+// Process-wide pool of permessage-deflate state.
+//
+// Objects in the pool keep their buffers, so a stream
+// acquired with the same parameters as its last user
+// does not allocate.
+//
+class deflate_pool
+{
+    std::mutex m_;
+    std::vector<zlib::deflate_stream*> zo_;
+    std::vector<zlib::inflate_stream*> zi_;
+    std::size_t limit_ = 64;
+    deflate_pool_stats stats_;
+
+    friend struct deflate_pool_deleter;
+
+    BOOST_BEAST_DECL
+    void
+    put(zlib::deflate_stream* p) noexcept;
+
+    BOOST_BEAST_DECL
+    void
+    put(zlib::inflate_stream* p) noexcept;
+
+public:
+    BOOST_BEAST_DECL
+    deflate_pool();
+
+    deflate_pool(deflate_pool const&) = delete;
+    deflate_pool& operator=(deflate_pool const&) = delete;
+
+    // The pool is never destroyed, so that streams
+    // with static storage duration may outlive it.
+    BOOST_BEAST_DECL
+    static
+    deflate_pool&
+    instance();
+
+    // Returns a compressor, reset to the given parameters
+    BOOST_BEAST_DECL
+    pooled_deflate_stream
+    get_deflate(int level, int windowBits, int memLevel);
+
+    // Returns a decompressor, reset to the given window size
+    BOOST_BEAST_DECL
+    pooled_inflate_stream
+    get_inflate(int windowBits);
+
+    BOOST_BEAST_DECL
+    deflate_pool_stats
+    stats();
+
+    BOOST_BEAST_DECL
+    void
+    limit(std::size_t n);
+
+    BOOST_BEAST_DECL
+    void
+    shrink();
+};
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/websocket/detail/deflate_pool.ipp>
+#include <boost/beast/websocket/impl/deflate_pool.ipp>
+#endif
+
+#endif
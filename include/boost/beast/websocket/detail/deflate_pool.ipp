@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_POOL_IPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_DEFLATE_POOL_IPP
+
+#include <boost/beast/websocket/detail/deflate_pool.hpp>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+void
+deflate_pool_deleter::
+operator()(zlib::deflate_stream* p) const noexcept
+{
+    deflate_pool::instance().put(p);
+}
+
+void
+deflate_pool_deleter::
+operator()(zlib::inflate_stream* p) const noexcept
+{
+    deflate_pool::instance().put(p);
+}
+
+//------------------------------------------------------------------------------
+
+deflate_pool::
+deflate_pool()
+{
+    // put() must not allocate
+    zo_.reserve(limit_);
+    zi_.reserve(limit_);
+}
+
+deflate_pool&
+deflate_pool::
+instance()
+{
+    static deflate_pool* const p = new deflate_pool;
+    return *p;
+}
+
+void
+deflate_pool::
+put(zlib::deflate_stream* p) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        --stats_.deflate_in_use;
+        if(zo_.size() < limit_)
+        {
+            zo_.push_back(p);
+            return;
+        }
+    }
+    delete p;
+}
+
+void
+deflate_pool::
+put(zlib::inflate_stream* p) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        --stats_.inflate_in_use;
+        if(zi_.size() < limit_)
+        {
+            zi_.push_back(p);
+            return;
+        }
+    }
+    delete p;
+}
+
+pooled_deflate_stream
+deflate_pool::
+get_deflate(int level, int windowBits, int memLevel)
+{
+    zlib::deflate_stream* p = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        if(! zo_.empty())
+        {
+            p = zo_.back();
+            zo_.pop_back();
+            ++stats_.reused;
+            ++stats_.deflate_in_use;
+        }
+    }
+    if(! p)
+    {
+        p = new zlib::deflate_stream;
+        std::lock_guard<std::mutex> lock(m_);
+        ++stats_.created;
+        ++stats_.deflate_in_use;
+    }
+    pooled_deflate_stream zo(p);
+    zo->reset(level, windowBits, memLevel,
+        zlib::Strategy::normal);
+    return zo;
+}
+
+pooled_inflate_stream
+deflate_pool::
+get_inflate(int windowBits)
+{
+    zlib::inflate_stream* p = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        if(! zi_.empty())
+        {
+            p = zi_.back();
+            zi_.pop_back();
+            ++stats_.reused;
+            ++stats_.inflate_in_use;
+        }
+    }
+    if(! p)
+    {
+        p = new zlib::inflate_stream;
+        std::lock_guard<std::mutex> lock(m_);
+        ++stats_.created;
+        ++stats_.inflate_in_use;
+    }
+    pooled_inflate_stream zi(p);
+    zi->reset(windowBits);
+    return zi;
+}
+
+deflate_pool_stats
+deflate_pool::
+stats()
+{
+    std::lock_guard<std::mutex> lock(m_);
+    auto result = stats_;
+    result.deflate_pooled = zo_.size();
+    result.inflate_pooled = zi_.size();
+    return result;
+}
+
+void
+deflate_pool::
+limit(std::size_t n)
+{
+    std::vector<zlib::deflate_stream*> zo;
+    std::vector<zlib::inflate_stream*> zi;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        zo_.reserve(n);
+        zi_.reserve(n);
+        limit_ = n;
+        if(zo_.size() > n)
+        {
+            zo.assign(zo_.begin() + n, zo_.end());
+            zo_.resize(n);
+        }
+        if(zi_.size() > n)
+        {
+            zi.assign(zi_.begin() + n, zi_.end());
+            zi_.resize(n);
+        }
+    }
+    for(auto p : zo)
+        delete p;
+    for(auto p : zi)
+        delete p;
+}
+
+void
+deflate_pool::
+shrink()
+{
+    std::vector<zlib::deflate_stream*> zo;
+    std::vector<zlib::inflate_stream*> zi;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        // swap, keeping the reserved capacity in the pool
+        zo.reserve(limit_);
+        zi.reserve(limit_);
+        zo.swap(zo_);
+        zi.swap(zi_);
+    }
+    for(auto p : zo)
+        delete p;
+    for(auto p : zi)
+        delete p;
+}
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
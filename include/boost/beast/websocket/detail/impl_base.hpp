@@ -11,6 +11,8 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_IMPL_BASE_HPP
 
 #include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/prepared_message.hpp>
+#include <boost/beast/websocket/detail/deflate_pool.hpp>
 #include <boost/beast/websocket/detail/frame.hpp>
 #include <boost/beast/websocket/detail/pmd_extension.hpp>
 #include <boost/beast/core/buffer_traits.hpp>
@@ -24,6 +26,7 @@
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/detail/clamp.hpp>
 #include <boost/asio/buffer.hpp>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
@@ -47,8 +50,15 @@ struct impl_base<true>
         // `true` if current read message is compressed
         bool rd_set = false;
 
-        zlib::deflate_stream zo;
-        zlib::inflate_stream zi;
+        int zo_level;           // compression level
+        int zo_bits;            // window bits for compressing
+        int zo_mem;             // memLevel for compressing
+        int zi_bits;            // window bits for decompressing
+
+        // Taken from the pool on first use, and given
+        // back when the context does not need to be kept
+        pooled_deflate_stream zo;
+        pooled_inflate_stream zi;
     };
 
     std::unique_ptr<pmd_type>   pmd_;           // pmd settings or nullptr
@@ -75,6 +85,28 @@ struct impl_base<true>
         return ! rsv1; // pmd not negotiated
     }
 
+    // Returns the compressor, taking one from the pool if needed
+    zlib::deflate_stream&
+    get_zo()
+    {
+        auto& pmd = *pmd_;
+        if(! pmd.zo)
+            pmd.zo = deflate_pool::instance().get_deflate(
+                pmd.zo_level, pmd.zo_bits, pmd.zo_mem);
+        return *pmd.zo;
+    }
+
+    // Returns the decompressor, taking one from the pool if needed
+    zlib::inflate_stream&
+    get_zi()
+    {
+        auto& pmd = *pmd_;
+        if(! pmd.zi)
+            pmd.zi = deflate_pool::instance().get_inflate(
+                pmd.zi_bits);
+        return *pmd.zi;
+    }
+
     // Compress a buffer sequence
     // Returns: `true` if more calls are needed
     //
@@ -88,7 +120,7 @@ struct impl_base<true>
         error_code& ec)
     {
         BOOST_ASSERT(out.size() >= 6);
-        auto& zo = this->pmd_->zo;
+        auto& zo = this->get_zo();
         zlib::z_params zs;
         zs.avail_in = 0;
         zs.next_in = nullptr;
@@ -151,6 +183,81 @@ struct impl_base<true>
         return true;
     }
 
+    // Return the compressed form of a prepared message.
+    //
+    // The payload is compressed without context, once for each
+    // set of deflate parameters, and kept with the message so
+    // that every stream using the same parameters shares it.
+    // The message itself is returned if compression fails.
+    //
+    prepared_message
+    deflate(prepared_message const& m)
+    {
+        if(m.deflated_ || ! m.z_)
+            return m;
+        auto const& pmd = *pmd_;
+        prepared_message r;
+        if(m.z_->find(pmd.zo_level, pmd.zo_bits, pmd.zo_mem, r))
+            return r;
+
+        auto zo = deflate_pool::instance().get_deflate(
+            pmd.zo_level, pmd.zo_bits, pmd.zo_mem);
+        // Room for the largest header in front of the payload,
+        // and for the block and sync flushes after it
+        std::size_t const header_max = 10;
+        auto const limit = zo->upper_bound(m.size_) + 16;
+        std::shared_ptr<std::uint8_t> p(
+            new std::uint8_t[header_max + limit],
+            std::default_delete<std::uint8_t[]>());
+        zlib::z_params zs;
+        zs.next_in = m.p_.get() + m.header_;
+        zs.avail_in = m.size_;
+        zs.next_out = p.get() + header_max;
+        zs.avail_out = limit;
+        error_code ec;
+        while(zs.avail_in > 0 && zs.avail_out > 0)
+        {
+            zo->write(zs, zlib::Flush::none, ec);
+            if(ec)
+                return m;
+        }
+        if(zs.avail_in > 0)
+            return m;
+        zo->write(zs, zlib::Flush::block, ec);
+        if(ec == zlib::error::need_buffers)
+            ec = {};
+        if(ec || zs.avail_out < 6)
+            return m;
+        zo->write(zs, zlib::Flush::sync, ec);
+        if(ec)
+            return m;
+        // remove flush marker
+        auto const n = zs.total_out - 4;
+
+        frame_header fh;
+        fh.op = m.binary_ ? opcode::binary : opcode::text;
+        fh.fin = true;
+        fh.rsv1 = true;
+        fh.rsv2 = false;
+        fh.rsv3 = false;
+        fh.len = n;
+        fh.mask = false;
+        fh.key = 0;
+        fh_buffer fb;
+        write<flat_static_buffer_base>(fb, fh);
+        BOOST_ASSERT(fb.size() <= header_max);
+        auto const first = p.get() + header_max - fb.size();
+        net::buffer_copy(
+            net::buffer(first, fb.size()), fb.data());
+        r.p_ = std::shared_ptr<std::uint8_t const>(p, first);
+        r.header_ = fb.size();
+        r.size_ = n;
+        r.binary_ = m.binary_;
+        r.deflated_ = true;
+        return m.z_->insert(
+            pmd.zo_level, pmd.zo_bits, pmd.zo_mem, r);
+    }
+
     void
     do_context_takeover_write(role_type role)
     {
@@ -163,13 +270,42 @@ struct impl_base<true>
         }
     }
 
+    // Give the compressor back. The next message is compressed
+    // without the previous context, which a receiver must always
+    // accept. The decompressor is kept, since the peer's next
+    // message may refer to its context.
+    void
+    release_idle_pmd()
+    {
+        if(pmd_)
+            pmd_->zo.reset();
+    }
+
+    // Returns the time after which an unused compressor is
+    // given back, or the largest duration if it is kept
+    std::chrono::steady_clock::duration
+    pmd_idle_release() const
+    {
+        return pmd_opts_.idle_release;
+    }
+
+    // Returns `true` if a compressor is held which
+    // is given back once the connection is idle
+    bool
+    pmd_idle_pending() const
+    {
+        return pmd_ && pmd_->zo &&
+            pmd_opts_.idle_release != (
+                std::chrono::steady_clock::duration::max)();
+    }
+
     void
     inflate(
         zlib::z_params& zs,
         zlib::Flush flush,
         error_code& ec)
     {
-        pmd_->zi.write(zs, flush, ec);
+        get_zi().write(zs, flush, ec);
     }
 
     void
@@ -180,7 +316,7 @@ struct impl_base<true>
            (role == role_type::server &&
                 pmd_config_.client_no_context_takeover))
         {
-            pmd_->zi.clear();
+            pmd_->zi.reset();
         }
     }
 
@@ -269,25 +405,17 @@ struct impl_base<true>
         {
             detail::pmd_normalize(pmd_config_);
             pmd_.reset(::new pmd_type);
+            pmd_->zo_level = pmd_opts_.compLevel;
+            pmd_->zo_mem = pmd_opts_.memLevel;
             if(role == role_type::client)
             {
-                pmd_->zi.reset(
-                    pmd_config_.server_max_window_bits);
-                pmd_->zo.reset(
-                    pmd_opts_.compLevel,
-                    pmd_config_.client_max_window_bits,
-                    pmd_opts_.memLevel,
-                    zlib::Strategy::normal);
+                pmd_->zi_bits = pmd_config_.server_max_window_bits;
+                pmd_->zo_bits = pmd_config_.client_max_window_bits;
             }
             else
             {
-                pmd_->zi.reset(
-                    pmd_config_.client_max_window_bits);
-                pmd_->zo.reset(
-                    pmd_opts_.compLevel,
-                    pmd_config_.server_max_window_bits,
-                    pmd_opts_.memLevel,
-                    zlib::Strategy::normal);
+                pmd_->zi_bits = pmd_config_.client_max_window_bits;
+                pmd_->zo_bits = pmd_config_.server_max_window_bits;
             }
         }
     }
@@ -385,6 +513,12 @@ struct impl_base<false>
         return false;
     }
 
+    prepared_message
+    deflate(prepared_message const& m)
+    {
+        return m;
+    }
+
     void
     do_context_takeover_write(role_type)
     {
@@ -398,6 +532,23 @@ struct impl_base<false>
     {
     }
 
+    void
+    release_idle_pmd()
+    {
+    }
+
+    std::chrono::steady_clock::duration
+    pmd_idle_release() const
+    {
+        return (std::chrono::steady_clock::duration::max)();
+    }
+
+    bool
+    pmd_idle_pending() const
+    {
+        return false;
+    }
+
     void
     do_context_takeover_read(role_type)
     {
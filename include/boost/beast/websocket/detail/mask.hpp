@@ -13,9 +13,11 @@
 #include <boost/beast/core/detail/config.hpp>
 #include <boost/beast/core/buffers_range.hpp>
 #include <boost/asio/buffer.hpp>
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <type_traits>
 
@@ -49,6 +51,66 @@ mask_inplace(
         detail::mask_inplace(b, key);
 }
 
+// Copy and apply mask, returning the number of bytes
+// copied. The buffers must not overlap.
+//
+BOOST_BEAST_DECL
+std::size_t
+mask_copy(
+    net::mutable_buffer const& dest,
+    net::const_buffer const& source,
+    prepared_key& key);
+
+// Copy and apply mask in one pass, returning the number of
+// bytes copied. This is buffer_copy followed by mask_inplace,
+// without reading large pieces back. Runs of small pieces are
+// copied first and masked together while still in cache, since
+// their fixed cost would outweigh the saved pass.
+//
+template<class ConstBufferSequence>
+std::size_t
+mask_copy(
+    net::mutable_buffer const& dest,
+    ConstBufferSequence const& source,
+    prepared_key& key)
+{
+    std::size_t constexpr small = 128;
+    auto const p = static_cast<unsigned char*>(dest.data());
+    std::size_t total = 0;
+    std::size_t pending = 0;
+    for(net::const_buffer b :
+            beast::buffers_range_ref(source))
+    {
+        auto const n = (std::min)(
+            b.size(), dest.size() - total);
+        if(n == 0)
+        {
+            if(total == dest.size())
+                break;
+            continue;
+        }
+        if(n < small)
+        {
+            std::memcpy(p + total, b.data(), n);
+            pending += n;
+        }
+        else
+        {
+            if(pending > 0)
+                detail::mask_inplace(net::mutable_buffer(
+                    p + total - pending, pending), key);
+            pending = 0;
+            detail::mask_copy(net::mutable_buffer(
+                p + total, n), b, key);
+        }
+        total += n;
+    }
+    if(pending > 0)
+        detail::mask_inplace(net::mutable_buffer(
+            p + total - pending, pending), key);
+    return total;
+}
+
 } // detail
 } // websocket
 } // beast
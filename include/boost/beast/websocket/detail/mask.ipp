@@ -11,6 +11,11 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_MASK_IPP
 
 #include <boost/beast/websocket/detail/mask.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace boost {
 namespace beast {
@@ -26,36 +31,213 @@ prepare_key(prepared_key& prepared, std::uint32_t key)
     prepared[3] = (key >> 24) & 0xff;
 }
 
+// Rotate the key left by n octets, so that
+// v[0] becomes the octet which masks the next byte.
 inline
 void
 rol(prepared_key& v, std::size_t n)
 {
-    auto v0 = v;
-    for(std::size_t i = 0; i < v.size(); ++i )
-        v[i] = v0[(i + n) % v.size()];
+    auto const s = static_cast<int>(8 * (n % 4));
+    if(s == 0)
+        return;
+    std::uint32_t w;
+    std::memcpy(&w, v.data(), sizeof(w));
+    w = endian::native_to_little(w);
+    w = (w >> s) | (w << (32 - s));
+    w = endian::little_to_native(w);
+    std::memcpy(v.data(), &w, sizeof(w));
 }
 
-// Apply mask in place
-//
+/*  Masking kernels.
+
+    Each writes src[0..n) XOR the key to dst[0..n), starting at
+    key[0]. dst may equal src, which masks in place; otherwise the
+    ranges must not overlap. The key repeats every four octets, so
+    it always lines up with the start of a block and the kernels
+    never rotate it themselves.
+*/
+using mask_fn = void(*)(
+    unsigned char*, unsigned char const*,
+    std::size_t, prepared_key const&);
+
+inline
 void
-mask_inplace(net::mutable_buffer const& b, prepared_key& key)
+mask_swar(
+    unsigned char* dst,
+    unsigned char const* src,
+    std::size_t n,
+    prepared_key const& key)
 {
-    auto n = b.size();
-    auto const mask = key; // avoid aliasing
-    auto p = static_cast<unsigned char*>(b.data());
-    while(n >= 4)
+    // Both halves hold the key in memory order,
+    // so this works for either endianness
+    std::uint32_t k4;
+    std::memcpy(&k4, key.data(), sizeof(k4));
+    auto const k = (std::uint64_t{k4} << 32) | k4;
+    for(; n >= 8; dst += 8, src += 8, n -= 8)
     {
-        for(int i = 0; i < 4; ++i)
-            p[i] ^= mask[i];
-        p += 4;
-        n -= 4;
+        std::uint64_t w;
+        std::memcpy(&w, src, sizeof(w));
+        w ^= k;
+        std::memcpy(dst, &w, sizeof(w));
     }
-    if(n > 0)
+    for(std::size_t i = 0; i < n; ++i)
+        dst[i] = src[i] ^ key[i % 4];
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET_SSE2
+inline
+void
+mask_sse2(
+    unsigned char* dst,
+    unsigned char const* src,
+    std::size_t n,
+    prepared_key const& key)
+{
+    std::int32_t k;
+    std::memcpy(&k, key.data(), sizeof(k));
+    auto const k16 = _mm_set1_epi32(k);
+    for(; n >= 64; dst += 64, src += 64, n -= 64)
     {
-        for(std::size_t i = 0; i < n; ++i)
-            p[i] ^= mask[i];
-        rol(key, n);
+        auto const s = reinterpret_cast<__m128i const*>(src);
+        auto const d = reinterpret_cast<__m128i*>(dst);
+        auto const b0 = _mm_loadu_si128(s);
+        auto const b1 = _mm_loadu_si128(s + 1);
+        auto const b2 = _mm_loadu_si128(s + 2);
+        auto const b3 = _mm_loadu_si128(s + 3);
+        _mm_storeu_si128(d,     _mm_xor_si128(b0, k16));
+        _mm_storeu_si128(d + 1, _mm_xor_si128(b1, k16));
+        _mm_storeu_si128(d + 2, _mm_xor_si128(b2, k16));
+        _mm_storeu_si128(d + 3, _mm_xor_si128(b3, k16));
     }
+    for(; n >= 16; dst += 16, src += 16, n -= 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+            _mm_xor_si128(_mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(src)), k16));
+    mask_swar(dst, src, n, key);
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+void
+mask_avx2(
+    unsigned char* dst,
+    unsigned char const* src,
+    std::size_t n,
+    prepared_key const& key)
+{
+    std::int32_t k;
+    std::memcpy(&k, key.data(), sizeof(k));
+    auto const k32 = _mm256_set1_epi32(k);
+    for(; n >= 128; dst += 128, src += 128, n -= 128)
+    {
+        auto const s = reinterpret_cast<__m256i const*>(src);
+        auto const d = reinterpret_cast<__m256i*>(dst);
+        auto const b0 = _mm256_loadu_si256(s);
+        auto const b1 = _mm256_loadu_si256(s + 1);
+        auto const b2 = _mm256_loadu_si256(s + 2);
+        auto const b3 = _mm256_loadu_si256(s + 3);
+        _mm256_storeu_si256(d,     _mm256_xor_si256(b0, k32));
+        _mm256_storeu_si256(d + 1, _mm256_xor_si256(b1, k32));
+        _mm256_storeu_si256(d + 2, _mm256_xor_si256(b2, k32));
+        _mm256_storeu_si256(d + 3, _mm256_xor_si256(b3, k32));
+    }
+    for(; n >= 32; dst += 32, src += 32, n -= 32)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+            _mm256_xor_si256(_mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(src)), k32));
+    if(n >= 16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+            _mm_xor_si128(_mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(src)),
+                _mm256_castsi256_si128(k32)));
+        dst += 16;
+        src += 16;
+        n -= 16;
+    }
+    // Stay in VEX encoding, calling mask_sse2 here
+    // would pay an SSE/AVX transition.
+    mask_swar(dst, src, n, key);
+}
+
+#endif
+
+inline
+mask_fn
+select_mask()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        return &mask_avx2;
+    if(ci.sse2)
+        return &mask_sse2;
+#endif
+    return &mask_swar;
+}
+
+inline
+void
+mask_bytes(
+    unsigned char* dst,
+    unsigned char const* src,
+    std::size_t n,
+    prepared_key& key)
+{
+    auto const size = n;
+    auto mask = key; // avoid aliasing
+    if(n >= 64)
+    {
+        static mask_fn const fn = select_mask();
+
+        // Align large payloads so that no store
+        // straddles a cache line
+        if(n >= 512)
+        {
+            auto const head = static_cast<std::size_t>(
+                (0 - reinterpret_cast<std::uintptr_t>(dst)) & 31);
+            for(std::size_t i = 0; i < head; ++i)
+                dst[i] = src[i] ^ mask[i % 4];
+            rol(mask, head);
+            dst += head;
+            src += head;
+            n -= head;
+        }
+        fn(dst, src, n, mask);
+    }
+    else
+    {
+        // Control frames and small messages
+        mask_swar(dst, src, n, mask);
+    }
+    rol(key, size);
+}
+
+// Apply mask in place
+//
+void
+mask_inplace(net::mutable_buffer const& b, prepared_key& key)
+{
+    auto const p = static_cast<unsigned char*>(b.data());
+    mask_bytes(p, p, b.size(), key);
+}
+
+// Copy and apply mask
+//
+std::size_t
+mask_copy(
+    net::mutable_buffer const& dest,
+    net::const_buffer const& source,
+    prepared_key& key)
+{
+    auto const n = (std::min)(dest.size(), source.size());
+    mask_bytes(
+        static_cast<unsigned char*>(dest.data()),
+        static_cast<unsigned char const*>(source.data()),
+        n, key);
+    return n;
 }
 
 } // detail
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_DETAIL_READ_BUFFER_HPP
+#define BOOST_BEAST_WEBSOCKET_DETAIL_READ_BUFFER_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+// The DynamicBuffer used by the stream to read frames.
+//
+// The buffer offers `min` bytes to each read. When a read fills
+// the space offered, the next read is offered twice as much, up
+// to `max` bytes; when reads return little, the offer decays back
+// to `min`. Storage larger than the current offer is released
+// whenever the buffer becomes empty. Only short reads decay the
+// offer, so a stream whose last read filled a large offer keeps
+// storage of that size while it is idle.
+//
+class read_buffer
+{
+    std::unique_ptr<char[]> p_;
+    std::size_t cap_ = 0;           // allocated bytes
+    std::size_t in_ = 0;            // offset of readable bytes
+    std::size_t out_ = 0;           // offset of writable bytes
+    std::size_t last_ = 0;          // end of the prepared bytes
+    std::size_t min_;               // smallest read size
+    std::size_t max_;               // largest number of bytes held
+    std::size_t next_;              // size of the next read
+
+public:
+    using const_buffers_type = net::const_buffer;
+    using mutable_buffers_type = net::mutable_buffer;
+
+    explicit
+    read_buffer(std::size_t n) noexcept
+        : min_(n)
+        , max_(n)
+        , next_(n)
+    {
+    }
+
+    // Set the largest number of bytes held. Data in
+    // the buffer is kept even if it exceeds the limit.
+    void
+    max_size(std::size_t n) noexcept
+    {
+        BOOST_ASSERT(n >= min_);
+        max_ = n;
+        next_ = (std::min)(next_, max_);
+        if(size() == 0 && cap_ > max_)
+            release();
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return out_ - in_;
+    }
+
+    std::size_t
+    max_size() const noexcept
+    {
+        return max_;
+    }
+
+    std::size_t
+    capacity() const noexcept
+    {
+        return max_;
+    }
+
+    const_buffers_type
+    data() const noexcept
+    {
+        return {p_.get() + in_, size()};
+    }
+
+    const_buffers_type
+    cdata() const noexcept
+    {
+        return data();
+    }
+
+    mutable_buffers_type
+    data() noexcept
+    {
+        return {p_.get() + in_, size()};
+    }
+
+    mutable_buffers_type
+    prepare(std::size_t n)
+    {
+        auto const len = size();
+        if(n > cap_ - out_)
+        {
+            if(n > max_ - len)
+                BOOST_THROW_EXCEPTION(std::length_error{
+                    "read_buffer overflow"});
+            if(n <= cap_ - len)
+            {
+                // move the readable bytes to the front
+                if(len > 0)
+                    std::memmove(p_.get(), p_.get() + in_, len);
+            }
+            else
+            {
+                auto const cap = (std::min)(
+                    (std::max)(len + n, next_), max_);
+                std::unique_ptr<char[]> p(new char[cap]);
+                if(len > 0)
+                    std::memcpy(p.get(), p_.get() + in_, len);
+                p_ = std::move(p);
+                cap_ = cap;
+            }
+            in_ = 0;
+            out_ = len;
+        }
+        last_ = out_ + n;
+        return {p_.get() + out_, n};
+    }
+
+    void
+    commit(std::size_t n) noexcept
+    {
+        auto const offered = last_ - out_;
+        n = (std::min)(n, offered);
+        out_ += n;
+        last_ = out_;
+        if(n == offered && n >= next_)
+        {
+            // the read filled the space offered
+            next_ = (std::min)(next_ * 2, max_);
+        }
+        else if(n < next_ / 4)
+        {
+            next_ = (std::max)(next_ / 2, min_);
+        }
+    }
+
+    void
+    consume(std::size_t n) noexcept
+    {
+        if(n >= size())
+        {
+            clear();
+            return;
+        }
+        in_ += n;
+    }
+
+    void
+    clear() noexcept
+    {
+        in_ = 0;
+        out_ = 0;
+        last_ = 0;
+        if(cap_ > next_)
+            release();
+    }
+
+    // Returns the number of bytes to offer to the next read
+    friend
+    std::size_t
+    read_size_helper(
+        read_buffer& b, std::size_t max_size) noexcept
+    {
+        return (std::min)(
+            (std::min)(b.next_, max_size),
+            b.max_ - b.size());
+    }
+
+private:
+    void
+    release() noexcept
+    {
+        p_.reset();
+        cap_ = 0;
+    }
+};
+
+} // detail
+} // websocket
+} // beast
+} // boost
+
+#endif
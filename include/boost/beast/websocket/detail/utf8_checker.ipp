@@ -11,8 +11,10 @@
 #define BOOST_BEAST_WEBSOCKET_DETAIL_UTF8_CHECKER_IPP
 
 #include <boost/beast/websocket/detail/utf8_checker.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
 
 #include <boost/assert.hpp>
+#include <cstring>
 
 namespace boost {
 namespace beast {
@@ -36,6 +38,284 @@ finish()
     return success;
 }
 
+/*  Vector validation, after John Keiser and Daniel Lemire,
+    "Validating UTF-8 In Less Than One Instruction Per Byte".
+
+    Each block is checked against the byte before it with three
+    nibble lookups, whose results AND to nonzero on any invalid
+    pair of bytes. Three and four byte sequences are then checked
+    by requiring continuations exactly where prev2 and prev3 say
+    they must be. Pure ASCII blocks only check that the previous
+    block did not end inside a code point.
+
+    The kernels validate [p, end) as complete text: a code point
+    cut off at the end is an error, so the caller passes only the
+    part which ends on a code point boundary.
+*/
+using validate_fn = bool(*)(
+    std::uint8_t const*, std::uint8_t const*);
+
+// Returns the end of the longest prefix of [first, last)
+// which does not stop inside a code point. Bytes which
+// are invalid anyway are left for the validator.
+inline
+std::uint8_t const*
+complete_prefix(
+    std::uint8_t const* first,
+    std::uint8_t const* last)
+{
+    auto p = last;
+    std::size_t k = 0;
+    while(p != first && k < 3 && (p[-1] & 0xc0) == 0x80)
+    {
+        --p;
+        ++k;
+    }
+    if(p == first || p[-1] < 0xc0)
+        return last;
+    std::size_t const len =
+        p[-1] < 0xe0 ? 2 : (p[-1] < 0xf0 ? 3 : 4);
+    if(len > k + 1)
+        return p - 1;
+    return last;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+// Error bits of the nibble lookups
+//
+//  0x01 too short: lead not followed by a continuation
+//  0x02 too long: ASCII followed by a continuation
+//  0x04 overlong 3 byte
+//  0x08 too large
+//  0x10 surrogate
+//  0x20 overlong 2 byte
+//  0x40 too large (1000____) or overlong 4 byte
+//  0x80 two continuations
+//
+#define BOOST_BEAST_UTF8_BYTE_1_HIGH \
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, \
+    static_cast<char>(0x80), static_cast<char>(0x80), \
+    static_cast<char>(0x80), static_cast<char>(0x80), \
+    0x21, 0x01, 0x15, 0x49
+
+#define BOOST_BEAST_UTF8_BYTE_1_LOW \
+    static_cast<char>(0xe7), static_cast<char>(0xa3), \
+    static_cast<char>(0x83), static_cast<char>(0x83), \
+    static_cast<char>(0x8b), static_cast<char>(0xcb), \
+    static_cast<char>(0xcb), static_cast<char>(0xcb), \
+    static_cast<char>(0xcb), static_cast<char>(0xcb), \
+    static_cast<char>(0xcb), static_cast<char>(0xcb), \
+    static_cast<char>(0xcb), static_cast<char>(0xdb), \
+    static_cast<char>(0xcb), static_cast<char>(0xcb)
+
+#define BOOST_BEAST_UTF8_BYTE_2_HIGH \
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, \
+    static_cast<char>(0xe6), static_cast<char>(0xae), \
+    static_cast<char>(0xba), static_cast<char>(0xba), \
+    0x01, 0x01, 0x01, 0x01
+
+// Nonzero in the last three octets when they
+// start a code point which needs more octets
+#define BOOST_BEAST_UTF8_MAX_VALUE \
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, \
+    static_cast<char>(0xef), static_cast<char>(0xdf), \
+    static_cast<char>(0xbf)
+
+struct validate_sse42_state
+{
+    __m128i prev;
+    __m128i incomplete;
+    __m128i error;
+};
+
+BOOST_BEAST_TARGET_SSE42
+inline
+void
+validate_sse42_block(
+    validate_sse42_state& st,
+    __m128i const in)
+{
+    if(_mm_movemask_epi8(in) == 0)
+    {
+        st.error = _mm_or_si128(st.error, st.incomplete);
+        st.incomplete = _mm_setzero_si128();
+        st.prev = in;
+        return;
+    }
+    auto const nibble = _mm_set1_epi8(0x0f);
+    auto const prev1 = _mm_alignr_epi8(in, st.prev, 15);
+    auto const prev2 = _mm_alignr_epi8(in, st.prev, 14);
+    auto const prev3 = _mm_alignr_epi8(in, st.prev, 13);
+    auto const sc = _mm_and_si128(_mm_and_si128(
+        _mm_shuffle_epi8(
+            _mm_setr_epi8(BOOST_BEAST_UTF8_BYTE_1_HIGH),
+            _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+        _mm_shuffle_epi8(
+            _mm_setr_epi8(BOOST_BEAST_UTF8_BYTE_1_LOW),
+            _mm_and_si128(prev1, nibble))),
+        _mm_shuffle_epi8(
+            _mm_setr_epi8(BOOST_BEAST_UTF8_BYTE_2_HIGH),
+            _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+    // 111_____ two back or 1111____ three
+    // back means this must be a continuation
+    auto const must23 = _mm_and_si128(_mm_or_si128(
+        _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80)),
+        _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80))),
+        _mm_set1_epi8(static_cast<char>(0x80)));
+    st.error = _mm_or_si128(st.error, _mm_xor_si128(must23, sc));
+    st.incomplete = _mm_subs_epu8(in,
+        _mm_setr_epi8(BOOST_BEAST_UTF8_MAX_VALUE));
+    st.prev = in;
+}
+
+BOOST_BEAST_TARGET_SSE42
+inline
+bool
+validate_sse42(
+    std::uint8_t const* p,
+    std::uint8_t const* end)
+{
+    validate_sse42_state st;
+    st.prev = _mm_setzero_si128();
+    st.incomplete = _mm_setzero_si128();
+    st.error = _mm_setzero_si128();
+    for(; end - p >= 16; p += 16)
+        validate_sse42_block(st, _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(p)));
+    if(p != end)
+    {
+        // zero padding is ASCII
+        std::uint8_t buf[16] = {};
+        std::memcpy(buf, p, end - p);
+        validate_sse42_block(st, _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(buf)));
+    }
+    st.error = _mm_or_si128(st.error, st.incomplete);
+    return _mm_testz_si128(st.error, st.error) != 0;
+}
+
+struct validate_avx2_state
+{
+    __m256i prev;
+    __m256i incomplete;
+    __m256i error;
+};
+
+BOOST_BEAST_TARGET_AVX2
+inline
+void
+validate_avx2_block(
+    validate_avx2_state& st,
+    __m256i const in)
+{
+    if(_mm256_movemask_epi8(in) == 0)
+    {
+        st.error = _mm256_or_si256(st.error, st.incomplete);
+        st.incomplete = _mm256_setzero_si256();
+        st.prev = in;
+        return;
+    }
+    auto const nibble = _mm256_set1_epi8(0x0f);
+    // the high half of prev next to the low half of in
+    auto const shifted = _mm256_permute2x128_si256(st.prev, in, 0x21);
+    auto const prev1 = _mm256_alignr_epi8(in, shifted, 15);
+    auto const prev2 = _mm256_alignr_epi8(in, shifted, 14);
+    auto const prev3 = _mm256_alignr_epi8(in, shifted, 13);
+    auto const sc = _mm256_and_si256(_mm256_and_si256(
+        _mm256_shuffle_epi8(
+            _mm256_setr_epi8(
+                BOOST_BEAST_UTF8_BYTE_1_HIGH,
+                BOOST_BEAST_UTF8_BYTE_1_HIGH),
+            _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+        _mm256_shuffle_epi8(
+            _mm256_setr_epi8(
+                BOOST_BEAST_UTF8_BYTE_1_LOW,
+                BOOST_BEAST_UTF8_BYTE_1_LOW),
+            _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(
+            _mm256_setr_epi8(
+                BOOST_BEAST_UTF8_BYTE_2_HIGH,
+                BOOST_BEAST_UTF8_BYTE_2_HIGH),
+            _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+    auto const must23 = _mm256_and_si256(_mm256_or_si256(
+        _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80)),
+        _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80))),
+        _mm256_set1_epi8(static_cast<char>(0x80)));
+    st.error = _mm256_or_si256(st.error,
+        _mm256_xor_si256(must23, sc));
+    st.incomplete = _mm256_subs_epu8(in, _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1,
+        BOOST_BEAST_UTF8_MAX_VALUE));
+    st.prev = in;
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+bool
+validate_avx2(
+    std::uint8_t const* p,
+    std::uint8_t const* end)
+{
+    validate_avx2_state st;
+    st.prev = _mm256_setzero_si256();
+    st.incomplete = _mm256_setzero_si256();
+    st.error = _mm256_setzero_si256();
+    for(; end - p >= 64; p += 64)
+    {
+        auto const in0 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p));
+        auto const in1 = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p + 32));
+        if(_mm256_movemask_epi8(_mm256_or_si256(in0, in1)) == 0)
+        {
+            // 64 octets of ASCII
+            st.error = _mm256_or_si256(st.error, st.incomplete);
+            st.incomplete = _mm256_setzero_si256();
+            st.prev = in1;
+            continue;
+        }
+        validate_avx2_block(st, in0);
+        validate_avx2_block(st, in1);
+    }
+    for(; end - p >= 32; p += 32)
+        validate_avx2_block(st, _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(p)));
+    if(p != end)
+    {
+        // zero padding is ASCII
+        std::uint8_t buf[32] = {};
+        std::memcpy(buf, p, end - p);
+        validate_avx2_block(st, _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(buf)));
+    }
+    st.error = _mm256_or_si256(st.error, st.incomplete);
+    return _mm256_testz_si256(st.error, st.error) != 0;
+}
+
+#undef BOOST_BEAST_UTF8_BYTE_1_HIGH
+#undef BOOST_BEAST_UTF8_BYTE_1_LOW
+#undef BOOST_BEAST_UTF8_BYTE_2_HIGH
+#undef BOOST_BEAST_UTF8_MAX_VALUE
+
+#endif
+
+// Returns null when only the scalar code is available
+inline
+validate_fn
+select_validate()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        return &validate_avx2;
+    if(ci.sse42)
+        return &validate_sse42;
+#endif
+    return nullptr;
+}
+
 bool
 utf8_checker::
 write(std::uint8_t const* in, std::size_t size)
@@ -205,6 +485,21 @@ write(std::uint8_t const* in, std::size_t size)
         p_ = cp_;
     }
 
+    // Vector validation of everything up to a trailing
+    // partial code point, which the tail loop saves.
+    if(size >= 64)
+    {
+        static validate_fn const fn = select_validate();
+        if(fn)
+        {
+            auto const last = complete_prefix(in, end);
+            if(! fn(in, last))
+                return false;
+            in = last;
+            goto tail;
+        }
+    }
+
     if(size <= sizeof(std::size_t))
         goto slow;
 
@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_IMPL_DEFLATE_POOL_IPP
+#define BOOST_BEAST_WEBSOCKET_IMPL_DEFLATE_POOL_IPP
+
+#include <boost/beast/websocket/deflate_pool.hpp>
+#include <boost/beast/websocket/detail/deflate_pool.hpp>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+deflate_pool_stats
+get_deflate_pool_stats()
+{
+    return detail::deflate_pool::instance().stats();
+}
+
+void
+set_deflate_pool_limit(std::size_t n)
+{
+    detail::deflate_pool::instance().limit(n);
+}
+
+void
+shrink_deflate_pool()
+{
+    detail::deflate_pool::instance().shrink();
+}
+
+} // websocket
+} // beast
+} // boost
+
+#endif
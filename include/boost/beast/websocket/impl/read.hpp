@@ -901,6 +901,117 @@ struct stream<NextLayer, deflateSupported>::
 
 //------------------------------------------------------------------------------
 
+template<class NextLayer, bool deflateSupported>
+template<class Handler, class Buffers>
+class stream<NextLayer, deflateSupported>::read_messages_op
+    : public beast::async_base<
+        Handler, beast::executor_type<stream>>
+    , public asio::coroutine
+{
+    boost::weak_ptr<impl_type> wp_;
+    Buffers& bs_;
+    std::size_t n_ = 0;
+
+public:
+    template<class Handler_>
+    read_messages_op(
+        Handler_&& h,
+        boost::shared_ptr<impl_type> const& sp,
+        Buffers& bs)
+        : async_base<Handler,
+            beast::executor_type<stream>>(
+                std::forward<Handler_>(h),
+                    sp->stream().get_executor())
+        , wp_(sp)
+        , bs_(bs)
+    {
+        BOOST_ASSERT(! bs_.empty());
+        (*this)({}, 0, false);
+    }
+
+    void operator()(
+        error_code ec = {},
+        std::size_t = 0,
+        bool cont = true)
+    {
+        auto sp = wp_.lock();
+        if(! sp)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec, net::error::operation_aborted);
+            n_ = 0;
+            return this->complete(cont, ec, n_);
+        }
+        auto& impl = *sp;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD
+            {
+                BOOST_ASIO_HANDLER_LOCATION((
+                    __FILE__, __LINE__,
+                    "websocket::async_read_messages"));
+
+                read_op<read_messages_op, typename Buffers::value_type>(
+                    std::move(*this), sp, bs_.front(), 0, false);
+            }
+            if(ec)
+                goto upcall;
+            n_ = 1;
+
+            // A close or ping operation may have taken
+            // the read block when the read completed.
+            if(! impl.rd_block.is_locked())
+                while( n_ < bs_.size() &&
+                    impl.read_buffered(bs_[n_], impl.rd_op))
+                    ++n_;
+
+        upcall:
+            this->complete(cont, ec, n_);
+        }
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+struct stream<NextLayer, deflateSupported>::
+    run_read_messages_op
+{
+    boost::shared_ptr<impl_type> const& self;
+
+    using executor_type = typename stream::executor_type;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return self->stream().get_executor();
+    }
+
+    template<
+        class ReadHandler,
+        class Buffers>
+    void
+    operator()(
+        ReadHandler&& h,
+        Buffers* bs)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<ReadHandler,
+                void(error_code, std::size_t)>::value,
+            "ReadHandler type requirements not met");
+
+        read_messages_op<
+            typename std::decay<ReadHandler>::type,
+            Buffers>(
+                std::forward<ReadHandler>(h),
+                self,
+                *bs);
+    }
+};
+
+//------------------------------------------------------------------------------
+
 template<class NextLayer, bool deflateSupported>
 template<class DynamicBuffer>
 std::size_t
@@ -964,6 +1075,72 @@ async_read(DynamicBuffer& buffer, ReadHandler&& handler)
 
 //------------------------------------------------------------------------------
 
+template<class NextLayer, bool deflateSupported>
+template<class DynamicBuffer, class Allocator>
+std::size_t
+stream<NextLayer, deflateSupported>::
+read_messages(std::vector<DynamicBuffer, Allocator>& buffers)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    static_assert(
+        net::is_dynamic_buffer<DynamicBuffer>::value,
+        "DynamicBuffer type requirements not met");
+    error_code ec;
+    auto const n = read_messages(buffers, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return n;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<class DynamicBuffer, class Allocator>
+std::size_t
+stream<NextLayer, deflateSupported>::
+read_messages(
+    std::vector<DynamicBuffer, Allocator>& buffers,
+    error_code& ec)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    static_assert(
+        net::is_dynamic_buffer<DynamicBuffer>::value,
+        "DynamicBuffer type requirements not met");
+    BOOST_ASSERT(! buffers.empty());
+    read(buffers.front(), ec);
+    if(ec)
+        return 0;
+    std::size_t n = 1;
+    while( n < buffers.size() &&
+        impl_->read_buffered(buffers[n], impl_->rd_op))
+        ++n;
+    return n;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<class DynamicBuffer, class Allocator,
+    BOOST_BEAST_ASYNC_TPARAM2 ReadHandler>
+BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
+stream<NextLayer, deflateSupported>::
+async_read_messages(
+    std::vector<DynamicBuffer, Allocator>& buffers,
+    ReadHandler&& handler)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    static_assert(
+        net::is_dynamic_buffer<DynamicBuffer>::value,
+        "DynamicBuffer type requirements not met");
+    return net::async_initiate<
+        ReadHandler,
+        void(error_code, std::size_t)>(
+            run_read_messages_op{impl_},
+            handler,
+            &buffers);
+}
+
+//------------------------------------------------------------------------------
+
 template<class NextLayer, bool deflateSupported>
 template<class DynamicBuffer>
 std::size_t
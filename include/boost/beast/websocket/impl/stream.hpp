@@ -288,6 +288,25 @@ secure_prng(bool value)
     this->impl_->secure_prng_ = value;
 }
 
+template<class NextLayer, bool deflateSupported>
+void
+stream<NextLayer, deflateSupported>::
+read_buffer_bytes(std::size_t amount)
+{
+    if(amount < tcp_frame_size)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            "read buffer size underflow"});
+    impl_->rd_buf.max_size(amount);
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+read_buffer_bytes() const
+{
+    return impl_->rd_buf.max_size();
+}
+
 template<class NextLayer, bool deflateSupported>
 void
 stream<NextLayer, deflateSupported>::
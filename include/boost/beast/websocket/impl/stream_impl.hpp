@@ -16,6 +16,7 @@
 #include <boost/beast/websocket/detail/mask.hpp>
 #include <boost/beast/websocket/detail/pmd_extension.hpp>
 #include <boost/beast/websocket/detail/prng.hpp>
+#include <boost/beast/websocket/detail/read_buffer.hpp>
 #include <boost/beast/websocket/detail/service.hpp>
 #include <boost/beast/websocket/detail/soft_mutex.hpp>
 #include <boost/beast/websocket/detail/utf8_checker.hpp>
@@ -24,6 +25,7 @@
 #include <boost/beast/http/rfc7230.hpp>
 #include <boost/beast/core/buffers_cat.hpp>
 #include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/core/buffers_range.hpp>
 #include <boost/beast/core/buffers_suffix.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/beast/core/saved_handler.hpp>
@@ -35,6 +37,9 @@
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/optional.hpp>
+#include <cstring>
+#include <iterator>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -71,6 +76,9 @@ struct stream<NextLayer, deflateSupported>::impl_type
     using executor_type = typename std::decay<NextLayer>::type::executor_type;
     typename net::steady_timer::rebind_executor<executor_type>::other
                             timer;          // used for timeouts
+    typename net::steady_timer::rebind_executor<executor_type>::other
+                            pmd_timer;      // releases an idle compressor
+    time_point              pmd_wr_time;    // when the last compressed message was written
     close_reason            cr;             // set from received close frame
     control_cb_type         ctrl_cb;        // control callback
 
@@ -81,8 +89,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
     detail::prepared_key    rd_key;         // current stateful mask key
     detail::frame_buffer    rd_fb;          // to write control frames (during reads)
     detail::utf8_checker    rd_utf8;        // to validate utf8
-    static_buffer<
-        +tcp_frame_size>    rd_buf;         // buffer for reads
+    detail::read_buffer     rd_buf          /* buffer for reads */ {+tcp_frame_size};
     detail::opcode          rd_op           /* current message binary or text */ = detail::opcode::text;
     bool                    rd_cont         /* `true` if the next frame is a continuation */ = false;
     bool                    rd_done         /* set when a message is done */ = true;
@@ -132,6 +139,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
             this->get_context(
                 this->boost::empty_value<NextLayer>::get().get_executor()))
         , timer(this->boost::empty_value<NextLayer>::get().get_executor())
+        , pmd_timer(this->boost::empty_value<NextLayer>::get().get_executor())
     {
         timeout_opt.handshake_timeout = none();
         timeout_opt.idle_timeout = none();
@@ -155,6 +163,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
     {
         // VFALCO TODO analyze and remove dupe code in reset()
         timer.expires_at(never());
+        pmd_timer.expires_at(never());
         timed_out = false;
         cr.code = close_code::none;
         role = role_;
@@ -183,6 +192,7 @@ struct stream<NextLayer, deflateSupported>::impl_type
     close()
     {
         timer.cancel();
+        pmd_timer.expires_at(never());
         wr_buf.reset();
         this->close_pmd();
     }
@@ -251,6 +261,50 @@ struct stream<NextLayer, deflateSupported>::impl_type
         //
     }
 
+    // Returns `true` if any of the messages would be compressed
+    template<class ConstBufferSequences>
+    bool
+    any_compressed(ConstBufferSequences const& messages) const
+    {
+        if(! this->pmd_enabled() || ! wr_compress_opt)
+            return false;
+        for(auto const& m : messages)
+            if( detail::batch_compressible(m) &&
+                this->should_compress(beast::buffer_bytes(
+                    detail::batch_payload(m))))
+                return true;
+        return false;
+    }
+
+    // Returns the form in which a message of a batch is sent
+    template<class ConstBufferSequence>
+    ConstBufferSequence const&
+    batch_select(ConstBufferSequence const& m)
+    {
+        return m;
+    }
+
+    prepared_message
+    batch_select(prepared_message const& m)
+    {
+        if( this->pmd_enabled() && wr_compress_opt &&
+            this->should_compress(m.size()))
+            return this->deflate(m);
+        return m;
+    }
+
+    // Frame a batch of complete messages for a single write.
+    // Frame headers, masked payloads and payloads smaller than
+    // a TCP frame are copied into `storage`, larger unmasked
+    // payloads and prepared messages are referenced. Returns
+    // the total payload size.
+    template<class ConstBufferSequences>
+    std::size_t
+    frame_messages(
+        ConstBufferSequences const& messages,
+        std::unique_ptr<std::uint8_t[]>& storage,
+        std::vector<net::const_buffer>& out);
+
     //--------------------------------------------------------------------------
 
     template<class Decorator>
@@ -281,6 +335,16 @@ struct stream<NextLayer, deflateSupported>::impl_type
     parse_fh(detail::frame_header& fh,
         DynamicBuffer& b, error_code& ec);
 
+    // Append a complete message of type `op` from the read
+    // buffer without performing I/O. Returns `false` if the
+    // read buffer does not begin with a complete, final and
+    // uncompressed frame of that type which is valid and fits.
+    // Nothing is consumed in that case, so the frame is left
+    // for a regular read to handle or report.
+    template<class DynamicBuffer>
+    bool
+    read_buffered(DynamicBuffer& b, detail::opcode op);
+
     std::uint32_t
     create_mask()
     {
@@ -497,6 +561,28 @@ struct stream<NextLayer, deflateSupported>::impl_type
         }
     }
 
+    // Called after a compressed message is written, to give
+    // the compressor back once no message follows in time
+    void
+    update_pmd_timer()
+    {
+        if(! this->pmd_idle_pending())
+            return;
+        pmd_wr_time = std::chrono::steady_clock::now();
+        if(pmd_timer.expiry() != never())
+            return;
+        pmd_timer.expires_at(
+            pmd_wr_time + this->pmd_idle_release());
+
+        BOOST_ASIO_HANDLER_LOCATION((
+            __FILE__, __LINE__,
+            "websocket::update_pmd_timer"
+            ));
+
+        pmd_timer.async_wait(
+            pmd_timeout_handler(this->weak_from_this()));
+    }
+
 private:
     template<class Executor>
     static net::execution_context&
@@ -609,6 +695,67 @@ private:
             }
         }
     };
+
+    class pmd_timeout_handler
+    {
+        boost::weak_ptr<impl_type> wp_;
+
+    public:
+        explicit
+        pmd_timeout_handler(
+            boost::weak_ptr<impl_type>&& wp)
+            : wp_(std::move(wp))
+        {
+        }
+
+        void
+        operator()(error_code ec)
+        {
+            // timer canceled?
+            if(ec == net::error::operation_aborted)
+                return;
+            BOOST_ASSERT(! ec);
+
+            // stream destroyed?
+            auto sp = wp_.lock();
+            if(! sp)
+                return;
+            auto& impl = *sp;
+
+            if(impl.status_ != status::open)
+            {
+                impl.pmd_timer.expires_at(never());
+                return;
+            }
+
+            auto const expiry =
+                impl.pmd_wr_time + impl.pmd_idle_release();
+            if( impl.wr_block.is_locked() || impl.wr_cont)
+            {
+                // a message is being written
+                impl.pmd_timer.expires_after(
+                    impl.pmd_idle_release());
+            }
+            else if(expiry > std::chrono::steady_clock::now())
+            {
+                // a message was written since the timer was set
+                impl.pmd_timer.expires_at(expiry);
+            }
+            else
+            {
+                impl.release_idle_pmd();
+                impl.pmd_timer.expires_at(never());
+                return;
+            }
+
+            BOOST_ASIO_HANDLER_LOCATION((
+                __FILE__, __LINE__,
+                "websocket::pmd_timeout_handler"
+                ));
+
+            impl.pmd_timer.async_wait(std::move(*this));
+        }
+    };
 };
 
 //--------------------------------------------------------------------------
@@ -907,6 +1054,197 @@ parse_fh(
     return true;
 }
 
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequences>
+std::size_t
+stream<NextLayer, deflateSupported>::impl_type::
+frame_messages(
+    ConstBufferSequences const& messages,
+    std::unique_ptr<std::uint8_t[]>& storage,
+    std::vector<net::const_buffer>& out)
+{
+    bool const mask = role == role_type::client;
+    auto const copied =
+        [mask](std::size_t n)
+        {
+            return mask || n < tcp_frame_size;
+        };
+    auto const header_size =
+        [mask](std::size_t n) -> std::size_t
+        {
+            return 2 + (n > 65535 ? 8 : n > 125 ? 2 : 0) +
+                (mask ? 4 : 0);
+        };
+    std::size_t size = 0;
+    std::size_t referenced = 0;
+    for(auto const& m0 : messages)
+    {
+        auto const& m = batch_select(m0);
+        if(! mask && detail::batch_frame(m).size() > 0)
+        {
+            // sent as is
+            ++referenced;
+            continue;
+        }
+        auto const& payload = detail::batch_payload(m);
+        auto const n = beast::buffer_bytes(payload);
+        size += header_size(n);
+        if(copied(n))
+            size += n;
+        else
+            referenced += static_cast<std::size_t>(std::distance(
+                net::buffer_sequence_begin(payload),
+                net::buffer_sequence_end(payload)));
+    }
+    if(size > 0)
+        storage = boost::make_unique_noinit<std::uint8_t[]>(size);
+    out.clear();
+    out.reserve(2 * referenced + 1);
+
+    detail::frame_header fh;
+    fh.fin = true;
+    fh.rsv1 = false;
+    fh.rsv2 = false;
+    fh.rsv3 = false;
+    fh.mask = mask;
+    fh.key = 0;
+    std::size_t total = 0;
+    bool deflated = false;
+    auto p = storage.get();
+    auto first = p;
+    for(auto const& m0 : messages)
+    {
+        total += beast::buffer_bytes(detail::batch_payload(m0));
+        auto const& m = batch_select(m0);
+        auto const& payload = detail::batch_payload(m);
+        auto const n = beast::buffer_bytes(payload);
+        deflated = deflated || detail::batch_deflated(m);
+        auto const f = detail::batch_frame(m);
+        if(! mask && f.size() > 0)
+        {
+            if(p != first)
+                out.emplace_back(first, p - first);
+            out.push_back(f);
+            first = p;
+            continue;
+        }
+        fh.op = detail::batch_opcode(m, wr_opcode);
+        fh.rsv1 = detail::batch_deflated(m);
+        fh.len = n;
+        if(mask)
+            fh.key = create_mask();
+        detail::fh_buffer fb;
+        detail::write<flat_static_buffer_base>(fb, fh);
+        BOOST_ASSERT(fb.size() == header_size(n));
+        p += net::buffer_copy(
+            net::buffer(p, fb.size()), fb.data());
+        if(copied(n))
+        {
+            if(mask)
+            {
+                detail::prepared_key key;
+                detail::prepare_key(key, fh.key);
+                detail::mask_copy(net::buffer(p, n), payload, key);
+            }
+            else
+            {
+                net::buffer_copy(net::buffer(p, n), payload);
+            }
+            p += n;
+        }
+        else
+        {
+            if(p != first)
+                out.emplace_back(first, p - first);
+            for(net::const_buffer b : beast::buffers_range_ref(payload))
+                out.push_back(b);
+            first = p;
+        }
+    }
+    BOOST_ASSERT(static_cast<std::size_t>(p - storage.get()) == size);
+    if(p != first)
+        out.emplace_back(first, p - first);
+    // The receiver's window now holds data our compressor
+    // has not seen, so the next message starts without it.
+    if(deflated)
+        this->release_idle_pmd();
+    return total;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<class DynamicBuffer>
+bool
+stream<NextLayer, deflateSupported>::impl_type::
+read_buffered(DynamicBuffer& b, detail::opcode op)
+{
+    if( status_ != status::open || rd_close ||
+        ! rd_done || rd_remain != 0)
+        return false;
+    auto const in = rd_buf.data();
+    auto const p = static_cast<std::uint8_t const*>(in.data());
+    auto const n = in.size();
+    if(n < 2)
+        return false;
+    // fin set, reserved bits clear, same opcode
+    if(p[0] != (0x80 | static_cast<std::uint8_t>(op)))
+        return false;
+    std::size_t hs = 2;
+    std::uint64_t len = p[1] & 0x7f;
+    if(len == 126)
+    {
+        if(n < 4)
+            return false;
+        len = (std::uint64_t{p[2]} << 8) | p[3];
+        hs = 4;
+    }
+    else if(len == 127)
+    {
+        if(n < 10)
+            return false;
+        len = 0;
+        for(std::size_t i = 2; i < 10; ++i)
+            len = (len << 8) | p[i];
+        hs = 10;
+    }
+    detail::prepared_key key;
+    bool const mask = (p[1] & 0x80) != 0;
+    if(mask)
+    {
+        if(n < hs + 4)
+            return false;
+        std::uint32_t key_le;
+        std::memcpy(&key_le, p + hs, sizeof(key_le));
+        detail::prepare_key(key,
+            endian::little_to_native(key_le));
+        hs += 4;
+    }
+    if(len > n - hs || len > b.max_size() - b.size())
+        return false;
+    auto const size = static_cast<std::size_t>(len);
+
+    // Copy and validate the payload before anything is
+    // consumed, so a bad message can still fail the connection.
+    auto const mb = b.prepare(size);
+    net::buffer_copy(mb, net::const_buffer(p + hs, size));
+    if(mask)
+        detail::mask_inplace(mb, key);
+    if(op == detail::opcode::text)
+    {
+        detail::utf8_checker utf8;
+        if(! utf8.write(mb) || ! utf8.finish())
+            return false;
+    }
+    error_code ec;
+    if(! parse_fh(rd_fh, rd_buf, ec))
+        return false;
+    BOOST_ASSERT(rd_remain == len);
+    rd_buf.consume(size);
+    rd_remain = 0;
+    rd_size = len;
+    b.commit(size);
+    return true;
+}
+
 template<class NextLayer, bool deflateSupported>
 template<class DynamicBuffer>
 void
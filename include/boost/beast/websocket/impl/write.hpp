@@ -29,7 +29,10 @@
 #include <boost/config.hpp>
 #include <boost/throw_exception.hpp>
 #include <algorithm>
+#include <array>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -317,10 +320,8 @@ operator()(
             detail::write<flat_static_buffer_base>(
                 impl.wr_fb, fh_);
             n = clamp(remain_, impl.wr_buf_size);
-            net::buffer_copy(net::buffer(
-                impl.wr_buf.get(), n), cb_);
-            detail::mask_inplace(net::buffer(
-                impl.wr_buf.get(), n), key_);
+            detail::mask_copy(net::buffer(
+                impl.wr_buf.get(), n), cb_, key_);
             remain_ -= n;
             impl.wr_cont = ! fin_;
             // write frame header and some payload
@@ -354,10 +355,8 @@ operator()(
             {
                 cb_.consume(impl.wr_buf_size);
                 n = clamp(remain_, impl.wr_buf_size);
-                net::buffer_copy(net::buffer(
-                    impl.wr_buf.get(), n), cb_);
-                detail::mask_inplace(net::buffer(
-                    impl.wr_buf.get(), n), key_);
+                detail::mask_copy(net::buffer(
+                    impl.wr_buf.get(), n), cb_, key_);
                 remain_ -= n;
                 // write more payload
                 BOOST_ASIO_CORO_YIELD
@@ -401,10 +400,8 @@ operator()(
                 fh_.key = impl.create_mask();
                 fh_.fin = fin_ ? remain_ == 0 : false;
                 detail::prepare_key(key_, fh_.key);
-                net::buffer_copy(net::buffer(
-                    impl.wr_buf.get(), n), cb_);
-                detail::mask_inplace(net::buffer(
-                    impl.wr_buf.get(), n), key_);
+                detail::mask_copy(net::buffer(
+                    impl.wr_buf.get(), n), cb_, key_);
                 impl.wr_fb.clear();
                 detail::write<flat_static_buffer_base>(
                     impl.wr_fb, fh_);
@@ -537,7 +534,10 @@ operator()(
                 else
                 {
                     if(fh_.fin)
+                    {
                         impl.do_context_takeover_write(impl.role);
+                        impl.update_pmd_timer();
+                    }
                     goto upcall;
                 }
             }
@@ -699,7 +699,10 @@ write_some(bool fin,
             fh.rsv1 = false;
         }
         if(fh.fin)
+        {
             impl.do_context_takeover_write(impl.role);
+            impl.update_pmd_timer();
+        }
     }
     else if(! fh.mask)
     {
@@ -765,10 +768,9 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
+            detail::mask_copy(b, cb, key);
             cb.consume(n);
             remain -= n;
-            detail::mask_inplace(b, key);
             impl.wr_cont = ! fin;
             net::write(impl.stream(),
                 buffers_cat(fh_buf.data(), b), ec);
@@ -782,10 +784,9 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
+            detail::mask_copy(b, cb, key);
             cb.consume(n);
             remain -= n;
-            detail::mask_inplace(b, key);
             net::write(impl.stream(), b, ec);
             bytes_transferred += n;
             if(impl.check_stop_now(ec))
@@ -807,8 +808,7 @@ write_some(bool fin,
                 clamp(remain, impl.wr_buf_size);
             auto const b =
                 net::buffer(impl.wr_buf.get(), n);
-            net::buffer_copy(b, cb);
-            detail::mask_inplace(b, key);
+            detail::mask_copy(b, cb, key);
             fh.len = n;
             remain -= n;
             fh.fin = fin ? remain == 0 : false;
@@ -906,6 +906,363 @@ async_write(
             bs);
 }
 
+//------------------------------------------------------------------------------
+
+template<class NextLayer, bool deflateSupported>
+template<class Handler, class Messages>
+class stream<NextLayer, deflateSupported>::write_messages_op
+    : public beast::async_base<
+        Handler, beast::executor_type<stream>>
+    , public asio::coroutine
+{
+    boost::weak_ptr<impl_type> wp_;
+    Messages ms_;
+    std::unique_ptr<std::uint8_t[]> storage_;
+    std::vector<net::const_buffer> v_;
+    std::size_t bytes_transferred_ = 0;
+    std::size_t n_ = 0;
+    std::size_t i_ = 0;
+
+    // The messages are held by value, so they are
+    // found by position across moves of this object.
+    std::size_t
+    count() const
+    {
+        return static_cast<std::size_t>(
+            std::distance(ms_.begin(), ms_.end()));
+    }
+
+    typename Messages::value_type const&
+    at(std::size_t i) const
+    {
+        return *std::next(ms_.begin(), i);
+    }
+
+    // Send one message of a batch which can't go out in a
+    // single write, the same way the synchronous overload does.
+    template<class ConstBufferSequence>
+    void
+    write_one(
+        boost::shared_ptr<impl_type> const& sp,
+        ConstBufferSequence const& m)
+    {
+        write_some_op<write_messages_op, ConstBufferSequence>(
+            std::move(*this), sp, true, m);
+    }
+
+    // The stream never compresses a prepared message itself,
+    // see any_compressed, so a batch of them always goes out
+    // in one write with the cached compressed forms.
+    void
+    write_one(
+        boost::shared_ptr<impl_type> const&,
+        prepared_message const&)
+    {
+        BOOST_ASSERT(false);
+    }
+
+public:
+    static constexpr int id = 2; // for soft_mutex
+
+    template<class Handler_>
+    write_messages_op(
+        Handler_&& h,
+        boost::shared_ptr<impl_type> const& sp,
+        Messages const& ms)
+        : beast::async_base<Handler,
+            beast::executor_type<stream>>(
+                std::forward<Handler_>(h),
+                    sp->stream().get_executor())
+        , wp_(sp)
+        , ms_(ms)
+    {
+        BOOST_ASSERT(! sp->wr_cont);
+        (*this)({}, 0, false);
+    }
+
+    void operator()(
+        error_code ec = {},
+        std::size_t bytes_transferred = 0,
+        bool cont = true)
+    {
+        auto sp = wp_.lock();
+        if(! sp)
+        {
+            BOOST_BEAST_ASSIGN_EC(ec, net::error::operation_aborted);
+            bytes_transferred_ = 0;
+            return this->complete(cont, ec, bytes_transferred_);
+        }
+        auto& impl = *sp;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if(impl.any_compressed(ms_))
+            {
+                // Compressed messages are sent one
+                // at a time by the regular algorithm.
+                for(i_ = 0; i_ < count(); ++i_)
+                {
+                    BOOST_ASIO_CORO_YIELD
+                    {
+                        BOOST_ASIO_HANDLER_LOCATION((
+                            __FILE__, __LINE__,
+                            "websocket::async_write_messages"));
+
+                        write_one(sp, at(i_));
+                    }
+                    bytes_transferred_ += bytes_transferred;
+                    if(ec)
+                        break;
+                }
+                return this->complete(cont, ec, bytes_transferred_);
+            }
+
+            // Acquire the write lock
+            if(! impl.wr_block.try_lock(this))
+            {
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_write_messages"));
+
+                    this->set_allowed_cancellation(net::cancellation_type::all);
+                    impl.op_wr.emplace(std::move(*this),
+                                       net::cancellation_type::all);
+                }
+                if (ec)
+                    return this->complete(cont, ec, bytes_transferred_);
+
+                this->set_allowed_cancellation(net::cancellation_type::terminal);
+                impl.wr_block.lock(this);
+                BOOST_ASIO_CORO_YIELD
+                {
+                    BOOST_ASIO_HANDLER_LOCATION((
+                        __FILE__, __LINE__,
+                        "websocket::async_write_messages"));
+
+                    const auto ex = this->get_immediate_executor();
+                    net::dispatch(ex, std::move(*this));
+                }
+                BOOST_ASSERT(impl.wr_block.is_locked(this));
+            }
+            if(impl.check_stop_now(ec))
+                goto upcall;
+
+            // Send every frame with one gathered write
+            n_ = impl.frame_messages(ms_, storage_, v_);
+            BOOST_ASIO_CORO_YIELD
+            {
+                BOOST_ASIO_HANDLER_LOCATION((
+                    __FILE__, __LINE__,
+                    "websocket::async_write_messages"));
+
+                net::async_write(impl.stream(), v_,
+                    beast::detail::bind_continuation(std::move(*this)));
+            }
+            if(impl.check_stop_now(ec))
+                goto upcall;
+            bytes_transferred_ = n_;
+
+        upcall:
+            impl.wr_block.unlock(this);
+            impl.op_close.maybe_invoke()
+                || impl.op_idle_ping.maybe_invoke()
+                || impl.op_rd.maybe_invoke()
+                || impl.op_ping.maybe_invoke();
+            this->complete(cont, ec, bytes_transferred_);
+        }
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+struct stream<NextLayer, deflateSupported>::
+    run_write_messages_op
+{
+    boost::shared_ptr<impl_type> const& self;
+
+    using executor_type = typename stream::executor_type;
+
+    executor_type
+    get_executor() const noexcept
+    {
+        return self->stream().get_executor();
+    }
+
+    template<
+        class WriteHandler,
+        class Messages>
+    void
+    operator()(
+        WriteHandler&& h,
+        Messages const& ms)
+    {
+        // If you get an error on the following line it means
+        // that your handler does not meet the documented type
+        // requirements for the handler.
+
+        static_assert(
+            beast::detail::is_invocable<WriteHandler,
+                void(error_code, std::size_t)>::value,
+            "WriteHandler type requirements not met");
+
+        write_messages_op<
+            typename std::decay<WriteHandler>::type,
+            Messages>(
+                std::forward<WriteHandler>(h),
+                self,
+                ms);
+    }
+};
+
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequences>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_messages(ConstBufferSequences const& messages)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    static_assert(detail::is_batch_message<typename
+        ConstBufferSequences::value_type>::value,
+            "ConstBufferSequence type requirements not met");
+    error_code ec;
+    auto const bytes_transferred =
+        write_messages(messages, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return bytes_transferred;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequences>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_messages(
+    ConstBufferSequences const& messages, error_code& ec)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    static_assert(detail::is_batch_message<typename
+        ConstBufferSequences::value_type>::value,
+            "ConstBufferSequence type requirements not met");
+    auto& impl = *impl_;
+    ec = {};
+    if(impl.check_stop_now(ec))
+        return 0;
+    BOOST_ASSERT(! impl.wr_cont);
+    std::size_t bytes_transferred = 0;
+    if(impl.any_compressed(messages))
+    {
+        // Compressed messages are sent one at a time
+        // by the regular algorithm, as in write_messages_op.
+        for(auto const& m : messages)
+        {
+            bytes_transferred += write_one(m, ec);
+            if(ec)
+                break;
+        }
+        return bytes_transferred;
+    }
+    std::unique_ptr<std::uint8_t[]> storage;
+    std::vector<net::const_buffer> v;
+    auto const n = impl.frame_messages(messages, storage, v);
+    net::write(impl.stream(), v, ec);
+    if(impl.check_stop_now(ec))
+        return bytes_transferred;
+    return n;
+}
+
+// Send one message of a batch which can't go out in a
+// single write, the same way write_messages_op does.
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequence>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_one(
+    ConstBufferSequence const& message, error_code& ec)
+{
+    return write_some(true, message, ec);
+}
+
+// The stream never compresses a prepared message itself,
+// see any_compressed, so a batch of them always goes out
+// in one write with the cached compressed forms.
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write_one(
+    prepared_message const&, error_code&)
+{
+    BOOST_ASSERT(false);
+    return 0;
+}
+
+template<class NextLayer, bool deflateSupported>
+template<class ConstBufferSequences, BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+stream<NextLayer, deflateSupported>::
+async_write_messages(
+    ConstBufferSequences const& messages, WriteHandler&& handler)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    static_assert(detail::is_batch_message<typename
+        ConstBufferSequences::value_type>::value,
+            "ConstBufferSequence type requirements not met");
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            run_write_messages_op{impl_},
+            handler,
+            detail::message_range<typename
+                ConstBufferSequences::const_iterator>{
+                    messages.begin(), messages.end()});
+}
+
+//------------------------------------------------------------------------------
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write(prepared_message const& message)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    error_code ec;
+    auto const bytes_transferred = write(message, ec);
+    if(ec)
+        BOOST_THROW_EXCEPTION(system_error{ec});
+    return bytes_transferred;
+}
+
+template<class NextLayer, bool deflateSupported>
+std::size_t
+stream<NextLayer, deflateSupported>::
+write(prepared_message const& message, error_code& ec)
+{
+    static_assert(is_sync_stream<next_layer_type>::value,
+        "SyncStream type requirements not met");
+    std::array<prepared_message, 1> const messages{{message}};
+    return write_messages(messages, ec);
+}
+
+template<class NextLayer, bool deflateSupported>
+template<BOOST_BEAST_ASYNC_TPARAM2 WriteHandler>
+BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+stream<NextLayer, deflateSupported>::
+async_write(
+    prepared_message const& message, WriteHandler&& handler)
+{
+    static_assert(is_async_stream<next_layer_type>::value,
+        "AsyncStream type requirements not met");
+    return net::async_initiate<
+        WriteHandler,
+        void(error_code, std::size_t)>(
+            run_write_messages_op{impl_},
+            handler,
+            std::array<prepared_message, 1>{{message}});
+}
+
 } // websocket
 } // beast
 } // boost
@@ -11,6 +11,7 @@
 #define BOOST_BEAST_WEBSOCKET_OPTION_HPP
 
 #include <boost/beast/core/detail/config.hpp>
+#include <chrono>
 
 namespace boost {
 namespace beast {
@@ -63,6 +64,25 @@ struct permessage_deflate
 
     /// The minimum size a message should have to be compressed
     std::size_t msg_size_threshold = 0;
+
+    /** Time without an outgoing message after which the compressor is released
+
+        When this much time passes after a compressed message is
+        written, and no other message is written in between, the
+        stream gives its compressor back to the pool. The next
+        message is compressed without the previous context, which
+        a receiver must always accept. The decompressor is kept
+        while the peer takes over context, since the peer's next
+        message may refer to it.
+
+        The timer used for this runs when the stream's executor
+        is running. The default value, which is the largest
+        duration, disables the release.
+
+        @see get_deflate_pool_stats
+    */
+    std::chrono::steady_clock::duration idle_release =
+        (std::chrono::steady_clock::duration::max)();
 };
 
 } // websocket
@@ -0,0 +1,337 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_WEBSOCKET_PREPARED_MESSAGE_HPP
+#define BOOST_BEAST_WEBSOCKET_PREPARED_MESSAGE_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/flat_static_buffer.hpp>
+#include <boost/beast/websocket/detail/frame.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+namespace detail {
+class prepared_cache;
+template<bool deflateSupported>
+struct impl_base;
+} // detail
+
+/** A complete message framed once for sending to many streams.
+
+    Objects of this type hold the frame header and payload of one
+    unfragmented, uncompressed message in a single immutable
+    buffer. Copies share that buffer, so a message may be built
+    once and queued on any number of streams.
+
+    A stream in the server role sends the framed bytes as they
+    are, with no copy, framing or masking of its own. A stream in
+    the client role must mask every frame with a fresh key, so it
+    sends the payload as a regular message instead.
+
+    The message is sent as a single frame, regardless of the
+    @ref stream::auto_fragment setting.
+
+    When permessage-deflate is in use, the payload is compressed
+    without context, once for each combination of compression
+    level, window bits and memory level, and the result is kept
+    with the message. Every stream which negotiated the same
+    parameters then sends those compressed bytes, instead of
+    running its own compressor over the payload.
+
+    @par Example
+    @code
+    websocket::prepared_message const msg(net::buffer(s));
+    for(auto& ws : sessions)
+        ws.async_write(msg, handler);
+    @endcode
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe.
+*/
+class prepared_message
+{
+    template<bool>
+    friend struct detail::impl_base;
+
+    std::shared_ptr<std::uint8_t const> p_;
+    std::shared_ptr<detail::prepared_cache> z_; // compressed forms
+    std::size_t header_ = 0;
+    std::size_t size_ = 0;
+    bool binary_ = false;
+    bool deflated_ = false;
+
+    void
+    init_cache();
+
+public:
+    /// Constructor
+    prepared_message() = default;
+
+    /** Constructor
+
+        @param payload The payload of the message. It is copied.
+
+        @param binary `true` to send a binary message, or
+        `false` to send a text message.
+    */
+    template<class ConstBufferSequence>
+    explicit
+    prepared_message(
+        ConstBufferSequence const& payload,
+        bool binary = false)
+        : size_(buffer_bytes(payload))
+        , binary_(binary)
+    {
+        static_assert(net::is_const_buffer_sequence<
+            ConstBufferSequence>::value,
+                "ConstBufferSequence type requirements not met");
+        detail::frame_header fh;
+        fh.op = binary ?
+            detail::opcode::binary : detail::opcode::text;
+        fh.fin = true;
+        fh.rsv1 = false;
+        fh.rsv2 = false;
+        fh.rsv3 = false;
+        fh.len = size_;
+        fh.mask = false;
+        fh.key = 0;
+        detail::fh_buffer fb;
+        detail::write<flat_static_buffer_base>(fb, fh);
+        header_ = fb.size();
+        std::shared_ptr<std::uint8_t> p(
+            new std::uint8_t[header_ + size_],
+            std::default_delete<std::uint8_t[]>());
+        net::buffer_copy(
+            net::buffer(p.get(), header_), fb.data());
+        net::buffer_copy(
+            net::buffer(p.get() + header_, size_), payload);
+        p_ = std::move(p);
+        if(size_ > 0)
+            init_cache();
+    }
+
+    /// Returns `true` if this is a binary message
+    bool
+    binary() const noexcept
+    {
+        return binary_;
+    }
+
+    /// Returns `true` if the payload is compressed with permessage-deflate
+    bool
+    deflated() const noexcept
+    {
+        return deflated_;
+    }
+
+    /// Returns the size of the payload
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Returns the framed message, as sent by a server
+    net::const_buffer
+    data() const noexcept
+    {
+        return {p_.get(), header_ + size_};
+    }
+
+    /// Returns the payload
+    net::const_buffer
+    payload() const noexcept
+    {
+        return {p_.get() + header_, size_};
+    }
+};
+
+namespace detail {
+
+// The compressed forms of a prepared message, one for
+// each set of deflate parameters it was sent with
+class prepared_cache
+{
+    struct entry
+    {
+        int level;
+        int bits;
+        int mem;
+        prepared_message m;
+    };
+
+    std::mutex m_;
+    std::vector<entry> v_;
+
+public:
+    bool
+    find(int level, int bits, int mem, prepared_message& m)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        for(auto const& e : v_)
+        {
+            if( e.level == level &&
+                e.bits == bits &&
+                e.mem == mem)
+            {
+                m = e.m;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns the message which is kept, in case
+    // another thread inserted the same form first
+    prepared_message
+    insert(int level, int bits, int mem, prepared_message const& m)
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        for(auto const& e : v_)
+            if( e.level == level &&
+                e.bits == bits &&
+                e.mem == mem)
+                return e.m;
+        v_.push_back({level, bits, mem, m});
+        return m;
+    }
+};
+
+// These let a batch of messages hold either buffer
+// sequences or prepared messages.
+
+// A non-owning view of a range of messages
+template<class Iterator>
+struct message_range
+{
+    using const_iterator = Iterator;
+    using value_type = typename
+        std::iterator_traits<Iterator>::value_type;
+
+    Iterator first;
+    Iterator last;
+
+    Iterator
+    begin() const
+    {
+        return first;
+    }
+
+    Iterator
+    end() const
+    {
+        return last;
+    }
+};
+
+template<class ConstBufferSequence>
+ConstBufferSequence const&
+batch_payload(ConstBufferSequence const& m)
+{
+    return m;
+}
+
+inline
+net::const_buffer
+batch_payload(prepared_message const& m)
+{
+    return m.payload();
+}
+
+// Returns the framed bytes, if the message has them
+template<class ConstBufferSequence>
+net::const_buffer
+batch_frame(ConstBufferSequence const&)
+{
+    return {};
+}
+
+inline
+net::const_buffer
+batch_frame(prepared_message const& m)
+{
+    return m.data();
+}
+
+template<class ConstBufferSequence>
+opcode
+batch_opcode(ConstBufferSequence const&, opcode op)
+{
+    return op;
+}
+
+inline
+opcode
+batch_opcode(prepared_message const& m, opcode)
+{
+    return m.binary() ? opcode::binary : opcode::text;
+}
+
+template<class ConstBufferSequence>
+bool
+batch_deflated(ConstBufferSequence const&)
+{
+    return false;
+}
+
+inline
+bool
+batch_deflated(prepared_message const& m)
+{
+    return m.deflated();
+}
+
+// Returns `true` if the stream compresses the message
+// itself, which prevents sending the batch in one write
+template<class ConstBufferSequence>
+bool
+batch_compressible(ConstBufferSequence const&)
+{
+    return true;
+}
+
+inline
+bool
+batch_compressible(prepared_message const&)
+{
+    return false;
+}
+
+template<class T>
+using is_batch_message = std::integral_constant<bool,
+    net::is_const_buffer_sequence<T>::value ||
+    std::is_same<T, prepared_message>::value>;
+
+} // detail
+
+inline
+void
+prepared_message::
+init_cache()
+{
+    z_ = std::make_shared<detail::prepared_cache>();
+}
+
+} // websocket
+} // beast
+} // boost
+
+#endif
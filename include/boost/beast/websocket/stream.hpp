@@ -13,6 +13,7 @@
 #include <boost/beast/core/detail/config.hpp>
 #include <boost/beast/websocket/error.hpp>
 #include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/prepared_message.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/beast/websocket/stream_fwd.hpp>
@@ -34,6 +35,7 @@
 #include <memory>
 #include <type_traits>
 #include <random>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -606,6 +608,44 @@ public:
     void
     secure_prng(bool value);
 
+    /** Set the read buffer size option.
+
+        Sets the largest size of the buffer used by the implementation
+        to read frames. Frame headers, control frames and compressed
+        payloads are read through this buffer, as are payloads when
+        the caller's buffer is smaller than this one.
+
+        The buffer starts at 1536 bytes, the size of a typical TCP
+        frame. When a read fills the space offered, the next read
+        offers twice as much, up to this limit. When reads return less,
+        the size offered decays back to 1536 bytes, and storage larger
+        than the size offered is released once the buffer is empty.
+        The size offered only decays as reads arrive, so a stream
+        which goes idle after a large read keeps a buffer of that
+        size until its next reads return less.
+
+        Raising the limit reduces the number of calls made to the next
+        layer to read large compressed messages or many small frames.
+
+        The default setting is 1536, which keeps the buffer at a fixed
+        size. The minimum value is 1536. The option should not be
+        changed while a read operation is outstanding.
+
+        @par Example
+        Setting the read buffer limit.
+        @code
+            ws.read_buffer_bytes(65536);
+        @endcode
+
+        @param amount The largest size of the read buffer in bytes.
+    */
+    void
+    read_buffer_bytes(std::size_t amount);
+
+    /// Returns the largest size of the read buffer.
+    std::size_t
+    read_buffer_bytes() const;
+
     /** Set the write buffer size option.
 
         Sets the size of the write buffer used by the implementation to
@@ -2151,6 +2191,131 @@ public:
 
     //--------------------------------------------------------------------------
 
+    /** Read one or more complete messages.
+
+        This function reads a complete message into the first buffer
+        in the same way as @ref read. Then, each further complete
+        message already received into the stream's read buffer is
+        appended to the next buffer, without performing any I/O, until
+        every buffer holds a message or no such message remains.
+
+        A buffered message is delivered this way only if it consists
+        of a single uncompressed frame of the same type as the first
+        message, so @ref got_binary and @ref got_text describe every
+        message in the batch. Other frames, including control frames,
+        are left in the read buffer for the next read operation, which
+        handles them in the usual way.
+
+        This reduces the cost per message when many small messages
+        arrive together. Raising @ref read_buffer_bytes lets more
+        messages arrive in each read from the next layer.
+
+        @return The number of messages read, which is at least one
+        unless an error occurs.
+
+        @param buffers The dynamic buffers to append messages to,
+        one message per buffer. This vector may not be empty.
+
+        @throws system_error Thrown on failure.
+    */
+    template<class DynamicBuffer, class Allocator>
+    std::size_t
+    read_messages(std::vector<DynamicBuffer, Allocator>& buffers);
+
+    /** Read one or more complete messages.
+
+        This function reads a complete message into the first buffer
+        in the same way as @ref read. Then, each further complete
+        message already received into the stream's read buffer is
+        appended to the next buffer, without performing any I/O, until
+        every buffer holds a message or no such message remains.
+
+        A buffered message is delivered this way only if it consists
+        of a single uncompressed frame of the same type as the first
+        message, so @ref got_binary and @ref got_text describe every
+        message in the batch. Other frames, including control frames,
+        are left in the read buffer for the next read operation, which
+        handles them in the usual way.
+
+        @return The number of messages read, which is at least one
+        unless an error occurs.
+
+        @param buffers The dynamic buffers to append messages to,
+        one message per buffer. This vector may not be empty.
+
+        @param ec Set to indicate what error occurred, if any.
+    */
+    template<class DynamicBuffer, class Allocator>
+    std::size_t
+    read_messages(
+        std::vector<DynamicBuffer, Allocator>& buffers,
+        error_code& ec);
+
+    /** Read one or more complete messages asynchronously.
+
+        This function reads a complete message into the first buffer
+        in the same way as @ref async_read. Then, each further complete
+        message already received into the stream's read buffer is
+        appended to the next buffer, without performing any I/O, until
+        every buffer holds a message or no such message remains. All
+        of these messages are delivered by a single invocation of the
+        completion handler.
+
+        A buffered message is delivered this way only if it consists
+        of a single uncompressed frame of the same type as the first
+        message, so @ref got_binary and @ref got_text describe every
+        message in the batch. Other frames, including control frames,
+        are left in the read buffer for the next read operation, which
+        handles them in the usual way.
+
+        The program must ensure that no other calls to @ref read,
+        @ref read_some, @ref async_read, or @ref async_read_some
+        are performed until this operation completes.
+
+        @param buffers The dynamic buffers to append messages to,
+        one message per buffer. This vector may not be empty. The
+        caller retains ownership of the vector, which must remain
+        valid, and must not be resized, until the completion handler
+        is called.
+
+        @param handler The completion handler to invoke when the operation
+        completes. The implementation takes ownership of the handler by
+        performing a decay-copy. The equivalent function signature of
+        the handler must be:
+        @code
+        void handler(
+            error_code const& ec,       // Result of operation
+            std::size_t messages        // Number of buffers filled
+        );
+        @endcode
+        If the handler has an associated immediate executor,
+        an immediate completion will be dispatched to it.
+        Otherwise, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed
+        by dispatching to the immediate executor. If no
+        immediate executor is specified, this is equivalent
+        to using `net::post`.
+
+        @par Per-Operation Cancellation
+
+        This asynchronous operation supports the same cancellation
+        types as @ref async_read.
+    */
+    template<
+        class DynamicBuffer,
+        class Allocator,
+        BOOST_BEAST_ASYNC_TPARAM2 ReadHandler =
+            net::default_completion_token_t<
+                executor_type>>
+    BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
+    async_read_messages(
+        std::vector<DynamicBuffer, Allocator>& buffers,
+        ReadHandler&& handler =
+            net::default_completion_token_t<
+                executor_type>{});
+
+    //--------------------------------------------------------------------------
+
     /** Read some message data.
 
         This function is used to read some message data.
@@ -2699,6 +2864,221 @@ public:
             net::default_completion_token_t<
                 executor_type>{});
 
+    /** Write several complete messages.
+
+        This function sends each element of `messages` as a complete
+        message, framing them all into a single write to the next layer.
+
+        The current setting of the @ref binary option controls
+        whether the message opcodes are set to text or binary. Each
+        message is sent as one frame regardless of the
+        @ref auto_fragment option. Frame headers, and payloads which
+        are masked or smaller than a TCP frame, are copied into one
+        buffer, while larger payloads are sent from the caller's
+        buffers. If any message would be compressed, the messages are
+        instead written one at a time as if by calling @ref write.
+
+        This should not be called while a message started with
+        @ref write_some is incomplete.
+
+        @param messages A range of buffer sequences, each holding the
+        entire payload of one message, such as
+        `std::vector<net::const_buffer>`, or a range of
+        @ref prepared_message.
+
+        @return The number of bytes sent from the buffers.
+
+        @throws system_error Thrown on failure.
+    */
+    template<class ConstBufferSequences>
+    std::size_t
+    write_messages(ConstBufferSequences const& messages);
+
+    /** Write several complete messages.
+
+        This function sends each element of `messages` as a complete
+        message, framing them all into a single write to the next layer.
+
+        The current setting of the @ref binary option controls
+        whether the message opcodes are set to text or binary. Each
+        message is sent as one frame regardless of the
+        @ref auto_fragment option. Frame headers, and payloads which
+        are masked or smaller than a TCP frame, are copied into one
+        buffer, while larger payloads are sent from the caller's
+        buffers. If any message would be compressed, the messages are
+        instead written one at a time as if by calling @ref write.
+
+        This should not be called while a message started with
+        @ref write_some is incomplete.
+
+        @param messages A range of buffer sequences, each holding the
+        entire payload of one message, such as
+        `std::vector<net::const_buffer>`, or a range of
+        @ref prepared_message.
+
+        @param ec Set to indicate what error occurred, if any.
+
+        @return The number of bytes sent from the buffers.
+    */
+    template<class ConstBufferSequences>
+    std::size_t
+    write_messages(
+        ConstBufferSequences const& messages,
+        error_code& ec);
+
+    /** Write several complete messages asynchronously.
+
+        This function sends each element of `messages` as a complete
+        message, framing them all into a single gathered write to the
+        next layer. Compared to calling @ref async_write for each
+        message, the write lock is acquired once and the next layer
+        sees one write, which is considerably cheaper for many small
+        messages such as those queued by a broadcasting server.
+
+        The current setting of the @ref binary option controls
+        whether the message opcodes are set to text or binary. Each
+        message is sent as one frame regardless of the
+        @ref auto_fragment option. Frame headers, and payloads which
+        are masked or smaller than a TCP frame, are copied into one
+        buffer, while larger payloads are sent from the caller's
+        buffers. If any message would be compressed, the messages are
+        instead written one at a time as if by calling @ref async_write.
+
+        The program must ensure that no other calls to @ref write,
+        @ref write_some, @ref async_write, or @ref async_write_some
+        are performed until this operation completes, and that no
+        message started with @ref async_write_some is incomplete.
+
+        @param messages A range of buffer sequences, each holding the
+        entire payload of one message, such as
+        `std::vector<net::const_buffer>`, or a range of
+        @ref prepared_message. The caller retains ownership
+        of the range and of the memory it refers to, which must
+        remain valid and unchanged until the completion handler is
+        called.
+
+        @param handler The completion handler to invoke when the operation
+        completes. The implementation takes ownership of the handler by
+        performing a decay-copy. The equivalent function signature of
+        the handler must be:
+        @code
+        void handler(
+            error_code const& ec,           // Result of operation
+            std::size_t bytes_transferred   // Number of bytes sent from the
+                                            // buffers. If an error occurred,
+                                            // this may be zero.
+        );
+        @endcode
+        If the handler has an associated immediate executor,
+        an immediate completion will be dispatched to it.
+        Otherwise, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed
+        by dispatching to the immediate executor. If no
+        immediate executor is specified, this is equivalent
+        to using `net::post`.
+
+        @par Per-Operation Cancellation
+
+        This asynchronous operation supports the same cancellation
+        types as @ref async_write.
+    */
+    template<
+        class ConstBufferSequences,
+        BOOST_BEAST_ASYNC_TPARAM2 WriteHandler =
+            net::default_completion_token_t<
+                executor_type>>
+    BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+    async_write_messages(
+        ConstBufferSequences const& messages,
+        WriteHandler&& handler =
+            net::default_completion_token_t<
+                executor_type>{});
+
+    /** Write a prepared message.
+
+        This function sends a message which was framed in advance.
+        A stream in the server role writes the framed bytes as they
+        are. A stream in the client role sends the payload as a
+        regular message, with the type recorded in the message.
+
+        This should not be called while a message started with
+        @ref write_some is incomplete.
+
+        @param message The message to send.
+
+        @return The number of payload bytes sent.
+
+        @throws system_error Thrown on failure.
+    */
+    std::size_t
+    write(prepared_message const& message);
+
+    /** Write a prepared message.
+
+        This function sends a message which was framed in advance.
+        A stream in the server role writes the framed bytes as they
+        are. A stream in the client role sends the payload as a
+        regular message, with the type recorded in the message.
+
+        This should not be called while a message started with
+        @ref write_some is incomplete.
+
+        @param message The message to send.
+
+        @param ec Set to indicate what error occurred, if any.
+
+        @return The number of payload bytes sent.
+    */
+    std::size_t
+    write(prepared_message const& message, error_code& ec);
+
+    /** Write a prepared message asynchronously.
+
+        This function sends a message which was framed in advance.
+        A stream in the server role writes the framed bytes as they
+        are, so one message may be sent to many streams for the
+        cost of a single encoding. A stream in the client role
+        sends the payload as a regular message, with the type
+        recorded in the message.
+
+        The program must ensure that no other calls to @ref write,
+        @ref write_some, @ref async_write, or @ref async_write_some
+        are performed until this operation completes, and that no
+        message started with @ref async_write_some is incomplete.
+
+        @param message The message to send. The implementation
+        holds a copy, which shares the framed bytes, until the
+        operation completes.
+
+        @param handler The completion handler to invoke when the operation
+        completes. The implementation takes ownership of the handler by
+        performing a decay-copy. The equivalent function signature of
+        the handler must be:
+        @code
+        void handler(
+            error_code const& ec,           // Result of operation
+            std::size_t bytes_transferred   // Number of payload bytes sent
+        );
+        @endcode
+        If the handler has an associated immediate executor,
+        an immediate completion will be dispatched to it.
+        Otherwise, the handler will not be invoked from within
+        this function. Invocation of the handler will be performed
+        by dispatching to the immediate executor. If no
+        immediate executor is specified, this is equivalent
+        to using `net::post`.
+    */
+    template<
+        BOOST_BEAST_ASYNC_TPARAM2 WriteHandler =
+            net::default_completion_token_t<
+                executor_type>>
+    BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+    async_write(
+        prepared_message const& message,
+        WriteHandler&& handler =
+            net::default_completion_token_t<
+                executor_type>{});
+
     /** Write some message data.
 
         This function is used to send part of a message.
@@ -2859,9 +3239,11 @@ private:
     template<class>         class idle_ping_op;
     template<class, class>  class read_some_op;
     template<class, class>  class read_op;
+    template<class, class>  class read_messages_op;
     template<class>         class response_op;
     template<class, class>  class write_some_op;
     template<class, class>  class write_op;
+    template<class, class>  class write_messages_op;
 
     struct run_accept_op;
     struct run_close_op;
@@ -2870,9 +3252,11 @@ private:
     struct run_idle_ping_op;
     struct run_read_some_op;
     struct run_read_op;
+    struct run_read_messages_op;
     struct run_response_op;
     struct run_write_some_op;
     struct run_write_op;
+    struct run_write_messages_op;
 
     static void default_decorate_req(request_type&) {}
     static void default_decorate_res(response_type&) {}
@@ -2905,6 +3289,21 @@ private:
             RequestDecorator const& decorator,
                 error_code& ec);
 
+    //
+    // write
+    //
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_one(
+        ConstBufferSequence const& message,
+        error_code& ec);
+
+    std::size_t
+    write_one(
+        prepared_message const& message,
+        error_code& ec);
+
     //
     // fail
     //
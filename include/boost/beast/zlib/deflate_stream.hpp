@@ -55,6 +55,10 @@ namespace zlib {
 /** Raw deflate compressor.
 
     This is a port of zlib's "deflate" functionality to C++.
+    By default the output is raw deflate data; the stream can
+    also be reset to produce the zlib or gzip format.
+
+    @see Format
 */
 class deflate_stream
     : private detail::deflate_stream
@@ -73,6 +77,8 @@ public:
 
         @li `strategy = Strategy::normal`
 
+        @li `format = Format::raw`
+
         Although the stream is ready to be used immediately
         after construction, any required internal buffers are
         not dynamically allocated until needed.
@@ -111,7 +117,47 @@ public:
         int memLevel,
         Strategy strategy)
     {
-        doReset(level, windowBits, memLevel, strategy);
+        doReset(level, windowBits,
+            memLevel, strategy, Format::raw);
+    }
+
+    /** Reset the stream, compression settings and format.
+
+        This function initializes the stream to the specified
+        compression settings. With @ref Format::zlib or
+        @ref Format::gzip, the output starts with the header
+        of that format, and the trailer holding the checksum of
+        the input is written when `write` is called with
+        `Flush::finish`.
+
+        Although the stream is ready to be used immediately
+        after a reset, any required internal buffers are not
+        dynamically allocated until needed.
+
+        @param level Compression level from 0 to 9.
+
+        @param windowBits The base two logarithm of the window size, or the
+        history buffer. It should be in the range 9..15.
+
+        @param memLevel How much memory should be allocated for the internal
+        compression state, with level from from 1 to 9.
+
+        @param strategy Strategy to tune the compression algorithm.
+
+        @param format The framing to put around the compressed data.
+
+        @note Any unprocessed input or pending output from
+        previous calls are discarded.
+    */
+    void
+    reset(
+        int level,
+        int windowBits,
+        int memLevel,
+        Strategy strategy,
+        Format format)
+    {
+        doReset(level, windowBits, memLevel, strategy, format);
     }
 
     /** Reset the stream without deallocating memory.
@@ -148,7 +194,7 @@ public:
 
         This function makes a conservative estimate of the maximum number
         of bytes needed to store the result of compressing a block of
-        data based on the current compression level and strategy.
+        data based on the current compression level, strategy and format.
 
         @param sourceLen The size of the uncompressed data.
 
@@ -269,7 +315,9 @@ public:
         `zs.avail_out`) but no more input data, until it returns the
         error `error::end_of_stream` or another error. After `write` has
         returned the `error::end_of_stream` error, the only possible
-        operations on the stream are to reset or destroy.
+        operations on the stream are to reset or destroy. For the zlib
+        and gzip formats, the trailer is part of the output produced
+        before `error::end_of_stream` is returned.
 
         `Flush::finish` can be used immediately after initialization
         if all the compression is to be done in a single step. In this
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_ZLIB_DETAIL_ADLER32_IPP
+#define BOOST_BEAST_ZLIB_DETAIL_ADLER32_IPP
+
+#include <boost/beast/zlib/detail/adler32.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <algorithm>
+
+namespace boost {
+namespace beast {
+namespace zlib {
+namespace detail {
+
+// largest prime smaller than 65536
+std::uint32_t constexpr adler32_base = 65521;
+
+// largest n such that 255n(n+1)/2 + (n+1)(base-1) <= 2^32-1,
+// the number of bytes which can be summed before reducing
+std::size_t constexpr adler32_nmax = 5552;
+
+inline
+std::uint32_t
+adler32_scalar(
+    std::uint32_t adler,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    std::uint32_t s1 = adler & 0xffff;
+    std::uint32_t s2 = adler >> 16;
+    while(n > 0)
+    {
+        auto k = (std::min)(n, adler32_nmax);
+        n -= k;
+        for(; k >= 8; k -= 8)
+        {
+            s1 += p[0]; s2 += s1;
+            s1 += p[1]; s2 += s1;
+            s1 += p[2]; s2 += s1;
+            s1 += p[3]; s2 += s1;
+            s1 += p[4]; s2 += s1;
+            s1 += p[5]; s2 += s1;
+            s1 += p[6]; s2 += s1;
+            s1 += p[7]; s2 += s1;
+            p += 8;
+        }
+        for(; k > 0; --k)
+        {
+            s1 += *p++;
+            s2 += s1;
+        }
+        s1 %= adler32_base;
+        s2 %= adler32_base;
+    }
+    return (s2 << 16) | s1;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+/*  The vector kernels sum 32-byte blocks. For a block of
+    bytes c[0..31], s1 grows by the sum of c[i] and s2 grows
+    by 32 times the old s1 plus the sum of (32-i)*c[i]. The
+    byte sums come from psadbw, the weighted sums from pmaddubsw,
+    and the 32*s1 terms are collected in ps and added at the
+    end of each run of at most nmax bytes. Both require n to
+    be a multiple of 32.
+*/
+
+BOOST_BEAST_TARGET_SSE42
+inline
+std::uint32_t
+adler32_hsum(__m128i v) noexcept
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return static_cast<std::uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+BOOST_BEAST_TARGET_SSE42
+inline
+std::uint32_t
+adler32_sse42(
+    std::uint32_t adler,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    __m128i const tap1 = _mm_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    __m128i const tap2 = _mm_setr_epi8(
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const ones = _mm_set1_epi16(1);
+
+    std::uint32_t s1 = adler & 0xffff;
+    std::uint32_t s2 = adler >> 16;
+    auto blocks = n / 32;
+    while(blocks > 0)
+    {
+        auto k = (std::min)(blocks, adler32_nmax / 32);
+        blocks -= k;
+        auto v_ps = _mm_cvtsi32_si128(static_cast<int>(s1 * k));
+        auto v_s2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+        auto v_s1 = zero;
+        do
+        {
+            auto const b1 = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(p));
+            auto const b2 = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(p + 16));
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(b1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(
+                _mm_maddubs_epi16(b1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(b2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(
+                _mm_maddubs_epi16(b2, tap2), ones));
+            p += 32;
+        }
+        while(--k);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+        s1 += adler32_hsum(v_s1);
+        s2 = adler32_hsum(v_s2);
+        s1 %= adler32_base;
+        s2 %= adler32_base;
+    }
+    return (s2 << 16) | s1;
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+std::uint32_t
+adler32_hsum(__m256i v) noexcept
+{
+    auto x = _mm_add_epi32(
+        _mm256_castsi256_si128(v),
+        _mm256_extracti128_si256(v, 1));
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    return static_cast<std::uint32_t>(_mm_cvtsi128_si32(x));
+}
+
+BOOST_BEAST_TARGET_AVX2
+inline
+std::uint32_t
+adler32_avx2(
+    std::uint32_t adler,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    __m256i const tap = _mm256_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const ones = _mm256_set1_epi16(1);
+
+    std::uint32_t s1 = adler & 0xffff;
+    std::uint32_t s2 = adler >> 16;
+    auto blocks = n / 32;
+    while(blocks > 0)
+    {
+        auto k = (std::min)(blocks, adler32_nmax / 32);
+        blocks -= k;
+        auto v_ps = _mm256_setr_epi32(
+            static_cast<int>(s1 * k), 0, 0, 0, 0, 0, 0, 0);
+        auto v_s2 = _mm256_setr_epi32(
+            static_cast<int>(s2), 0, 0, 0, 0, 0, 0, 0);
+        auto v_s1 = zero;
+        do
+        {
+            auto const b = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(p));
+            v_ps = _mm256_add_epi32(v_ps, v_s1);
+            v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(b, zero));
+            v_s2 = _mm256_add_epi32(v_s2, _mm256_madd_epi16(
+                _mm256_maddubs_epi16(b, tap), ones));
+            p += 32;
+        }
+        while(--k);
+        v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+        s1 += adler32_hsum(v_s1);
+        s2 = adler32_hsum(v_s2);
+        s1 %= adler32_base;
+        s2 %= adler32_base;
+    }
+    return (s2 << 16) | s1;
+}
+
+#endif
+
+using adler32_fn = std::uint32_t(*)(
+    std::uint32_t, unsigned char const*, std::size_t);
+
+inline
+adler32_fn
+select_adler32()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.avx2)
+        return &adler32_avx2;
+    if(ci.sse42)
+        return &adler32_sse42;
+#endif
+    return nullptr;
+}
+
+std::uint32_t
+adler32(
+    std::uint32_t adler,
+    void const* data,
+    std::size_t size) noexcept
+{
+    auto p = static_cast<unsigned char const*>(data);
+    if(size >= 64)
+    {
+        static adler32_fn const fn = select_adler32();
+        if(fn)
+        {
+            auto const n = size & ~std::size_t{31};
+            adler = fn(adler, p, n);
+            p += n;
+            size -= n;
+        }
+    }
+    return adler32_scalar(adler, p, size);
+}
+
+} // detail
+} // zlib
+} // beast
+} // boost
+
+#endif
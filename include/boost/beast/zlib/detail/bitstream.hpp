@@ -38,7 +38,9 @@
 #define BOOST_BEAST_ZLIB_DETAIL_BITSTREAM_HPP
 
 #include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 
 namespace boost {
@@ -48,7 +50,7 @@ namespace detail {
 
 class bitstream
 {
-    using value_type = std::uint32_t;
+    using value_type = std::uint64_t;
 
     value_type v_ = 0;
     unsigned n_ = 0;
@@ -100,6 +102,12 @@ public:
     void
     fill_16(FwdIt& it);
 
+    // fill to at least 56 bits with one 8 byte load, unchecked.
+    // Bits above size() may be set afterwards; they hold the
+    // start of the next byte, and are cleared by rewind.
+    void
+    fill_fast(std::uint8_t const*& it);
+
     // return n bits
     template<class Unsigned>
     void
@@ -158,6 +166,19 @@ fill_16(FwdIt& it)
     n_ += 8;
 }
 
+inline
+void
+bitstream::
+fill_fast(std::uint8_t const*& it)
+{
+    BOOST_ASSERT(n_ < 64);
+    value_type v;
+    std::memcpy(&v, it, sizeof(v));
+    v_ |= endian::little_to_native(v) << n_;
+    it += 7 - (n_ >> 3);
+    n_ |= 56;
+}
+
 template<class Unsigned>
 void
 bitstream::
@@ -190,7 +211,7 @@ rewind(BidirIt& it)
     auto len = n_ >> 3;
     it = std::prev(it, len);
     n_ &= 7;
-    v_ &= (1U << n_) - 1;
+    v_ &= (value_type{1} << n_) - 1;
 }
 
 } // detail
@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_ZLIB_DETAIL_CRC32_HPP
+#define BOOST_BEAST_ZLIB_DETAIL_CRC32_HPP
+
+#include <boost/beast/core/detail/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace beast {
+namespace zlib {
+namespace detail {
+
+// Update a running CRC-32 (rfc1952) with the bytes
+// in the buffer. The CRC of no bytes is zero.
+//
+BOOST_BEAST_DECL
+std::uint32_t
+crc32(
+    std::uint32_t crc,
+    void const* data,
+    std::size_t size) noexcept;
+
+} // detail
+} // zlib
+} // beast
+} // boost
+
+#ifdef BOOST_BEAST_HEADER_ONLY
+#include <boost/beast/zlib/detail/crc32.ipp>
+#endif
+
+#endif
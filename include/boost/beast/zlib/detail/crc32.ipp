@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#ifndef BOOST_BEAST_ZLIB_DETAIL_CRC32_IPP
+#define BOOST_BEAST_ZLIB_DETAIL_CRC32_IPP
+
+#include <boost/beast/zlib/detail/crc32.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+
+namespace boost {
+namespace beast {
+namespace zlib {
+namespace detail {
+
+// Tables for the reflected polynomial 0xedb88320.
+// t[k][i] is the CRC of byte i followed by k zero bytes,
+// which lets eight bytes be folded in per step.
+struct crc32_tables
+{
+    std::uint32_t t[8][256];
+
+    crc32_tables() noexcept
+    {
+        for(std::uint32_t i = 0; i < 256; ++i)
+        {
+            auto c = i;
+            for(int k = 0; k < 8; ++k)
+                c = (c & 1) ? (c >> 1) ^ 0xedb88320 : c >> 1;
+            t[0][i] = c;
+        }
+        for(std::uint32_t i = 0; i < 256; ++i)
+            for(int k = 1; k < 8; ++k)
+                t[k][i] = (t[k - 1][i] >> 8) ^
+                    t[0][t[k - 1][i] & 0xff];
+    }
+};
+
+inline
+crc32_tables const&
+get_crc32_tables() noexcept
+{
+    static crc32_tables const tables;
+    return tables;
+}
+
+inline
+std::uint32_t
+load_le32(unsigned char const* p) noexcept
+{
+    return
+        static_cast<std::uint32_t>(p[0]) |
+        (static_cast<std::uint32_t>(p[1]) << 8) |
+        (static_cast<std::uint32_t>(p[2]) << 16) |
+        (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+// Slicing-by-8, on the inverted CRC
+inline
+std::uint32_t
+crc32_scalar(
+    std::uint32_t crc,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    auto const& t = get_crc32_tables().t;
+    while(n >= 8)
+    {
+        auto const lo = load_le32(p) ^ crc;
+        auto const hi = load_le32(p + 4);
+        crc =
+            t[7][lo & 0xff] ^
+            t[6][(lo >> 8) & 0xff] ^
+            t[5][(lo >> 16) & 0xff] ^
+            t[4][lo >> 24] ^
+            t[3][hi & 0xff] ^
+            t[2][(hi >> 8) & 0xff] ^
+            t[1][(hi >> 16) & 0xff] ^
+            t[0][hi >> 24];
+        p += 8;
+        n -= 8;
+    }
+    while(n--)
+        crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+#if ! BOOST_BEAST_NO_INTRINSICS
+
+BOOST_BEAST_TARGET_PCLMUL
+inline
+__m128i
+crc32_load(unsigned char const* p) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+}
+
+// Fold x forward over the distance given by k, into y
+BOOST_BEAST_TARGET_PCLMUL
+inline
+__m128i
+crc32_fold(__m128i x, __m128i k, __m128i y) noexcept
+{
+    auto const lo = _mm_clmulepi64_si128(x, k, 0x00);
+    auto const hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), y);
+}
+
+/*  Folding with carry-less multiplication, from "Fast CRC
+    Computation for Generic Polynomials Using PCLMULQDQ
+    Instruction" (Gopal et al., Intel, 2009).
+
+    Four 128-bit lanes are folded forward 64 bytes at a time,
+    then into one lane, which is reduced to 32 bits with a
+    Barrett reduction. The constants are x^k mod P(x) for the
+    reflected gzip polynomial. Requires n >= 64 and a multiple
+    of 16; works on the inverted CRC.
+*/
+BOOST_BEAST_TARGET_PCLMUL
+inline
+std::uint32_t
+crc32_pclmul(
+    std::uint32_t crc,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    __m128i const k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    __m128i const k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    __m128i const k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+    __m128i const poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    __m128i const mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+    auto x1 = _mm_xor_si128(crc32_load(p),
+        _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x2 = crc32_load(p + 16);
+    auto x3 = crc32_load(p + 32);
+    auto x4 = crc32_load(p + 48);
+    p += 64;
+    n -= 64;
+
+    while(n >= 64)
+    {
+        x1 = crc32_fold(x1, k1k2, crc32_load(p));
+        x2 = crc32_fold(x2, k1k2, crc32_load(p + 16));
+        x3 = crc32_fold(x3, k1k2, crc32_load(p + 32));
+        x4 = crc32_fold(x4, k1k2, crc32_load(p + 48));
+        p += 64;
+        n -= 64;
+    }
+
+    x1 = crc32_fold(x1, k3k4, x2);
+    x1 = crc32_fold(x1, k3k4, x3);
+    x1 = crc32_fold(x1, k3k4, x4);
+    while(n >= 16)
+    {
+        x1 = crc32_fold(x1, k3k4, crc32_load(p));
+        p += 16;
+        n -= 16;
+    }
+
+    // 128 to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+#endif
+
+using crc32_fn = std::uint32_t(*)(
+    std::uint32_t, unsigned char const*, std::size_t);
+
+inline
+crc32_fn
+select_crc32()
+{
+#if ! BOOST_BEAST_NO_INTRINSICS
+    auto const& ci = beast::detail::get_cpu_info();
+    if(ci.sse42 && ci.pclmul)
+        return &crc32_pclmul;
+#endif
+    return nullptr;
+}
+
+std::uint32_t
+crc32(
+    std::uint32_t crc,
+    void const* data,
+    std::size_t size) noexcept
+{
+    auto p = static_cast<unsigned char const*>(data);
+    crc = ~crc;
+    if(size >= 64)
+    {
+        static crc32_fn const fn = select_crc32();
+        if(fn)
+        {
+            auto const n = size & ~std::size_t{15};
+            crc = fn(crc, p, n);
+            p += n;
+            size -= n;
+        }
+    }
+    return ~crc32_scalar(crc, p, size);
+}
+
+} // detail
+} // zlib
+} // beast
+} // boost
+
+#endif
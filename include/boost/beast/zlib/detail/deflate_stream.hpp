@@ -39,9 +39,13 @@
 
 #include <boost/beast/zlib/error.hpp>
 #include <boost/beast/zlib/zlib.hpp>
+#include <boost/beast/zlib/detail/adler32.hpp>
+#include <boost/beast/zlib/detail/crc32.hpp>
 #include <boost/beast/zlib/detail/ranges.hpp>
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/optional.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstdint>
@@ -114,7 +118,7 @@ protected:
 
     /*  Note: the deflate() code requires max_lazy >= minMatch and max_chain >= 4
         For deflate_fast() (levels <= 3) good is ignored and lazy has a different
-        meaning.
+        meaning. deflate_quick() (level 1) uses none of the values.
     */
 
     // maximum heap size
@@ -337,6 +341,11 @@ protected:
     int level_;                     // compression level (1..9)
     Strategy strategy_;             // favor or force Huffman coding
 
+    Format format_ = Format::raw;   // header and trailer to write
+    std::uint32_t check_;           // adler32 or crc32 of the input so far
+    std::uint32_t total_;           // input size modulo 2^32, for gzip
+    bool trailer_;                  // true once the trailer is written
+
     // Use a faster search when the previous match is longer than this
     uInt good_match_;
 
@@ -497,6 +506,44 @@ protected:
         h = ((h << hash_shift_) ^ c) & hash_mask_;
     }
 
+    /*  Hash the four bytes at p. This is used by deflate_quick,
+        which looks each string up once instead of keeping a
+        running hash.
+    */
+    uInt
+    hash4(Byte const* p) const
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return static_cast<uInt>(
+            (endian::little_to_native(v) * 2654435761U) >>
+                (32 - hash_bits_));
+    }
+
+    /*  Return the number of leading bytes, up to n, which are
+        equal in a and b. Eight bytes are compared at a time.
+    */
+    static
+    unsigned
+    compare(Byte const* a, Byte const* b, unsigned n)
+    {
+        unsigned len = 0;
+        while(n - len >= 8)
+        {
+            std::uint64_t va;
+            std::uint64_t vb;
+            std::memcpy(&va, a + len, sizeof(va));
+            std::memcpy(&vb, b + len, sizeof(vb));
+            auto const x = endian::little_to_native(va ^ vb);
+            if(x != 0)
+                return len + (core::countr_zero(x) >> 3);
+            len += 8;
+        }
+        while(len < n && a[len] == b[len])
+            ++len;
+        return len;
+    }
+
     /*  Initialize the hash table (avoiding 64K overflow for 16
         bit systems). prev[] will be initialized on the fly.
     */
@@ -576,7 +623,7 @@ protected:
         {
         //              good lazy nice chain
         case 0: return {  0,   0,   0,    0, &self::deflate_stored}; // store only
-        case 1: return {  4,   4,   8,    4, &self::deflate_fast};   // max speed, no lazy matches
+        case 1: return {  4,   4,   8,    4, &self::deflate_quick};  // max speed, no hash chains
         case 2: return {  4,   5,  16,    8, &self::deflate_fast};
         case 3: return {  4,   6,  32,   32, &self::deflate_fast};
         case 4: return {  4,   4,  16,   16, &self::deflate_slow};   // lazy matches
@@ -611,7 +658,7 @@ protected:
     lut_type const&
     get_lut();
 
-    BOOST_BEAST_DECL void doReset             (int level, int windowBits, int memLevel, Strategy strategy);
+    BOOST_BEAST_DECL void doReset             (int level, int windowBits, int memLevel, Strategy strategy, Format format);
     BOOST_BEAST_DECL void doReset             ();
     BOOST_BEAST_DECL void doClear             ();
     BOOST_BEAST_DECL std::size_t doUpperBound (std::size_t sourceLen) const;
@@ -623,6 +670,8 @@ protected:
     BOOST_BEAST_DECL void doPending           (unsigned* value, int* bits);
 
     BOOST_BEAST_DECL void init                ();
+    BOOST_BEAST_DECL void put_header          ();
+    BOOST_BEAST_DECL void put_trailer         ();
     BOOST_BEAST_DECL void lm_init             ();
     BOOST_BEAST_DECL void init_block          ();
     BOOST_BEAST_DECL void pqdownheap          (ct_data const* tree, int k);
@@ -654,6 +703,7 @@ protected:
     BOOST_BEAST_DECL uInt longest_match       (IPos cur_match);
 
     BOOST_BEAST_DECL block_state f_stored     (z_params& zs, Flush flush);
+    BOOST_BEAST_DECL block_state f_quick      (z_params& zs, Flush flush);
     BOOST_BEAST_DECL block_state f_fast       (z_params& zs, Flush flush);
     BOOST_BEAST_DECL block_state f_slow       (z_params& zs, Flush flush);
     BOOST_BEAST_DECL block_state f_rle        (z_params& zs, Flush flush);
@@ -665,6 +715,12 @@ protected:
         return f_stored(zs, flush);
     }
 
+    block_state
+    deflate_quick(z_params& zs, Flush flush)
+    {
+        return f_quick(zs, flush);
+    }
+
     block_state
     deflate_fast(z_params& zs, Flush flush)
     {
@@ -230,7 +230,8 @@ doReset(
     int level,
     int windowBits,
     int memLevel,
-    Strategy strategy)
+    Strategy strategy,
+    Format format)
 {
     if(level == default_size)
         level = 6;
@@ -261,6 +262,7 @@ doReset(
 
     level_ = level;
     strategy_ = strategy;
+    format_ = format;
     inited_ = false;
 }
 
@@ -291,7 +293,18 @@ doUpperBound(std::size_t sourceLen) const
               ((sourceLen + 7) >> 3) + ((sourceLen + 63) >> 6) + 5;
 
     /* compute wrapper length */
-    wraplen = 0;
+    switch(format_)
+    {
+    case Format::zlib:
+        wraplen = 6;
+        break;
+    case Format::gzip:
+        wraplen = 18;
+        break;
+    default:
+        wraplen = 0;
+        break;
+    }
 
     /* if not default parameters, return conservative bound */
     if(w_bits_ != 15 || hash_bits_ != 8 + 7)
@@ -339,6 +352,13 @@ doParams(z_params& zs, int level, Strategy strategy, error_code& ec)
         if(ec == error::need_buffers && pending_ == 0)
             ec = {};
     }
+    if( inited_ &&
+        func == &self::deflate_quick &&
+        func != get_config(level).func)
+    {
+        // deflate_quick leaves the hash chains stale
+        clear_hash();
+    }
     if(level_ != level)
     {
         level_ = level;
@@ -493,6 +513,15 @@ doWrite(z_params& zs, boost::optional<Flush> flush, error_code& ec)
 
     if(flush == Flush::finish)
     {
+        if(format_ != Format::raw && ! trailer_)
+        {
+            // write the trailer only once
+            put_trailer();
+            trailer_ = true;
+            flush_pending(zs);
+            if(pending_ != 0)
+                return;
+        }
         BOOST_BEAST_ASSIGN_EC(ec, error::end_of_stream);
         return;
     }
@@ -503,7 +532,8 @@ void
 deflate_stream::
 doDictionary(Byte const* dict, uInt dictLength, error_code& ec)
 {
-    if(lookahead_)
+    // the dictionary would be counted in the checksum
+    if(format_ != Format::raw || lookahead_)
     {
         BOOST_BEAST_ASSIGN_EC(ec, error::stream_error);
         return;
@@ -687,9 +717,87 @@ init()
     tr_init();
     lm_init();
 
+    put_header();
+
     inited_ = true;
 }
 
+/*  Start the pending output with the zlib or gzip header,
+    and reset the checksum of the input.
+*/
+void
+deflate_stream::
+put_header()
+{
+    // the header advertises fastest compression when
+    // no string matching is done
+    bool const fastest =
+        strategy_ == Strategy::huffman ||
+        strategy_ == Strategy::rle ||
+        strategy_ == Strategy::fixed ||
+        level_ < 2;
+    total_ = 0;
+    trailer_ = false;
+    if(format_ == Format::zlib)
+    {
+        check_ = 1;
+        unsigned flags;
+        if(fastest)
+            flags = 0;
+        else if(level_ < 6)
+            flags = 1;
+        else if(level_ == 6)
+            flags = 2;
+        else
+            flags = 3;
+        // CMF is the method and window size, FLG
+        // the level and a check that makes the pair
+        // a multiple of 31 read as a 16-bit number
+        unsigned header =
+            ((8 + ((w_bits_ - 8) << 4)) << 8) | (flags << 6);
+        header += 31 - (header % 31);
+        put_byte(static_cast<Byte>(header >> 8));
+        put_byte(static_cast<Byte>(header & 0xff));
+    }
+    else if(format_ == Format::gzip)
+    {
+        check_ = 0;
+        put_byte(0x1f);     // ID1
+        put_byte(0x8b);     // ID2
+        put_byte(8);        // CM = deflate
+        put_byte(0);        // FLG, no optional fields
+        put_byte(0);        // MTIME, not available
+        put_byte(0);
+        put_byte(0);
+        put_byte(0);
+        put_byte(level_ == 9 ? 2 :      // XFL
+            fastest ? 4 : 0);
+        put_byte(255);      // OS, unknown
+    }
+}
+
+/*  Append the checksum and, for gzip, the input size.
+*/
+void
+deflate_stream::
+put_trailer()
+{
+    if(format_ == Format::zlib)
+    {
+        put_byte(static_cast<Byte>(check_ >> 24));
+        put_byte(static_cast<Byte>((check_ >> 16) & 0xff));
+        put_byte(static_cast<Byte>((check_ >> 8) & 0xff));
+        put_byte(static_cast<Byte>(check_ & 0xff));
+    }
+    else
+    {
+        put_short(static_cast<std::uint16_t>(check_ & 0xffff));
+        put_short(static_cast<std::uint16_t>(check_ >> 16));
+        put_short(static_cast<std::uint16_t>(total_ & 0xffff));
+        put_short(static_cast<std::uint16_t>(total_ >> 16));
+    }
+}
+
 /*  Initialize the "longest match" routines for a new zlib stream
 */
 void
@@ -1727,6 +1835,11 @@ read_buf(z_params& zs, Byte *buf, unsigned size)
     zs.avail_in  -= len;
 
     std::memcpy(buf, zs.next_in, len);
+    if(format_ == Format::zlib)
+        check_ = adler32(check_, buf, len);
+    else if(format_ == Format::gzip)
+        check_ = crc32(check_, buf, len);
+    total_ += static_cast<std::uint32_t>(len);
     zs.next_in = static_cast<
         std::uint8_t const*>(zs.next_in) + len;
     zs.total_in += len;
@@ -1741,8 +1854,7 @@ read_buf(z_params& zs, Byte *buf, unsigned size)
         string (strstart) and its distance is <= max_dist, and prev_length >= 1
     OUT assertion: the match length is not greater than s->lookahead_.
 
-    For 80x86 and 680x0, an optimized version will be provided in match.asm or
-    match.S. The code will be functionally equivalent.
+    Candidates are extended eight bytes at a time by compare().
 */
 uInt
 deflate_stream::
@@ -1762,7 +1874,6 @@ longest_match(IPos cur_match)
     std::uint16_t *prev = prev_;
     uInt wmask = w_mask_;
 
-    Byte *strend = window_ + strstart_ + maxMatch;
     Byte scan_end1  = scan[best_len-1];
     Byte scan_end   = scan[best_len];
 
@@ -1797,35 +1908,15 @@ longest_match(IPos cur_match)
          */
         if(     match[best_len]   != scan_end  ||
                 match[best_len-1] != scan_end1 ||
-                *match            != *scan     ||
-                *++match          != scan[1])
+                match[0]          != scan[0]   ||
+                match[1]          != scan[1])
             continue;
 
-        /* The check at best_len-1 can be removed because it will be made
-         * again later. (This heuristic is not always a win.)
-         * It is not necessary to compare scan[2] and match[2] since they
-         * are always equal when the other bytes match, given that
-         * the hash keys are equal and that HASH_BITS >= 8.
-         */
-        scan += 2, match++;
-        BOOST_ASSERT(*scan == *match);
-
-        /* We check for insufficient lookahead only every 8th comparison;
-         * the 256th check will be made at strstart+258.
+        /* The rest of the match is extended a word at a time. This
+         * reads at most strstart+258, which is inside the window.
          */
-        do
-        {
-        }
-        while(  *++scan == *++match && *++scan == *++match &&
-                *++scan == *++match && *++scan == *++match &&
-                *++scan == *++match && *++scan == *++match &&
-                *++scan == *++match && *++scan == *++match &&
-                scan < strend);
-
-        BOOST_ASSERT(scan <= window_+(unsigned)(window_size_-1));
-
-        len = maxMatch - (int)(strend - scan);
-        scan = strend - maxMatch;
+        len = 2 + static_cast<int>(
+            compare(scan + 2, match + 2, maxMatch - 2));
 
         if(len > best_len) {
             match_start_ = cur_match;
@@ -1923,6 +2014,87 @@ f_stored(z_params& zs, Flush flush) ->
     return block_done;
 }
 
+/*  Compress as much as possible from the input stream, return the current
+    block state.
+    This function keeps no hash chains. Each string is looked up once, by
+    a hash of its first four bytes, and strings inside a match are not
+    inserted in the dictionary. It is used only for level 1.
+*/
+auto
+deflate_stream::
+f_quick(z_params& zs, Flush flush) ->
+    block_state
+{
+    bool bflush;           /* set if current block must be flushed */
+
+    for(;;)
+    {
+        /* Make sure that we always have enough lookahead, except
+         * at the end of the input file.
+         */
+        if(lookahead_ < kMinLookahead)
+        {
+            fill_window(zs);
+            if(lookahead_ < kMinLookahead && flush == Flush::none)
+                return need_more;
+            if(lookahead_ == 0)
+                break; /* flush the current block */
+        }
+
+        /* Look up the string window[strstart .. strstart+3] and
+         * replace it as the head of its hash bucket. The candidate
+         * is checked byte by byte, so a stale or colliding entry
+         * only costs a comparison.
+         */
+        IPos hash_head = 0;
+        uInt len = 0;
+        if(lookahead_ > minMatch)
+        {
+            auto const h = hash4(window_ + strstart_);
+            hash_head = head_[h];
+            head_[h] = static_cast<std::uint16_t>(strstart_);
+            if(hash_head != 0 && strstart_ - hash_head <= max_dist())
+                len = compare(window_ + strstart_, window_ + hash_head,
+                    (std::min<uInt>)(lookahead_, maxMatch));
+        }
+        if(len >= minMatch)
+        {
+            tr_tally_dist(static_cast<std::uint16_t>(strstart_ - hash_head),
+                static_cast<std::uint8_t>(len - minMatch), bflush);
+            lookahead_ -= len;
+            strstart_ += len;
+        }
+        else
+        {
+            /* No match, output a literal byte */
+            tr_tally_lit(window_[strstart_], bflush);
+            lookahead_--;
+            strstart_++;
+        }
+        if(bflush)
+        {
+            flush_block(zs, false);
+            if(zs.avail_out == 0)
+                return need_more;
+        }
+    }
+    insert_ = strstart_ < minMatch-1 ? strstart_ : minMatch-1;
+    if(flush == Flush::finish)
+    {
+        flush_block(zs, true);
+        if(zs.avail_out == 0)
+            return finish_started;
+        return finish_done;
+    }
+    if(sym_next_)
+    {
+        flush_block(zs, false);
+        if(zs.avail_out == 0)
+            return need_more;
+    }
+    return block_done;
+}
+
 /*  Compress as much as possible from the input stream, return the current
     block state.
     This function does not perform lazy evaluation of matches and inserts
@@ -39,7 +39,9 @@
 
 #include <boost/beast/zlib/error.hpp>
 #include <boost/beast/zlib/zlib.hpp>
+#include <boost/beast/zlib/detail/adler32.hpp>
 #include <boost/beast/zlib/detail/bitstream.hpp>
+#include <boost/beast/zlib/detail/crc32.hpp>
 #include <boost/beast/zlib/detail/ranges.hpp>
 #include <boost/beast/zlib/detail/window.hpp>
 #if 0
@@ -71,7 +73,7 @@ protected:
 
     BOOST_BEAST_DECL
     void
-    doReset(int windowBits);
+    doReset(int windowBits, Format format);
 
     BOOST_BEAST_DECL
     void
@@ -80,7 +82,7 @@ protected:
     void
     doReset()
     {
-        doReset(w_.bits());
+        doReset(w_.bits(), format_);
     }
 
 private:
@@ -209,6 +211,10 @@ private:
     Mode mode_ = HEAD;              // current inflate mode
     int last_ = 0;                  // true if processing last block
     unsigned dmax_ = 32768U;        // zlib header max distance (INFLATE_STRICT)
+    Format format_ = Format::raw;   // header and trailer to expect
+    unsigned flags_ = 0;            // gzip header flags
+    std::uint32_t check_ = 0;       // header crc, or checksum of the output
+    std::uint32_t total_ = 0;       // output size modulo 2^32, for gzip
 
     // sliding window
     window w_;
@@ -38,8 +38,11 @@
 #define BOOST_BEAST_ZLIB_DETAIL_INFLATE_STREAM_IPP
 
 #include <boost/beast/zlib/detail/inflate_stream.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 namespace boost {
 namespace beast {
@@ -54,12 +57,16 @@ doClear()
 
 void
 inflate_stream::
-doReset(int windowBits)
+doReset(int windowBits, Format format)
 {
     if(windowBits < 8 || windowBits > 15)
         BOOST_THROW_EXCEPTION(std::domain_error{
             "windowBits out of range"});
     w_.reset(windowBits);
+    format_ = format;
+    flags_ = 0;
+    check_ = 0;
+    total_ = 0;
 
     bi_.flush();
     mode_ = HEAD;
@@ -85,9 +92,52 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
     r.out.last = r.out.first + zs.avail_out;
     r.out.next = r.out.first;
 
+    // output not yet included in the checksum
+    auto put = r.out.first;
+    auto const update =
+        [&]
+        {
+            auto const n = r.out.next - put;
+            if(n == 0)
+                return;
+            if(format_ == Format::zlib)
+                check_ = adler32(check_, put, n);
+            else if(format_ == Format::gzip)
+                check_ = crc32(check_, put, n);
+            total_ += static_cast<std::uint32_t>(n);
+            put = r.out.next;
+        };
+
+    // include header bytes in the header crc
+    auto const header_crc =
+        [&](std::uint32_t v, std::size_t n)
+        {
+            std::uint8_t const b[4] = {
+                static_cast<std::uint8_t>(v & 0xff),
+                static_cast<std::uint8_t>((v >> 8) & 0xff),
+                static_cast<std::uint8_t>((v >> 16) & 0xff),
+                static_cast<std::uint8_t>(v >> 24) };
+            check_ = crc32(check_, b, n);
+        };
+
+    // skip a zero terminated gzip header field
+    auto const skip_string =
+        [&]
+        {
+            auto const end = std::find(r.in.next, r.in.last, 0);
+            auto const found = end != r.in.last;
+            auto const n = static_cast<std::size_t>(
+                end - r.in.next) + (found ? 1 : 0);
+            check_ = crc32(check_, r.in.next, n);
+            r.in.next += n;
+            return found;
+        };
+
     auto const done =
         [&]
         {
+            update();
+
             /*
                Return from inflate(), updating the total counts and the check value.
                If there was no progress during the inflate() call, return a buffer
@@ -132,7 +182,136 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
         switch(mode_)
         {
         case HEAD:
-            mode_ = TYPEDO;
+        {
+            if(format_ == Format::raw)
+            {
+                mode_ = TYPEDO;
+                break;
+            }
+            if(! bi_.fill(16, r.in.next, r.in.last))
+                return done();
+            if(format_ == Format::gzip)
+            {
+                std::uint16_t v;
+                bi_.read(v, 16);
+                if(v != 0x8b1f)
+                    return err(error::invalid_header_check);
+                check_ = 0;
+                header_crc(v, 2);
+                mode_ = FLAGS;
+                break;
+            }
+            std::uint8_t cmf;
+            std::uint8_t flg;
+            bi_.read(cmf, 8);
+            bi_.read(flg, 8);
+            if(((cmf << 8) + flg) % 31 != 0)
+                return err(error::invalid_header_check);
+            if((cmf & 0x0f) != 8)
+                return err(error::invalid_method);
+            if((cmf >> 4) + 8 > w_.bits())
+                return err(error::invalid_window_size);
+            if(flg & 0x20)
+                return err(error::need_dict);
+            check_ = 1;
+            total_ = 0;
+            mode_ = TYPE;
+            break;
+        }
+
+        case FLAGS:
+        {
+            if(! bi_.fill(16, r.in.next, r.in.last))
+                return done();
+            std::uint16_t v;
+            bi_.read(v, 16);
+            header_crc(v, 2);
+            if((v & 0xff) != 8)
+                return err(error::invalid_method);
+            flags_ = v >> 8;
+            if(flags_ & 0xe0)
+                return err(error::invalid_header_flags);
+            mode_ = TIME;
+            BOOST_FALLTHROUGH;
+        }
+
+        case TIME:
+        {
+            if(! bi_.fill(32, r.in.next, r.in.last))
+                return done();
+            std::uint16_t v;
+            bi_.read(v, 16);
+            header_crc(v, 2);
+            bi_.read(v, 16);
+            header_crc(v, 2);
+            mode_ = OS;
+            BOOST_FALLTHROUGH;
+        }
+
+        case OS:
+        {
+            if(! bi_.fill(16, r.in.next, r.in.last))
+                return done();
+            std::uint16_t v;
+            bi_.read(v, 16);
+            header_crc(v, 2);
+            mode_ = EXLEN;
+            BOOST_FALLTHROUGH;
+        }
+
+        case EXLEN:
+            if(flags_ & 0x04)
+            {
+                if(! bi_.fill(16, r.in.next, r.in.last))
+                    return done();
+                bi_.read(length_, 16);
+                header_crc(length_, 2);
+            }
+            mode_ = EXTRA;
+            BOOST_FALLTHROUGH;
+
+        case EXTRA:
+            if(flags_ & 0x04)
+            {
+                // the header is read whole bytes at a time,
+                // so the remaining fields come from the input
+                BOOST_ASSERT(bi_.size() == 0);
+                auto const n = (std::min<std::size_t>)(
+                    length_, r.in.avail());
+                check_ = crc32(check_, r.in.next, n);
+                r.in.next += n;
+                length_ -= static_cast<unsigned>(n);
+                if(length_ != 0)
+                    return done();
+            }
+            mode_ = NAME;
+            BOOST_FALLTHROUGH;
+
+        case NAME:
+            if((flags_ & 0x08) && ! skip_string())
+                return done();
+            mode_ = COMMENT;
+            BOOST_FALLTHROUGH;
+
+        case COMMENT:
+            if((flags_ & 0x10) && ! skip_string())
+                return done();
+            mode_ = HCRC;
+            BOOST_FALLTHROUGH;
+
+        case HCRC:
+            if(flags_ & 0x02)
+            {
+                if(! bi_.fill(16, r.in.next, r.in.last))
+                    return done();
+                std::uint16_t v;
+                bi_.read(v, 16);
+                if(v != (check_ & 0xffff))
+                    return err(error::invalid_header_crc);
+            }
+            check_ = 0;
+            total_ = 0;
+            mode_ = TYPE;
             break;
 
         case TYPE:
@@ -359,7 +538,7 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
 
         case LEN:
         {
-            if(r.in.avail() >= 6 && r.out.avail() >= 258)
+            if(r.in.avail() >= 8 && r.out.avail() >= 258)
             {
                 inflate_fast(r, ec);
                 if(ec)
@@ -514,6 +693,36 @@ doWrite(z_params& zs, Flush flush, error_code& ec)
         }
 
         case CHECK:
+            if(format_ != Format::raw)
+            {
+                if(! bi_.fill(32, r.in.next, r.in.last))
+                    return done();
+                update();
+                std::uint32_t lo;
+                std::uint32_t hi;
+                bi_.read(lo, 16);
+                bi_.read(hi, 16);
+                auto v = lo | (hi << 16);
+                if(format_ == Format::zlib)
+                    v = endian::endian_reverse(v);
+                if(v != check_)
+                    return err(error::invalid_data_check);
+            }
+            mode_ = LENGTH;
+            BOOST_FALLTHROUGH;
+
+        case LENGTH:
+            if(format_ == Format::gzip)
+            {
+                if(! bi_.fill(32, r.in.next, r.in.last))
+                    return done();
+                std::uint32_t lo;
+                std::uint32_t hi;
+                bi_.read(lo, 16);
+                bi_.read(hi, 16);
+                if((lo | (hi << 16)) != total_)
+                    return err(error::invalid_length_check);
+            }
             mode_ = DONE;
             BOOST_FALLTHROUGH;
 
@@ -940,7 +1149,7 @@ fixedTables()
    Entry assumptions:
 
         state->mode_ == LEN
-        zs.avail_in >= 6
+        zs.avail_in >= 8
         zs.avail_out >= 258
         start >= zs.avail_out
         state->bits_ < 8
@@ -956,14 +1165,20 @@ fixedTables()
     - The maximum input bits used by a length/distance pair is 15 bits for the
       length code, 5 bits for the length extra, 15 bits for the distance code,
       and 13 bits for the distance extra.  This totals 48 bits, or six bytes.
-      Therefore if zs.avail_in >= 6, then there is enough input to avoid
-      checking for available input while decoding.
+      Each loop starts by loading eight bytes into the 64-bit bit buffer,
+      which leaves at least 56 bits, so no further checks for input are
+      needed while decoding. This requires zs.avail_in >= 8 at each load.
 
     - The maximum bytes that a single length/distance pair can output is 258
       bytes, which is the maximum length that can be coded.  inflate_fast()
       requires zs.avail_out >= 258 for each loop to avoid checking for
       output space.
 
+    - Matches are copied from the output in 16 or 8 byte pieces when the
+      distance allows it. The last piece may write up to 15 bytes past the
+      end of the match; these are overwritten by the following output, and
+      the wide copy is only used when they fit in the output buffer.
+
   inflate_fast() speedups that turned out slower (on a PowerPC G3 750CXe):
    - Using bit fields for code structure
    - Different op definition to avoid & for extra bits (do & for table bits)
@@ -990,15 +1205,14 @@ inflate_fast(ranges& r, error_code& ec)
     unsigned const dmask =
         (1U << distbits_) - 1;  // mask for first level of distance codes
 
-    last = r.in.next + (r.in.avail() - 5);
+    last = r.in.next + (r.in.avail() - 7);
     end = r.out.next + (r.out.avail() - 257);
 
     /* decode literals and length/distances until end-of-block or not enough
        input data or output space */
     do
     {
-        if(bi_.size() < 15)
-            bi_.fill_16(r.in.next);
+        bi_.fill_fast(r.in.next);
         auto cp = &lencode_[bi_.peek_fast() & lmask];
     dolen:
         bi_.drop(cp->bits);
@@ -1015,13 +1229,9 @@ inflate_fast(ranges& r, error_code& ec)
             op &= 15; // number of extra bits
             if(op)
             {
-                if(bi_.size() < op)
-                    bi_.fill_8(r.in.next);
                 len += (unsigned)bi_.peek_fast() & ((1U << op) - 1);
                 bi_.drop(op);
             }
-            if(bi_.size() < 15)
-                bi_.fill_16(r.in.next);
             cp = &distcode_[bi_.peek_fast() & dmask];
         dodist:
             bi_.drop(cp->bits);
@@ -1031,12 +1241,6 @@ inflate_fast(ranges& r, error_code& ec)
                 // distance base
                 dist = (unsigned)(cp->val);
                 op &= 15; // number of extra bits
-                if(bi_.size() < op)
-                {
-                    bi_.fill_8(r.in.next);
-                    if(bi_.size() < op)
-                        bi_.fill_8(r.in.next);
-                }
                 dist += (unsigned)bi_.peek_fast() & ((1U << op) - 1);
 #ifdef INFLATE_STRICT
                 if(dist > dmax_)
@@ -1068,10 +1272,40 @@ inflate_fast(ranges& r, error_code& ec)
                 {
                     // copy from output
                     auto in = r.out.next - dist;
-                    auto n = clamp(len, r.out.avail());
-                    len -= n;
-                    while(n--)
-                        *r.out.next++ = *in++;
+                    auto out = r.out.next;
+                    r.out.next += len;
+                    if(r.out.avail() < 16 || dist < 8)
+                    {
+                        if(dist == 1)
+                        {
+                            std::memset(out, *in, len);
+                        }
+                        else
+                        {
+                            while(out < r.out.next)
+                                *out++ = *in++;
+                        }
+                    }
+                    else if(dist >= 16)
+                    {
+                        do
+                        {
+                            std::memcpy(out, in, 16);
+                            out += 16;
+                            in += 16;
+                        }
+                        while(out < r.out.next);
+                    }
+                    else
+                    {
+                        do
+                        {
+                            std::memcpy(out, in, 8);
+                            out += 8;
+                            in += 8;
+                        }
+                        while(out < r.out.next);
+                    }
                 }
             }
             else if((op & 64) == 0)
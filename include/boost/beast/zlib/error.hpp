@@ -133,10 +133,33 @@ enum class error
     /// Incomplete length set
     incomplete_length_set,
 
+    /// general error
+    general,
 
+    //
+    // Errors generated by the zlib and gzip formats
+    //
 
-    /// general error
-    general
+    /// Incorrect header check
+    invalid_header_check,
+
+    /// Unknown compression method
+    invalid_method,
+
+    /// Invalid window size
+    invalid_window_size,
+
+    /// Unknown header flags set
+    invalid_header_flags,
+
+    /// Header crc mismatch
+    invalid_header_crc,
+
+    /// Incorrect data check
+    invalid_data_check,
+
+    /// Incorrect length check
+    invalid_length_check
 };
 
 } // zlib
@@ -79,6 +79,14 @@ public:
         case error::over_subscribed_length: return "over-subscribed length";
         case error::incomplete_length_set: return "incomplete length set";
 
+        case error::invalid_header_check: return "incorrect header check";
+        case error::invalid_method: return "unknown compression method";
+        case error::invalid_window_size: return "invalid window size";
+        case error::invalid_header_flags: return "unknown header flags set";
+        case error::invalid_header_crc: return "header crc mismatch";
+        case error::invalid_data_check: return "incorrect data check";
+        case error::invalid_length_check: return "incorrect length check";
+
         case error::general:
         default:
             return "beast.zlib error";
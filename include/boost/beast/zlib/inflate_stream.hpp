@@ -54,6 +54,10 @@ namespace zlib {
     The implementation is a refactored port to C++ of ZLib's "inflate".
     A more detailed description of ZLib is at http://zlib.net/.
 
+    By default the input is raw deflate data; the stream can also be
+    reset to decode the zlib or gzip format, in which case the header
+    is checked and the checksum in the trailer is verified.
+
     Compression can be done in a single step if the buffers are large
     enough (for example if an input file is memory mapped), or can be done
     by repeated calls of the compression function. In the latter case, the
@@ -73,8 +77,8 @@ public:
     /** Reset the stream.
 
         This puts the stream in a newly constructed state with
-        the previously specified window size, but without de-allocating
-        any dynamically created structures.
+        the previously specified window size and format, but without
+        de-allocating any dynamically created structures.
     */
     void
     reset()
@@ -85,13 +89,34 @@ public:
     /** Reset the stream.
 
         This puts the stream in a newly constructed state with the
-        specified window size, but without de-allocating any dynamically
-        created structures.
+        specified window size, decoding raw deflate data, but without
+        de-allocating any dynamically created structures.
     */
     void
     reset(int windowBits)
     {
-        doReset(windowBits);
+        doReset(windowBits, Format::raw);
+    }
+
+    /** Reset the stream.
+
+        This puts the stream in a newly constructed state with the
+        specified window size and format, but without de-allocating
+        any dynamically created structures.
+
+        @param windowBits The base two logarithm of the largest window
+        size to accept, in the range 8..15.
+
+        @param format The framing expected around the compressed data.
+        For @ref Format::zlib, a stream whose header announces a larger
+        window is rejected with `error::invalid_window_size`, and a
+        stream which requires a preset dictionary is rejected with
+        `error::need_dict`.
+    */
+    void
+    reset(int windowBits, Format format)
+    {
+        doReset(windowBits, format);
     }
 
     /** Put the stream in a newly constructed state.
@@ -245,6 +245,35 @@ enum class Strategy
     fixed
 };
 
+/** Stream format.
+
+    This selects the framing around the compressed data,
+    used by both the compressor and the decompressor.
+*/
+enum class Format
+{
+    /** Raw deflate data (rfc1951), with no header or trailer.
+    */
+    raw,
+
+    /** The zlib format (rfc1950).
+
+        A two byte header precedes the deflate data, which is
+        followed by the Adler-32 checksum of the uncompressed
+        data. This is used for `Content-Encoding: deflate`.
+    */
+    zlib,
+
+    /** The gzip format (rfc1952).
+
+        A header of at least ten bytes precedes the deflate data,
+        which is followed by the CRC-32 and the size modulo 2^32
+        of the uncompressed data. This is used for
+        `Content-Encoding: gzip`.
+    */
+    gzip
+};
+
 } // zlib
 } // beast
 } // boost
@@ -80,6 +80,81 @@ public:
             "dWVkIGFuZCBpbmRlZmF0aWdhYmxlIGdlbmVyYXRpb24gb2Yga25vd2xlZGdlLCBleGNlZWRzIHRo"
             "ZSBzaG9ydCB2ZWhlbWVuY2Ugb2YgYW55IGNhcm5hbCBwbGVhc3VyZS4="
             );
+
+        testLengths();
+        testInvalid();
+    }
+
+    // One bit at a time, as in RFC 4648
+    static
+    std::string
+    reference_encode(std::string const& in)
+    {
+        std::string out;
+        auto const tab = base64::get_alphabet();
+        std::size_t bits = 0;
+        unsigned acc = 0;
+        for(unsigned char c : in)
+        {
+            acc = (acc << 8) | c;
+            bits += 8;
+            while(bits >= 6)
+            {
+                bits -= 6;
+                out.push_back(tab[(acc >> bits) & 0x3f]);
+            }
+        }
+        if(bits > 0)
+            out.push_back(tab[(acc << (6 - bits)) & 0x3f]);
+        while(out.size() % 4)
+            out.push_back('=');
+        return out;
+    }
+
+    static
+    std::string
+    make_octets(std::size_t n)
+    {
+        std::string s;
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>((i * 167 + 13) & 0xff));
+        return s;
+    }
+
+    // Cover the vector loops and every length of scalar tail
+    void
+    testLengths()
+    {
+        for(std::size_t n = 0; n <= 200; ++n)
+        {
+            auto const s = make_octets(n);
+            auto const encoded = base64_encode(s);
+            BEAST_EXPECT(encoded == reference_encode(s));
+            BEAST_EXPECT(base64_decode(encoded) == s);
+        }
+    }
+
+    // Decoding stops at the first character outside the alphabet
+    void
+    testInvalid()
+    {
+        auto const s = make_octets(150);
+        auto const encoded = base64_encode(s);
+        for(std::size_t k = 0; k < encoded.size(); ++k)
+        {
+            for(char c : { '*', '=', '\x80' })
+            {
+                auto e = encoded;
+                e[k] = c;
+                std::string dest(base64::decoded_size(e.size()), 0);
+                auto const result = base64::decode(
+                    &dest[0], e.data(), e.size());
+                auto const n = k / 4 * 3 + (k % 4 ? k % 4 - 1 : 0);
+                BEAST_EXPECT(result.first == n);
+                BEAST_EXPECT(result.second == k);
+                BEAST_EXPECT(dest.substr(0, n) == s.substr(0, n));
+            }
+        }
     }
 };
 
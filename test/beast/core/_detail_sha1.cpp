@@ -9,8 +9,12 @@
 
 #include <boost/beast/core/detail/config.hpp>
 #include <boost/beast/core/detail/sha1.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <array>
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -74,6 +78,80 @@ public:
             "84983e44" "1c3bd26e" "baae4aa1" "f95129e5" "e54670f1");
         check("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
             "a49b2446" "a02c645b" "f419f995" "b6709125" "3a04a259");
+        check(std::string(1000000, 'a'),
+            "34aa973c" "d4c4daa4" "f61eeb2b" "dbad2731" "6534016f");
+
+        testUpdate();
+        testKernels();
+    }
+
+    static
+    std::string
+    make_message(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>((i * 131 + 7) & 0xff));
+        return s;
+    }
+
+    // Feeding the message in pieces gives the same digest
+    void
+    testUpdate()
+    {
+        auto const s = make_message(300);
+        char expected[sha1_context::digest_size];
+        {
+            sha1_context ctx;
+            init(ctx);
+            update(ctx, s.data(), s.size());
+            finish(ctx, &expected[0]);
+        }
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            sha1_context ctx;
+            char result[sha1_context::digest_size];
+            init(ctx);
+            update(ctx, s.data(), i);
+            update(ctx, s.data() + i, s.size() - i);
+            finish(ctx, &result[0]);
+            BEAST_EXPECT(std::memcmp(result, expected,
+                sizeof(result)) == 0);
+        }
+    }
+
+    // Every kernel the CPU supports agrees with the portable one
+    void
+    testKernels()
+    {
+        std::vector<sha1::transform_fn> v;
+        v.push_back(&sha1::transform_portable);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        auto const& ci = get_cpu_info();
+        if(ci.sha && ci.sse41)
+            v.push_back(&sha1::transform_shani);
+#endif
+        auto const s = make_message(sha1::BLOCK_BYTES * 5);
+        auto const p = reinterpret_cast<
+            std::uint8_t const*>(s.data());
+        std::uint32_t const iv[5] = {
+            0x67452301, 0xefcdab89, 0x98badcfe,
+            0x10325476, 0xc3d2e1f0 };
+        for(std::size_t n = 1; n <= 5; ++n)
+        {
+            std::uint32_t expected[5];
+            std::memcpy(expected, iv, sizeof(iv));
+            sha1::transform_portable(expected, p, n);
+            for(auto fn : v)
+            {
+                std::uint32_t digest[5];
+                std::memcpy(digest, iv, sizeof(iv));
+                fn(digest, p, n);
+                BEAST_EXPECT(std::memcmp(digest, expected,
+                    sizeof(digest)) == 0);
+            }
+        }
     }
 };
 
@@ -15,6 +15,7 @@
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <boost/beast/core/bind_handler.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/shared_rate_policy.hpp>
 #include <boost/beast/core/stream_traits.hpp>
 #include <boost/beast/core/string.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
@@ -420,6 +421,14 @@ public:
                 unlimited_rate_policy> s(
                     unlimited_rate_policy{}, ioc);
         }
+
+        {
+            rate_limiter limiter;
+            basic_stream<tcp,
+                net::io_context::executor_type,
+                shared_rate_policy> s(
+                    shared_rate_policy(limiter), ioc);
+        }
     }
 
     class handler
@@ -1401,6 +1410,151 @@ public:
         }
     }
 
+    void
+    testTimerWheel()
+    {
+        using stream_type = basic_stream<tcp,
+            net::io_context::executor_type>;
+
+        char buf[4];
+        net::io_context ioc;
+        net::mutable_buffer mb(buf, sizeof(buf));
+        auto const ep = net::ip::tcp::endpoint(
+            net::ip::make_address("127.0.0.1"), 0);
+        timer_wheel wheel(ioc.get_executor(),
+            std::chrono::milliseconds(10));
+
+        {
+            // success, with timeout
+            test_server srv("*", ep, log);
+            stream_type s(ioc);
+            s.set_timer_wheel(wheel);
+            s.socket().connect(srv.local_endpoint());
+            s.expires_after(std::chrono::seconds(30));
+            s.async_read_some(mb, handler({}, 1));
+            BEAST_EXPECT(wheel.size() == 1);
+            ioc.run();
+            ioc.restart();
+            BEAST_EXPECT(wheel.size() == 0);
+        }
+
+        {
+            // timeout
+            test_server srv("", ep, log);
+            stream_type s(ioc);
+            s.set_timer_wheel(wheel);
+            s.socket().connect(srv.local_endpoint());
+            s.expires_after(std::chrono::milliseconds(50));
+            s.async_read_some(mb, handler(error::timeout, 0));
+            ioc.run();
+            ioc.restart();
+            BEAST_EXPECT(wheel.size() == 0);
+        }
+
+        {
+            // expired before the operation
+            test_server srv("", ep, log);
+            stream_type s(ioc);
+            s.set_timer_wheel(wheel);
+            s.socket().connect(srv.local_endpoint());
+            s.expires_after(std::chrono::seconds(0));
+            s.async_read_some(mb, handler(error::timeout, 0));
+            ioc.run();
+            ioc.restart();
+        }
+
+        {
+            // write, without a timeout
+            test_server srv("", ep, log);
+            stream_type s(ioc);
+            s.set_timer_wheel(wheel);
+            s.socket().connect(srv.local_endpoint());
+            s.expires_never();
+            s.async_write_some(net::const_buffer("*", 1),
+                handler({}, 1));
+            BEAST_EXPECT(wheel.size() == 0);
+            ioc.run();
+            ioc.restart();
+        }
+
+        {
+            // stream destroyed
+            test_server srv("", ep, log);
+            {
+                auto s = net::detached.as_default_on(stream_type(ioc));
+                s.set_timer_wheel(wheel);
+                s.socket().connect(srv.local_endpoint());
+                s.expires_after(std::chrono::seconds(30));
+                s.async_read_some(mb);
+            }
+            ioc.run();
+            ioc.restart();
+            BEAST_EXPECT(wheel.size() == 0);
+        }
+
+        {
+            // back to the timers of the stream
+            test_server srv("", ep, log);
+            stream_type s(ioc);
+            s.set_timer_wheel(wheel);
+            s.set_timer_wheel(timer_wheel{});
+            s.socket().connect(srv.local_endpoint());
+            s.expires_after(std::chrono::milliseconds(50));
+            s.async_read_some(mb, handler(error::timeout, 0));
+            BEAST_EXPECT(wheel.size() == 0);
+            ioc.run();
+            ioc.restart();
+        }
+    }
+
+    void
+    testSharedRatePolicy()
+    {
+        using stream_type = basic_stream<tcp,
+            net::io_context::executor_type,
+            shared_rate_policy>;
+
+        net::io_context ioc;
+        auto const ep = net::ip::tcp::endpoint(
+            net::ip::make_address("127.0.0.1"), 0);
+
+        // two streams share the limit of a tenant
+        rate_limiter global(std::chrono::milliseconds(10));
+        global.write_limit(1000000);
+        rate_limiter tenant = global.child();
+        tenant.write_limit(2000);
+
+        // the peers stay open without reading; the
+        // data fits in the socket buffers.
+        std::string const data(100, '*');
+        tcp::acceptor a(ioc, ep);
+        tcp::socket p1(ioc);
+        tcp::socket p2(ioc);
+        stream_type s1(shared_rate_policy(tenant), ioc);
+        stream_type s2(shared_rate_policy(tenant), ioc);
+        s1.socket().connect(a.local_endpoint());
+        a.accept(p1);
+        s2.socket().connect(a.local_endpoint());
+        a.accept(p2);
+        auto const t0 = std::chrono::steady_clock::now();
+        int count = 0;
+        auto const on_write =
+            [&](error_code ec, std::size_t n)
+            {
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(n == data.size());
+                ++count;
+            };
+        net::async_write(s1, net::buffer(data), on_write);
+        net::async_write(s2, net::buffer(data), on_write);
+        ioc.run();
+        BEAST_EXPECT(count == 2);
+
+        // 200 bytes at 20 bytes per tick
+        BEAST_EXPECT(std::chrono::steady_clock::now() - t0 >=
+            std::chrono::milliseconds(50));
+    }
+
     void
     run()
     {
@@ -1411,6 +1565,8 @@ public:
         testMembers();
         testJavadocs();
         testIssue1589();
+        testTimerWheel();
+        testSharedRatePolicy();
 
 #if BOOST_ASIO_HAS_CO_AWAIT
         // test for compilation success only
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/core/shared_rate_policy.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace boost {
+namespace beast {
+
+class shared_rate_policy_test : public unit_test::suite
+{
+public:
+    using node = detail::rate_limiter_node;
+
+    static std::size_t constexpr all = node::all;
+
+    static
+    std::shared_ptr<detail::rate_limiter_root>
+    make_root(std::chrono::steady_clock::duration res)
+    {
+        return std::make_shared<
+            detail::rate_limiter_root>(res);
+    }
+
+    void
+    testBucket()
+    {
+        // one hour per tick, so nothing refills during the test
+        auto const root = make_root(std::chrono::hours(1));
+        node n(root);
+        node::ticket rd;
+        node::ticket wr;
+        BEAST_EXPECT(n.available(true, rd) == all);
+        BEAST_EXPECT(n.available(false, wr) == all);
+
+        n.limit(false, 1);
+        BEAST_EXPECT(n.available(false, wr) == 3600);
+        BEAST_EXPECT(n.available(true, rd) == all);
+
+        // what was not transferred is returned
+        n.transfer(false, wr, 3000);
+        BEAST_EXPECT(n.available(false, wr) == 600);
+        BEAST_EXPECT(! wr.waiting);
+        n.transfer(false, wr, 1000);
+        BEAST_EXPECT(n.available(false, wr) == 0);
+        BEAST_EXPECT(wr.waiting);
+        n.leave(false, wr);
+        BEAST_EXPECT(! wr.waiting);
+
+        // lowering the limit caps what is left
+        node n2(root);
+        n2.limit(true, 10);
+        n2.limit(true, 1);
+        BEAST_EXPECT(n2.available(true, rd) == 3600);
+        n2.limit(true, all);
+        BEAST_EXPECT(n2.available(true, rd) == all);
+    }
+
+    void
+    testHierarchy()
+    {
+        auto const root = make_root(std::chrono::hours(1));
+        auto const global = std::make_shared<node>(root);
+        node a(root, global);
+        node b(root, global);
+        global->limit(false, 1);
+
+        // children take from the parent
+        node::ticket ta;
+        node::ticket tb;
+        BEAST_EXPECT(a.available(false, ta) == 3600);
+        a.transfer(false, ta, 600);
+        BEAST_EXPECT(b.available(false, tb) == 3000);
+
+        // the tighter limit applies
+        b.limit(false, 0);
+        BEAST_EXPECT(b.available(false, tb) == 1);
+        b.transfer(false, tb, 1);
+        node::ticket tg;
+        BEAST_EXPECT(global->available(false, tg) == 2999);
+    }
+
+    void
+    testGrant()
+    {
+        auto const root = make_root(std::chrono::hours(1));
+        node n(root);
+        n.limit(false, 1);
+
+        // bytes granted to one stream are not offered to another
+        node::ticket t1;
+        node::ticket t2;
+        BEAST_EXPECT(n.available(false, t1) == 3600);
+        BEAST_EXPECT(n.available(false, t2) == 0);
+        BEAST_EXPECT(t2.waiting);
+        n.leave(false, t1);
+        BEAST_EXPECT(n.available(false, t2) == 3600);
+        BEAST_EXPECT(! t2.waiting);
+
+        // transferring more than was granted takes the rest
+        n.transfer(false, t2, 3601);
+        BEAST_EXPECT(n.available(false, t1) == 0);
+        n.leave(false, t1);
+    }
+
+    void
+    testFairness()
+    {
+        auto const root = make_root(std::chrono::hours(1));
+        auto const global = std::make_shared<node>(root);
+        node a(root, global);
+        node b(root, global);
+        global->limit(false, 1);
+        a.limit(false, 0);
+        node::ticket t0;
+        a.transfer(false, t0, 1);
+
+        // three streams wait on a
+        node::ticket w1;
+        node::ticket w2;
+        node::ticket w3;
+        BEAST_EXPECT(a.available(false, w1) == 0);
+        BEAST_EXPECT(a.available(false, w2) == 0);
+        BEAST_EXPECT(a.available(false, w3) == 0);
+        BEAST_EXPECT(w1.waiting && w2.waiting && w3.waiting);
+
+        // a stream on b leaves them a share of the global bucket
+        node::ticket w4;
+        BEAST_EXPECT(b.available(false, w4) == 3599 / 4);
+
+        // retrying stops counting the stream until it waits again
+        BEAST_EXPECT(a.available(false, w1) == 0);
+        BEAST_EXPECT(w1.waiting);
+
+        a.leave(false, w1);
+        a.leave(false, w2);
+        BEAST_EXPECT(b.available(false, w4) == 3599 / 2);
+        a.leave(false, w3);
+        BEAST_EXPECT(b.available(false, w4) == 3599);
+    }
+
+    void
+    testRefill()
+    {
+        auto const root = make_root(std::chrono::milliseconds(10));
+        node n(root);
+        n.limit(true, 10000);
+        node::ticket t;
+        BEAST_EXPECT(n.available(true, t) == 100);
+        n.transfer(true, t, 100);
+        auto const next = n.refill_time();
+        BEAST_EXPECT(next > std::chrono::steady_clock::now() -
+            std::chrono::milliseconds(10));
+        BEAST_EXPECT(next <= std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(10));
+        std::this_thread::sleep_until(next);
+        BEAST_EXPECT(n.available(true, t) == 100);
+        BEAST_EXPECT(! t.waiting);
+    }
+
+    void
+    testMembers()
+    {
+        rate_limiter global;
+        global.read_limit(1000);
+        global.write_limit(2000);
+        rate_limiter tenant = global.child();
+        tenant.write_limit(100);
+
+        shared_rate_policy p0;
+        shared_rate_policy p1(tenant);
+        shared_rate_policy p2(p1);
+        shared_rate_policy p3(std::move(p2));
+        p0 = p3;
+        p0.set_limiter(global);
+
+        try
+        {
+            rate_limiter r(std::chrono::seconds(0));
+            fail();
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    run() override
+    {
+        testBucket();
+        testHierarchy();
+        testGrant();
+        testFairness();
+        testRefill();
+        testMembers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,core,shared_rate_policy);
+
+} // beast
+} // boost
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/core/timer_wheel.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace boost {
+namespace beast {
+
+class timer_wheel_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using ms = std::chrono::milliseconds;
+
+    struct entry : detail::timer_wheel_entry
+    {
+        int expired = 0;
+
+        entry()
+        {
+            on_expire =
+                [](detail::timer_wheel_entry& e)
+                {
+                    ++static_cast<entry&>(e).expired;
+                };
+        }
+    };
+
+    void
+    testAdvance()
+    {
+        net::io_context ioc;
+        auto const sp = std::make_shared<detail::timer_wheel_impl>(
+            ioc.get_executor(), ms(10), 8);
+        auto& w = *sp;
+        auto const start = clock_type::now();
+        BEAST_EXPECT(w.resolution() == ms(10));
+
+        // never early, late by at most one tick
+        {
+            entry e;
+            w.insert(e, start + ms(35));
+            BEAST_EXPECT(e.linked());
+            BEAST_EXPECT(w.size() == 1);
+            w.advance(start + ms(30));
+            BEAST_EXPECT(e.expired == 0);
+            w.advance(start + ms(50));
+            BEAST_EXPECT(e.expired == 1);
+            BEAST_EXPECT(! e.linked());
+            BEAST_EXPECT(w.size() == 0);
+        }
+
+        // removed entries do not expire
+        {
+            entry e;
+            w.insert(e, start + ms(80));
+            BEAST_EXPECT(w.remove(e));
+            BEAST_EXPECT(! w.remove(e));
+            w.advance(start + ms(100));
+            BEAST_EXPECT(e.expired == 0);
+        }
+
+        // due entries expire on the next tick
+        {
+            entry e;
+            w.insert(e, start);
+            w.advance(start + ms(105));
+            BEAST_EXPECT(e.expired == 0);
+            w.advance(start + ms(120));
+            BEAST_EXPECT(e.expired == 1);
+        }
+
+        // deadlines past one revolution share slots
+        {
+            entry e1;
+            entry e2;
+            w.insert(e1, start + ms(200));
+            w.insert(e2, start + ms(280));
+            w.advance(start + ms(210));
+            BEAST_EXPECT(e1.expired == 1);
+            BEAST_EXPECT(e2.expired == 0);
+            w.advance(start + ms(270));
+            BEAST_EXPECT(e2.expired == 0);
+            w.advance(start + ms(1000));
+            BEAST_EXPECT(e2.expired == 1);
+            BEAST_EXPECT(w.size() == 0);
+        }
+
+        // handlers may remove other expired entries
+        {
+            struct pair_entry : detail::timer_wheel_entry
+            {
+                detail::timer_wheel_impl* w;
+                pair_entry* other;
+                int expired = 0;
+            };
+            pair_entry e1;
+            pair_entry e2;
+            e1.w = &w;
+            e2.w = &w;
+            e1.other = &e2;
+            e2.other = &e1;
+            auto const f =
+                [](detail::timer_wheel_entry& e)
+                {
+                    auto& p = static_cast<pair_entry&>(e);
+                    ++p.expired;
+                    p.w->remove(*p.other);
+                };
+            e1.on_expire = f;
+            e2.on_expire = f;
+            w.insert(e1, start + ms(1050));
+            w.insert(e2, start + ms(1050));
+            w.advance(start + ms(1100));
+            BEAST_EXPECT(e1.expired + e2.expired == 1);
+            BEAST_EXPECT(w.size() == 0);
+        }
+
+        // copies are unlinked
+        {
+            entry e;
+            w.insert(e, start + ms(1200));
+            entry const e2(e);
+            BEAST_EXPECT(! e2.linked());
+            BEAST_EXPECT(w.remove(e));
+        }
+    }
+
+    void
+    testRun()
+    {
+        net::io_context ioc;
+        {
+            timer_wheel const wheel(ioc.get_executor(), ms(5));
+            BEAST_EXPECT(wheel);
+            BEAST_EXPECT(wheel.resolution() == ms(5));
+            BEAST_EXPECT(wheel.size() == 0);
+            BEAST_EXPECT(! timer_wheel{});
+        }
+
+        auto const sp = std::make_shared<detail::timer_wheel_impl>(
+            ioc.get_executor(), ms(5), 16);
+        auto& w = *sp;
+        entry e1;
+        entry e2;
+        auto const t0 = clock_type::now();
+        w.insert(e1, t0 + ms(10));
+        w.insert(e2, t0 + ms(30));
+        BEAST_EXPECT(w.size() == 2);
+        ioc.run();
+        BEAST_EXPECT(clock_type::now() - t0 >= ms(30));
+        BEAST_EXPECT(e1.expired == 1);
+        BEAST_EXPECT(e2.expired == 1);
+        BEAST_EXPECT(w.size() == 0);
+
+        // the wheel stops ticking when empty, and restarts
+        ioc.restart();
+        w.insert(e1, clock_type::now() + ms(10));
+        ioc.run();
+        BEAST_EXPECT(e1.expired == 2);
+    }
+
+    void
+    testInvalid()
+    {
+        net::io_context ioc;
+        try
+        {
+            timer_wheel wheel(ioc.get_executor(), ms(0));
+            fail();
+        }
+        catch(std::invalid_argument const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    run() override
+    {
+        testAdvance();
+        testRun();
+        testInvalid();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,core,timer_wheel);
+
+} // beast
+} // boost
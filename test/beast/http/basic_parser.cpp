@@ -569,6 +569,365 @@ public:
             "\r\n",                         error::bad_line_ending);
     }
 
+    void
+    testFindFast()
+    {
+        using base = detail::basic_parser_base;
+
+        BOOST_ALIGNMENT(16) static char const ranges[] =
+            "\x00 "  /* control chars and up to SP */
+            "\"\""   /* 0x22 */
+            "()"     /* 0x28,0x29 */
+            ",,"     /* 0x2c */
+            "//"     /* 0x2f */
+            ":@"     /* 0x3a-0x40 */
+            "[]"     /* 0x5b-0x5d */
+            "{\377"; /* 0x7b-0xff */
+
+        auto const in_ranges =
+            [](unsigned char c)
+            {
+                for(std::size_t i = 0; i < sizeof(ranges) - 1; i += 2)
+                    if( c >= static_cast<unsigned char>(ranges[i]) &&
+                        c <= static_cast<unsigned char>(ranges[i + 1]))
+                        return true;
+                return false;
+            };
+
+        // every octet value, at every offset, across block boundaries
+        for(std::size_t n = 0; n <= 72; ++n)
+        {
+            for(std::size_t i = 0; i <= n; ++i)
+            {
+                for(unsigned v = 0; v < 256; v += (i == n ? 256 : 1))
+                {
+                    std::string s(n, 'x');
+                    if(i < n)
+                        s[i] = static_cast<char>(v);
+                    auto const expected =
+                        (i < n && in_ranges(static_cast<
+                            unsigned char>(v))) ? i : n;
+                    auto const result = base::find_fast(
+                        s.data(), s.data() + s.size(),
+                        ranges, sizeof(ranges) - 1);
+                    auto const pos = static_cast<std::size_t>(
+                        result.first - s.data());
+                    if(result.second)
+                        BEAST_EXPECT(pos == expected);
+                    else
+                        BEAST_EXPECT(pos <= expected);
+                }
+            }
+        }
+
+        // narrow range sets select different kernels
+        for(std::size_t size = 2; size <= 8; size += 2)
+        {
+            for(std::size_t n = 0; n <= 72; ++n)
+            {
+                std::string s(n, 'x');
+                if(n > 0)
+                    s[n - 1] = '\0';
+                auto const result = base::find_fast(
+                    s.data(), s.data() + s.size(),
+                    ranges, size);
+                auto const pos = static_cast<std::size_t>(
+                    result.first - s.data());
+                if(result.second)
+                    BEAST_EXPECT(n > 0 && pos == n - 1);
+                else
+                    BEAST_EXPECT(pos <= n);
+            }
+        }
+
+        auto const m =
+            [](std::string const& s)
+            {
+                return "GET / HTTP/1.1\r\n" + s + "\r\n";
+            };
+
+        using P = test_parser<true>;
+
+        for(std::size_t n = 1; n <= 72; n += 7)
+        {
+            std::string const name(n, 'f');
+            parsegrind<P>(m(name + ": v\r\n"));
+            failgrind<P>(m(name + "\x7f: v\r\n"), error::bad_field);
+            failgrind<P>(m(name + " : v\r\n"), error::bad_field);
+            failgrind<P>(m(name + "\xc0" + name + ": v\r\n"),
+                error::bad_field);
+        }
+    }
+
+    void
+    testFindEol()
+    {
+        using base = detail::basic_parser_base;
+
+        for(std::size_t n = 0; n <= 72; ++n)
+        {
+            for(std::size_t i = 0; i <= n; ++i)
+            {
+                // "\r\n" at i
+                {
+                    std::string s(n, 'x');
+                    s.insert(i, "\r\n");
+                    error_code ec;
+                    auto const p = base::find_eol(
+                        s.data(), s.data() + s.size(), ec);
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(p == s.data() + i + 2);
+                }
+                // bare '\r' at i
+                {
+                    std::string s(n, 'x');
+                    s.insert(i, "\rx");
+                    error_code ec;
+                    auto const p = base::find_eol(
+                        s.data(), s.data() + s.size(), ec);
+                    BEAST_EXPECT(ec == error::bad_line_ending);
+                    BEAST_EXPECT(p == nullptr);
+                }
+                // '\n' alone does not end the line
+                {
+                    std::string s(n, 'x');
+                    s.insert(i, "\n");
+                    error_code ec;
+                    auto const p = base::find_eol(
+                        s.data(), s.data() + s.size(), ec);
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(p == nullptr);
+                }
+            }
+            // '\r' is the last octet
+            {
+                std::string s(n, 'x');
+                s.push_back('\r');
+                error_code ec;
+                auto const p = base::find_eol(
+                    s.data(), s.data() + s.size(), ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(p == nullptr);
+            }
+        }
+
+        using P = test_parser<false>;
+
+        // long chunk extensions, values, and targets
+        for(std::size_t n = 1; n <= 72; n += 7)
+        {
+            std::string const ext(n, 'e');
+            std::string const value(n, 'v');
+            parsegrind<P>(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1;" + ext + "=" + value + "\r\n"
+                "*\r\n"
+                "0\r\n"
+                "\r\n");
+            {
+                std::string const s =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n"
+                    "1;" + ext + "\r" + value + "\r\n"
+                    "*\r\n"
+                    "0\r\n"
+                    "\r\n";
+                P p;
+                p.eager(true);
+                error_code ec;
+                std::size_t used = 0;
+                while(! ec && used < s.size())
+                    used += p.put(net::buffer(
+                        s.data() + used, s.size() - used), ec);
+                BEAST_EXPECTS(ec == error::bad_line_ending, ec.message());
+            }
+            parsegrind<P>(
+                "HTTP/1.1 200 OK\r\n"
+                "Set-Cookie: " + value + "\t" + value + "\x80\r\n"
+                "\r\n");
+            failgrind<P>(
+                "HTTP/1.1 200 OK\r\n"
+                "Set-Cookie: " + value + "\x7f\r\n"
+                "\r\n", error::bad_value);
+            failgrind<P>(
+                "HTTP/1.1 200 OK\r\n"
+                "Set-Cookie: " + value + "\x01" + value + "\r\n"
+                "\r\n", error::bad_value);
+            parsegrind<test_parser<true>>(
+                "GET /" + value + "?" + value + " HTTP/1.1\r\n"
+                "\r\n");
+            failgrind<test_parser<true>>(
+                "GET /" + value + "\x7f" + value + " HTTP/1.1\r\n"
+                "\r\n", error::bad_target);
+        }
+    }
+
+    // Feed `s` to a parser `step` octets at a time, keeping
+    // unconsumed octets in front of the next put like `read` does.
+    template<class Parser>
+    static
+    error_code
+    feed(Parser& p, string_view s, std::size_t step)
+    {
+        error_code ec;
+        std::string b;
+        std::size_t pos = 0;
+        while(! p.is_done())
+        {
+            if(pos >= s.size())
+                break;
+            auto const n = (std::min)(step, s.size() - pos);
+            b.append(s.data() + pos, n);
+            pos += n;
+            auto const used = p.put(net::buffer(b), ec);
+            b.erase(0, used);
+            if(ec == error::need_more)
+                continue;
+            if(ec)
+                break;
+        }
+        return ec;
+    }
+
+    void
+    testResume()
+    {
+        std::string const cookie(12000, 'c');
+        std::string const s =
+            "GET /" + std::string(3000, 't') + " HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Cookie: " + cookie + "\r\n"
+            "X-Fold: a\r\n"
+            "  b\r\n"
+            "Content-Length: 1\r\n"
+            "\r\n"
+            "*";
+
+        for(std::size_t step : { 1, 2, 3, 7, 1448, 1460 })
+        {
+            test_parser<true> p;
+            p.eager(true);
+            p.header_limit(32768);
+            auto const ec = feed(p, s, step);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.got_on_field == 4);
+            BEAST_EXPECT(p.fields["Cookie"] == cookie);
+            BEAST_EXPECT(p.fields["X-Fold"] == "a b");
+            BEAST_EXPECT(p.body == "*");
+        }
+
+        // errors are still reported
+        for(std::size_t step : { 1, 1448 })
+        {
+            {
+                test_parser<true> p;
+                p.header_limit(32768);
+                auto const ec = feed(p,
+                    "GET / HTTP/1.1\r\n"
+                    "Cookie: " + cookie + "\x01\r\n"
+                    "\r\n", step);
+                BEAST_EXPECTS(ec == error::bad_value, ec.message());
+            }
+            {
+                test_parser<true> p;
+                p.header_limit(32768);
+                auto const ec = feed(p,
+                    "GET / HTTP/1.1\r\n"
+                    "Cookie: " + cookie + "\r \r\n"
+                    "\r\n", step);
+                BEAST_EXPECTS(ec == error::bad_line_ending, ec.message());
+            }
+            {
+                test_parser<true> p;
+                auto const ec = feed(p,
+                    "GET / HTTP/1.1\r\n"
+                    "Cookie: " + cookie + "\r\n"
+                    "\r\n", step);
+                BEAST_EXPECTS(ec == error::header_limit, ec.message());
+            }
+            {
+                test_parser<false> p;
+                p.header_limit(32768);
+                auto const ec = feed(p,
+                    "HTTP/1.1 200 " + cookie + "\x7f\r\n"
+                    "\r\n", step);
+                BEAST_EXPECTS(ec == error::bad_reason, ec.message());
+            }
+        }
+
+        // input shorter than last time restarts the search
+        {
+            test_parser<true> p;
+            error_code ec;
+            string_view s1 = "GET / HTTP/1.1\r\nHost: localhost";
+            auto const used = p.put(net::buffer(s1.data(), s1.size()), ec);
+            BEAST_EXPECT(ec == error::need_more);
+            BEAST_EXPECT(used == 16);
+            p.put(net::buffer("\r\n", 2), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+        }
+
+        // errors are reported by the octet which causes them
+        auto const check =
+            [&](bool isRequest, std::string const& s, error ev)
+            {
+                for(std::size_t step : { 1, 2, 1448 })
+                {
+                    auto const f =
+                        [&](string_view in)
+                        {
+                            if(isRequest)
+                            {
+                                test_parser<true> p;
+                                p.header_limit(32768);
+                                return feed(p, in, step);
+                            }
+                            test_parser<false> p;
+                            p.header_limit(32768);
+                            return feed(p, in, step);
+                        };
+                    auto ec = f(string_view(s).substr(0, s.size() - 1));
+                    BEAST_EXPECTS(ec == error::need_more, ec.message());
+                    ec = f(s);
+                    BEAST_EXPECTS(ec == ev, ec.message());
+                }
+            };
+        check(true, "GE\x01", error::bad_method);
+        check(true, "GET\t", error::bad_method);
+        check(true, "GET \x01", error::bad_target);
+        check(true, "GET  ", error::bad_target);
+        check(true, "GET /" + cookie + "\x7f", error::bad_target);
+        check(true, "GET / X", error::bad_version);
+        check(true, "GET / HTTP/2", error::bad_version);
+        check(true, "GET / HTTP/1.2", error::bad_version);
+        check(true, "GET / HTTP/1.1 ", error::bad_version);
+        check(true, "GET / HTTP/1.1\r\r", error::bad_version);
+        check(false, "HTTP/1.1x", error::bad_version);
+        check(false, "HTTP/1.1 2x", error::bad_status);
+        check(false, "HTTP/1.1 2000", error::bad_status);
+        check(false, "HTTP/1.1 200 " + cookie + "\x01", error::bad_reason);
+        check(false, "HTTP/1.1 200 OK\n", error::bad_reason);
+        check(false, "HTTP/1.1 200 OK\r\r", error::bad_line_ending);
+        check(true, "GET / HTTP/1.1\r\nNa\x01", error::bad_field);
+        check(true, "GET / HTTP/1.1\r\n:", error::bad_field);
+        check(true, "GET / HTTP/1.1\r\n ", error::bad_field);
+        check(true, "GET / HTTP/1.1\r\n\r\r", error::bad_line_ending);
+        check(true, "GET / HTTP/1.1\r\n"
+            "Cookie: " + cookie + "\x01", error::bad_value);
+        check(true, "GET / HTTP/1.1\r\n"
+            "Cookie: v\r\r", error::bad_line_ending);
+        check(true, "GET / HTTP/1.1\r\n"
+            "Cookie: v\r\n \x7f", error::bad_value);
+        check(true, "GET / HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Cookie: v\r\nX\x01", error::bad_field);
+    }
+
     void
     testConnectionField()
     {
@@ -1605,6 +1964,9 @@ public:
         testRequestLine();
         testStatusLine();
         testFields();
+        testFindFast();
+        testFindEol();
+        testResume();
         testConnectionField();
         testContentLengthField();
         testTransferEncodingField();
@@ -0,0 +1,480 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/deflate_body.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/buffer_body.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class deflate_body_test : public beast::unit_test::suite
+{
+public:
+    struct visit
+    {
+        std::string& s;
+        std::size_t& n;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&, ConstBufferSequence const& buffers)
+        {
+            n = buffer_bytes(buffers);
+            s.append(buffers_to_string(buffers));
+        }
+    };
+
+    template<bool isRequest, class Body, class Fields>
+    std::string
+    to_string(message<isRequest, Body, Fields>& m)
+    {
+        std::string s;
+        serializer<isRequest, Body, Fields> sr{m};
+        error_code ec;
+        while(! sr.is_done())
+        {
+            std::size_t n = 0;
+            sr.next(ec, visit{s, n});
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            sr.consume(n);
+        }
+        return s;
+    }
+
+    // Feed the wire format to a parser in pieces of at most n
+    template<class Parser>
+    void
+    feed(Parser& p, string_view s, std::size_t n, error_code& ec)
+    {
+        while(! s.empty())
+        {
+            auto const used = p.put(net::const_buffer(
+                s.data(), (std::min)(n, s.size())), ec);
+            s.remove_prefix(used);
+            if(ec == error::need_more)
+            {
+                if(used == 0)
+                {
+                    if(n >= s.size())
+                        return;
+                    n += 64;
+                }
+                ec = {};
+                continue;
+            }
+            if(ec)
+                return;
+        }
+    }
+
+    // Decode the payload of the wire format on its own
+    std::string
+    decode(string_view wire, zlib::Format format)
+    {
+        request_parser<string_body> p;
+        p.body_limit(boost::none);
+        error_code ec;
+        feed(p, wire, wire.size(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        auto const& in = p.get().body();
+
+        std::string out(in.size() * 20 + 1024, '\0');
+        zlib::inflate_stream is;
+        is.reset(15, format);
+        zlib::z_params zs;
+        zs.next_in = in.data();
+        zs.avail_in = in.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        is.write(zs, zlib::Flush::finish, ec);
+        BEAST_EXPECTS(ec == zlib::error::end_of_stream, ec.message());
+        BEAST_EXPECT(zs.avail_in == 0);
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    static
+    std::string
+    make_body(std::size_t n)
+    {
+        // compressible, but not trivially
+        std::mt19937 g;
+        std::string s;
+        s.reserve(n);
+        while(s.size() < n)
+            s.push_back("abcdefgh"[g() % 8]);
+        return s;
+    }
+
+    template<class Body>
+    void
+    doRoundTrip(zlib::Format format, std::string const& body)
+    {
+        request<Body> req{verb::post, "/", 11};
+        req.set(field::content_encoding,
+            format == zlib::Format::gzip ? "gzip" : "deflate");
+        req.body() = body;
+        req.prepare_payload();
+        BEAST_EXPECT(req.chunked());
+        auto const wire = to_string(req);
+        BEAST_EXPECT(decode(wire, format) == body);
+
+        for(std::size_t n : { 1, 7, 1000, 1000000 })
+        {
+            request_parser<Body> p;
+            p.body_limit(boost::none);
+            error_code ec;
+            feed(p, wire, n, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.get().body() == body);
+        }
+    }
+
+    void
+    testRoundTrip()
+    {
+        for(std::size_t n : { 0, 1, 100, 8192, 100000 })
+        {
+            auto const body = make_body(n);
+            doRoundTrip<deflate_body<string_body>>(
+                zlib::Format::zlib, body);
+            doRoundTrip<gzip_body<string_body>>(
+                zlib::Format::gzip, body);
+        }
+    }
+
+    void
+    testBufferBody()
+    {
+        // compress a body supplied in pieces
+        auto const body = make_body(20000);
+        request<gzip_body<buffer_body>> req{verb::post, "/", 11};
+        req.set(field::content_encoding, "gzip");
+        req.chunked(true);
+        serializer<true, gzip_body<buffer_body>> sr{req};
+        std::string wire;
+        std::size_t pos = 0;
+        error_code ec;
+        while(! sr.is_done())
+        {
+            if(! req.body().more && pos < body.size())
+            {
+                auto const n = (std::min<std::size_t>)(
+                    3000, body.size() - pos);
+                req.body().data = const_cast<char*>(&body[pos]);
+                req.body().size = n;
+                pos += n;
+                req.body().more = pos < body.size();
+            }
+            std::size_t n = 0;
+            sr.next(ec, visit{wire, n});
+            if(ec == error::need_buffer)
+            {
+                // what was supplied so far has been flushed
+                BEAST_EXPECT(string_view(wire).ends_with(
+                    string_view("\x00\x00\xff\xff\r\n", 6)));
+                req.body().more = false;
+                ec = {};
+                continue;
+            }
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            sr.consume(n);
+        }
+        BEAST_EXPECT(pos == body.size());
+        BEAST_EXPECT(decode(wire, zlib::Format::gzip) == body);
+
+        // decompress into a small buffer
+        request_parser<gzip_body<buffer_body>> p;
+        feed(p, wire.substr(0, wire.find("\r\n\r\n") + 4), 1000, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_header_done());
+        std::string s;
+        string_view in(wire);
+        in.remove_prefix(wire.find("\r\n\r\n") + 4);
+        char buf[1000];
+        while(! p.is_done())
+        {
+            p.get().body().data = buf;
+            p.get().body().size = sizeof(buf);
+            auto const used = p.put(
+                net::const_buffer(in.data(), in.size()), ec);
+            in.remove_prefix(used);
+            s.append(buf, sizeof(buf) - p.get().body().size);
+            if(ec == error::need_buffer)
+            {
+                ec = {};
+                continue;
+            }
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+        }
+        BEAST_EXPECT(s == body);
+    }
+
+    void
+    testPendingOutput()
+    {
+        auto const body = make_body(50000);
+        request<deflate_body<string_body>> req{verb::post, "/", 11};
+        req.body() = body;
+        req.prepare_payload();
+        auto const chunked = to_string(req);
+
+        // the same payload with a Content-Length
+        request<string_body> req2{verb::post, "/", 11};
+        {
+            request_parser<string_body> p;
+            p.body_limit(boost::none);
+            error_code ec;
+            feed(p, chunked, chunked.size(), ec);
+            req2.body() = p.get().body();
+        }
+        req2.prepare_payload();
+        auto const sized = to_string(req2);
+
+        // The wrapped reader takes a few octets at a time. Octets
+        // the parser saw consumed must never be presented again.
+        for(auto const& wire : { chunked, sized })
+        for(std::size_t size : { 1, 7, 5000 })
+        {
+            auto const header_size = wire.find("\r\n\r\n") + 4;
+            request_parser<deflate_body<buffer_body>> p;
+            error_code ec;
+            feed(p, wire.substr(0, header_size), 1000, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            std::string s;
+            string_view in(wire);
+            in.remove_prefix(header_size);
+            std::vector<char> buf(size);
+            std::size_t calls = 0;
+            while(! p.is_done() && ++calls < 1000000)
+            {
+                p.get().body().data = buf.data();
+                p.get().body().size = buf.size();
+                auto const used = p.put(
+                    net::const_buffer(in.data(), in.size()), ec);
+                in.remove_prefix(used);
+                s.append(buf.data(), buf.size() - p.get().body().size);
+                if(ec == error::need_buffer)
+                {
+                    ec = {};
+                    continue;
+                }
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    break;
+            }
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(in.empty());
+            BEAST_EXPECT(s == body);
+        }
+    }
+
+    void
+    testSettings()
+    {
+        auto const body = make_body(100000);
+        auto const encode =
+            [&](int level, int window_bits)
+            {
+                request<deflate_body<string_body>> req{verb::post, "/", 11};
+                req.body() = body;
+                req.body().level = level;
+                req.body().window_bits = window_bits;
+                req.prepare_payload();
+                return to_string(req);
+            };
+        auto const payload =
+            [&](std::string const& wire)
+            {
+                request_parser<string_body> p;
+                p.body_limit(boost::none);
+                error_code ec;
+                feed(p, wire, wire.size(), ec);
+                return p.get().body();
+            };
+
+        // level 0 stores the payload
+        auto const stored = encode(0, 15);
+        auto const compressed = encode(9, 15);
+        BEAST_EXPECT(decode(stored, zlib::Format::zlib) == body);
+        BEAST_EXPECT(decode(compressed, zlib::Format::zlib) == body);
+        BEAST_EXPECT(payload(stored).size() > body.size());
+        BEAST_EXPECT(payload(compressed).size() < body.size());
+
+        // the window size is recorded in the zlib header
+        auto const small = payload(encode(6, 9));
+        BEAST_EXPECT(static_cast<unsigned char>(small[0]) == 0x18);
+        BEAST_EXPECT(decode(encode(6, 9), zlib::Format::zlib) == body);
+        BEAST_EXPECT(static_cast<unsigned char>(
+            payload(compressed)[0]) == 0x78);
+    }
+
+    void
+    testDecodedLimit()
+    {
+        // a small message which expands a lot
+        std::string const body(1000000, 'x');
+        request<gzip_body<string_body>> req{verb::post, "/", 11};
+        req.body() = body;
+        req.prepare_payload();
+        auto const wire = to_string(req);
+        BEAST_EXPECT(wire.size() < 10000);
+
+        {
+            request_parser<gzip_body<string_body>> p;
+            p.get().body().decoded_limit = body.size() - 1;
+            error_code ec;
+            feed(p, wire, 1000, ec);
+            BEAST_EXPECTS(ec == error::body_limit, ec.message());
+            BEAST_EXPECT(p.get().body().size() < body.size());
+        }
+        {
+            request_parser<gzip_body<string_body>> p;
+            p.get().body().decoded_limit = body.size();
+            error_code ec;
+            feed(p, wire, 1000, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.get().body() == body);
+        }
+    }
+
+    void
+    testErrors()
+    {
+        auto const body = make_body(5000);
+        std::string wire;
+        {
+            request<gzip_body<string_body>> req{verb::post, "/", 11};
+            req.body() = body;
+            req.prepare_payload();
+            wire = to_string(req);
+        }
+        auto const payload = [&]
+            {
+                request_parser<string_body> p;
+                error_code ec;
+                feed(p, wire, wire.size(), ec);
+                return p.get().body();
+            }();
+        auto const make_wire =
+            [](std::string const& encoded)
+            {
+                request<string_body> req{verb::post, "/", 11};
+                req.body() = encoded;
+                req.prepare_payload();
+                return req;
+            };
+
+        // concatenated gzip members
+        {
+            auto req = make_wire(payload + payload);
+            request_parser<gzip_body<string_body>> p;
+            error_code ec;
+            auto const s = to_string(req);
+            feed(p, s, 100, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.get().body() == body + body);
+        }
+
+        // truncated
+        {
+            auto req = make_wire(payload.substr(0, payload.size() - 1));
+            request_parser<gzip_body<string_body>> p;
+            error_code ec;
+            auto const s = to_string(req);
+            feed(p, s, 100, ec);
+            BEAST_EXPECTS(ec == error::partial_message, ec.message());
+        }
+
+        // corrupt
+        {
+            auto corrupt = payload;
+            corrupt[corrupt.size() - 6] ^= 1;
+            auto req = make_wire(corrupt);
+            request_parser<gzip_body<string_body>> p;
+            error_code ec;
+            auto const s = to_string(req);
+            feed(p, s, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::invalid_data_check,
+                ec.message());
+        }
+
+        // wrong format
+        {
+            auto req = make_wire(payload);
+            request_parser<deflate_body<string_body>> p;
+            error_code ec;
+            auto const s = to_string(req);
+            feed(p, s, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::invalid_header_check,
+                ec.message());
+        }
+
+        // data after the zlib stream
+        {
+            request<deflate_body<string_body>> req{verb::post, "/", 11};
+            req.body() = body;
+            req.prepare_payload();
+            auto const zwire = to_string(req);
+            request_parser<string_body> p0;
+            error_code ec;
+            feed(p0, zwire, zwire.size(), ec);
+            auto req2 = make_wire(p0.get().body() + "x");
+            request_parser<deflate_body<string_body>> p;
+            auto const s = to_string(req2);
+            feed(p, s, 100, ec);
+            BEAST_EXPECTS(ec == zlib::error::stream_error, ec.message());
+        }
+
+        // empty payload
+        {
+            auto req = make_wire("");
+            request_parser<gzip_body<string_body>> p;
+            error_code ec;
+            auto const s = to_string(req);
+            feed(p, s, s.size(), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.is_done());
+            BEAST_EXPECT(p.get().body().empty());
+        }
+    }
+
+    void
+    run() override
+    {
+        testRoundTrip();
+        testBufferBody();
+        testPendingOutput();
+        testSettings();
+        testDecodedLimit();
+        testErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,deflate_body);
+
+} // http
+} // beast
+} // boost
@@ -11,6 +11,8 @@
 #include <boost/beast/http/field.hpp>
 
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <cctype>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -397,11 +399,50 @@ public:
             };
         unknown("");
         unknown("x");
+        unknown("Content\rLength");
+        unknown("Content-Length\r");
+        unknown("Acc\xc5pt");
+        unknown(string_view("Accept\0", 7));
+        unknown("X-Device-Accept-Encodin");
+        unknown("X-Device-Accept-Encodingg");
+    }
+
+    void
+    testAllFields()
+    {
+        for(unsigned i = 1; i < 357; ++i)
+        {
+            auto const f = static_cast<field>(i);
+            std::string s(to_string(f));
+            BEAST_EXPECT(string_to_field(s) == f);
+            for(auto& c : s)
+                c = static_cast<char>(std::tolower(
+                    static_cast<unsigned char>(c)));
+            BEAST_EXPECT(string_to_field(s) == f);
+            for(auto& c : s)
+                c = static_cast<char>(std::toupper(
+                    static_cast<unsigned char>(c)));
+            BEAST_EXPECT(string_to_field(s) == f);
+            for(std::size_t j = 0; j < s.size(); ++j)
+            {
+                auto s2 = s;
+                s2[j] = '_';
+                BEAST_EXPECT(string_to_field(s2) == field::unknown);
+                s2[j] = static_cast<char>(s[j] ^ 0x20);
+                if(! std::isalpha(static_cast<unsigned char>(s[j])))
+                    BEAST_EXPECT(string_to_field(s2) == field::unknown);
+            }
+            auto const f2 = string_to_field(
+                string_view(s).substr(0, s.size() - 1));
+            BEAST_EXPECT(f2 == field::unknown || iequals(
+                to_string(f2), string_view(s).substr(0, s.size() - 1)));
+        }
     }
 
     void run() override
     {
         testField();
+        testAllFields();
         pass();
     }
 };
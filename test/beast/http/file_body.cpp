@@ -10,18 +10,29 @@
 // Test that header file is self-contained.
 #include <boost/beast/http/file_body.hpp>
 
+#include <boost/beast/core/basic_stream.hpp>
 #include <boost/beast/core/buffer_traits.hpp>
 #include <boost/beast/core/buffers_prefix.hpp>
+#include <boost/beast/core/error.hpp>
 #include <boost/beast/core/file_stdio.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/static_string.hpp>
 #include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/read.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <limits>
+#include <thread>
 
 namespace boost {
 namespace beast {
@@ -292,6 +303,276 @@ public:
         }
     }
 
+#if BOOST_BEAST_USE_POSIX_SENDFILE && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    // Grants a fixed number of bytes per write and records the transfers
+    class counting_rate_policy
+    {
+        friend class beast::rate_policy_access;
+
+        std::size_t
+        available_read_bytes() const noexcept
+        {
+            return (std::numeric_limits<std::size_t>::max)();
+        }
+
+        std::size_t
+        available_write_bytes() const noexcept
+        {
+            return limit;
+        }
+
+        void
+        transfer_read_bytes(std::size_t) noexcept
+        {
+        }
+
+        void
+        transfer_write_bytes(std::size_t n) noexcept
+        {
+            written += n;
+            largest = (std::max)(largest, n);
+        }
+
+        void
+        on_timer() noexcept
+        {
+        }
+
+    public:
+        std::size_t limit = 16384;
+        std::size_t written = 0;
+        std::size_t largest = 0;
+    };
+
+    void
+    testSendfile()
+    {
+        using socket_type = net::local::stream_protocol::socket;
+
+        auto temp = temp_file(log);
+        std::string contents;
+        for(std::size_t i = 0; i < 100000; ++i)
+            contents.push_back(static_cast<char>('a' + (i * 7) % 26));
+        {
+            std::ofstream fstemp(temp.path().native(), std::ios::binary);
+            fstemp << contents;
+            fstemp.close();
+        }
+
+        auto const make_response =
+            [&](bool chunked, std::uint64_t offset)
+            {
+                response<file_body> res{status::ok, 11};
+                res.set(field::server, "test");
+                error_code ec;
+                res.body().open(temp.path().string<std::string>().c_str(),
+                    file_mode::scan, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                res.body().seek(offset, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                if(chunked)
+                    res.chunked(true);
+                else
+                    res.prepare_payload();
+                return res;
+            };
+
+        for(bool chunked : { false, true })
+        {
+            // synchronous
+            {
+                net::io_context ioc;
+                socket_type s1(ioc);
+                socket_type s2(ioc);
+                net::local::connect_pair(s1, s2);
+                auto res = make_response(chunked, 5);
+                error_code ec1;
+                std::thread t(
+                    [&]
+                    {
+                        write(s1, res, ec1);
+                    });
+                flat_buffer b;
+                response<string_body> m;
+                error_code ec;
+                read(s2, b, m, ec);
+                t.join();
+                BEAST_EXPECTS(! ec1, ec1.message());
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(m.chunked() == chunked);
+                BEAST_EXPECT(m.body() == contents.substr(5));
+            }
+
+            // asynchronous
+            {
+                net::io_context ioc;
+                socket_type s1(ioc);
+                socket_type s2(ioc);
+                net::local::connect_pair(s1, s2);
+                auto res = make_response(chunked, 0);
+                error_code ec1;
+                error_code ec2;
+                std::size_t n1 = 0;
+                async_write(s1, res,
+                    [&](error_code ec, std::size_t n)
+                    {
+                        ec1 = ec;
+                        n1 = n;
+                    });
+                flat_buffer b;
+                response<string_body> m;
+                async_read(s2, b, m,
+                    [&](error_code ec, std::size_t)
+                    {
+                        ec2 = ec;
+                    });
+                ioc.run();
+                BEAST_EXPECTS(! ec1, ec1.message());
+                BEAST_EXPECTS(! ec2, ec2.message());
+                BEAST_EXPECT(n1 > contents.size());
+                BEAST_EXPECT(m.chunked() == chunked);
+                BEAST_EXPECT(m.body() == contents);
+            }
+        }
+
+        // basic_stream applies its rate policy to sendfile
+        for(bool chunked : { false, true })
+        {
+            using stream_type = basic_stream<
+                net::local::stream_protocol,
+                net::any_io_executor,
+                counting_rate_policy>;
+
+            net::io_context ioc;
+            socket_type s1(ioc);
+            socket_type s2(ioc);
+            net::local::connect_pair(s1, s2);
+            stream_type stream(std::move(s1));
+            auto res = make_response(chunked, 0);
+            error_code ec1;
+            error_code ec2;
+            std::size_t n1 = 0;
+            async_write(stream, res,
+                [&](error_code ec, std::size_t n)
+                {
+                    ec1 = ec;
+                    n1 = n;
+                });
+            flat_buffer b;
+            response<string_body> m;
+            async_read(s2, b, m,
+                [&](error_code ec, std::size_t)
+                {
+                    ec2 = ec;
+                });
+            ioc.run();
+            BEAST_EXPECTS(! ec1, ec1.message());
+            BEAST_EXPECTS(! ec2, ec2.message());
+            BEAST_EXPECT(m.body() == contents);
+            auto const& policy = stream.rate_policy();
+            BEAST_EXPECT(policy.written == n1);
+            BEAST_EXPECT(policy.largest <= policy.limit);
+            // the buffered path writes at most one 4KB block at a time
+            if(! chunked)
+                BEAST_EXPECT(policy.largest > 8192);
+        }
+
+        // basic_stream applies its write timeout to sendfile
+        {
+            auto big = temp_file(log);
+            {
+                std::ofstream fstemp(big.path().native(), std::ios::binary);
+                fstemp << std::string(8 * 1024 * 1024, 'x');
+            }
+
+            net::io_context ioc;
+            socket_type s1(ioc);
+            socket_type s2(ioc);
+            net::local::connect_pair(s1, s2);
+            basic_stream<net::local::stream_protocol> stream(std::move(s1));
+            response<file_body> res{status::ok, 11};
+            error_code ec;
+            res.body().open(big.path().string<std::string>().c_str(),
+                file_mode::scan, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            res.prepare_payload();
+            stream.expires_after(std::chrono::milliseconds(100));
+            error_code ec1;
+            async_write(stream, res,
+                [&](error_code ec, std::size_t)
+                {
+                    ec1 = ec;
+                });
+            ioc.run();
+            BEAST_EXPECTS(ec1 == beast::error::timeout, ec1.message());
+        }
+
+        // the caller's split setting is kept
+        for(bool split : { false, true })
+        {
+            net::io_context ioc;
+            socket_type s1(ioc);
+            socket_type s2(ioc);
+            net::local::connect_pair(s1, s2);
+            auto res = make_response(false, contents.size() - 10);
+            serializer<false, file_body> sr{res};
+            sr.split(split);
+            error_code ec;
+            write_some(s1, sr, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(sr.is_header_done());
+            BEAST_EXPECT(sr.split() == split);
+            write(s1, sr, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            flat_buffer b;
+            response<string_body> m;
+            read(s2, b, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.body() == contents.substr(contents.size() - 10));
+        }
+
+        // reset and seek leave no range behind on failure
+        {
+            file_body::value_type v;
+            error_code ec;
+            v.reset(file_posix{}, ec);
+            BEAST_EXPECT(ec);
+            BEAST_EXPECT(v.size() == 0);
+
+            v.open(temp.path().string<std::string>().c_str(),
+                file_mode::scan, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == contents.size());
+            v.seek(static_cast<std::uint64_t>(-1), ec);
+            BEAST_EXPECT(ec);
+            BEAST_EXPECT(v.size() == contents.size());
+
+            v.reset(file_posix{}, ec);
+            BEAST_EXPECT(ec);
+            BEAST_EXPECT(! v.is_open());
+            BEAST_EXPECT(v.size() == 0);
+        }
+
+        // empty body
+        {
+            net::io_context ioc;
+            socket_type s1(ioc);
+            socket_type s2(ioc);
+            net::local::connect_pair(s1, s2);
+            auto res = make_response(false, contents.size());
+            BEAST_EXPECT(res.body().size() == 0);
+            error_code ec;
+            write(s1, res, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            flat_buffer b;
+            response<string_body> m;
+            read(s2, b, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.body().empty());
+        }
+    }
+#endif
+
     void
     run() override
     {
@@ -322,6 +603,10 @@ public:
         readPartialFile<file_win32, false>();
 #endif
 
+#if BOOST_BEAST_USE_POSIX_SENDFILE && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        testSendfile();
+#endif
+
     }
 };
 
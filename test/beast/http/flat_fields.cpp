@@ -0,0 +1,568 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/flat_fields.hpp>
+
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/type_traits.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/test/test_allocator.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <random>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class flat_fields_test : public beast::unit_test::suite
+{
+public:
+    BOOST_STATIC_ASSERT(is_fields<flat_fields>::value);
+
+    BOOST_STATIC_ASSERT(std::is_nothrow_move_constructible<flat_fields>::value);
+    BOOST_STATIC_ASSERT(std::is_nothrow_move_assignable<flat_fields>::value);
+
+    template<class Fields>
+    static
+    std::string
+    str(Fields const& f)
+    {
+        std::string s;
+        for(auto const& e : f)
+        {
+            s.append(e.name_string().data(), e.name_string().size());
+            s.push_back('=');
+            s.append(e.value().data(), e.value().size());
+            s.push_back(';');
+        }
+        return s;
+    }
+
+    template<class Fields>
+    static
+    std::size_t
+    size(Fields const& f)
+    {
+        return std::distance(f.begin(), f.end());
+    }
+
+    // Returns the serialized fields
+    template<class Fields>
+    static
+    std::string
+    wire(Fields const& f)
+    {
+        typename Fields::writer w(f);
+        return buffers_to_string(w.get());
+    }
+
+    void
+    testMembers()
+    {
+        using namespace test;
+
+        // compare equal
+        using equal_t = test::test_allocator<char,
+            true, true, true, true, true>;
+
+        // compare not equal
+        using unequal_t = test::test_allocator<char,
+            false, true, true, true, true>;
+
+        // construction
+        {
+            flat_fields f;
+            BEAST_EXPECT(f.begin() == f.end());
+            BEAST_EXPECT(f.empty());
+        }
+        {
+            unequal_t a1;
+            basic_flat_fields<unequal_t> f{a1};
+            BEAST_EXPECT(f.get_allocator() == a1);
+            BEAST_EXPECT(f.get_allocator() != unequal_t{});
+        }
+
+        // move construction
+        {
+            basic_flat_fields<equal_t> f1;
+            f1.insert("1", "1");
+            basic_flat_fields<equal_t> f2{std::move(f1)};
+            BEAST_EXPECT(f2.get_allocator()->nmove == 1);
+            BEAST_EXPECT(f2["1"] == "1");
+            BEAST_EXPECT(f1["1"] == "");
+            BEAST_EXPECT(f1.empty());
+        }
+        {
+            basic_flat_fields<unequal_t> f1;
+            f1.insert("1", "1");
+            unequal_t a;
+            basic_flat_fields<unequal_t> f2{std::move(f1), a};
+            BEAST_EXPECT(f2["1"] == "1");
+            BEAST_EXPECT(f2.get_allocator() == a);
+        }
+
+        // copy construction
+        {
+            basic_flat_fields<equal_t> f1;
+            f1.insert("1", "1");
+            f1.insert("2", "2");
+            basic_flat_fields<equal_t> f2{f1};
+            BEAST_EXPECT(str(f1) == str(f2));
+            BEAST_EXPECT(wire(f1) == wire(f2));
+            f1.set("1", "x");
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+        {
+            basic_flat_fields<unequal_t> f1;
+            f1.insert("1", "1");
+            unequal_t a;
+            basic_flat_fields<unequal_t> f2(f1, a);
+            BEAST_EXPECT(f2.get_allocator() == a);
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+        {
+            basic_flat_fields<equal_t> f1;
+            f1.insert("1", "1");
+            flat_fields f2(f1);
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+
+        // move assignment
+        {
+            basic_flat_fields<equal_t> f1;
+            f1.insert("1", "1");
+            basic_flat_fields<equal_t> f2;
+            f2.insert("2", "2");
+            f2 = std::move(f1);
+            BEAST_EXPECT(f1.empty());
+            BEAST_EXPECT(f2["1"] == "1");
+            BEAST_EXPECT(f2.count("2") == 0);
+        }
+        {
+            // allocators unequal, no propagation
+            using na_t = test::test_allocator<char,
+                false, true, false, true, true>;
+            basic_flat_fields<na_t> f1;
+            f1.insert("1", "1");
+            basic_flat_fields<na_t> f2;
+            f2 = std::move(f1);
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+
+        // copy assignment
+        {
+            basic_flat_fields<unequal_t> f1;
+            f1.insert("1", "1");
+            basic_flat_fields<unequal_t> f2;
+            f2.insert("2", "2");
+            f2 = f1;
+            BEAST_EXPECT(f1["1"] == "1");
+            BEAST_EXPECT(f2["1"] == "1");
+            BEAST_EXPECT(f2.count("2") == 0);
+            auto& f3 = f2;
+            f2 = f3;
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+        {
+            basic_flat_fields<equal_t> f1;
+            f1.insert("1", "1");
+            flat_fields f2;
+            f2 = f1;
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+
+        // swap
+        {
+            flat_fields f1;
+            f1.insert("1", "1");
+            flat_fields f2;
+            f2.insert("2", "2");
+            swap(f1, f2);
+            BEAST_EXPECT(f1["2"] == "2");
+            BEAST_EXPECT(f2["1"] == "1");
+        }
+    }
+
+    void
+    testContainer()
+    {
+        flat_fields f;
+        f.insert(field::host, "example.com");
+        f.insert("X-One", "1");
+        f.insert(field::accept, "text/html");
+        f.insert("x-one", "2");
+        f.insert("ACCEPT", "*/*");
+        f.insert("Accept", "image/png");
+        BEAST_EXPECT(size(f) == 6);
+        BEAST_EXPECT(str(f) ==
+            "Host=example.com;"
+            "X-One=1;x-one=2;"
+            "Accept=text/html;ACCEPT=*/*;Accept=image/png;");
+        BEAST_EXPECT(wire(f) ==
+            "Host: example.com\r\n"
+            "X-One: 1\r\nx-one: 2\r\n"
+            "Accept: text/html\r\nACCEPT: */*\r\nAccept: image/png\r\n"
+            "\r\n");
+
+        // lookup
+        BEAST_EXPECT(f.count(field::accept) == 3);
+        BEAST_EXPECT(f.count("aCCEPT") == 3);
+        BEAST_EXPECT(f.count("X-ONE") == 2);
+        BEAST_EXPECT(f.count("x-two") == 0);
+        BEAST_EXPECT(f.count(field::server) == 0);
+        BEAST_EXPECT(f[field::accept] == "text/html");
+        BEAST_EXPECT(f["x-ONE"] == "1");
+        BEAST_EXPECT(f[field::server].empty());
+        BEAST_EXPECT(f.at(field::host) == "example.com");
+        BEAST_EXPECT(f.at("X-One") == "1");
+        BEAST_THROWS(f.at(field::server), std::out_of_range);
+        BEAST_THROWS(f.at("x-two"), std::out_of_range);
+        BEAST_EXPECT(f.find("nothing") == f.end());
+        BEAST_EXPECT(f.find(field::host)->name() == field::host);
+        BEAST_EXPECT(f.find("x-one")->name() == field::unknown);
+        {
+            auto const r = f.equal_range(field::accept);
+            BEAST_EXPECT(std::distance(r.first, r.second) == 3);
+            BEAST_EXPECT(r.first->value() == "text/html");
+            BEAST_EXPECT(std::prev(r.second)->value() == "image/png");
+            auto const r2 = f.equal_range("server");
+            BEAST_EXPECT(r2.first == r2.second);
+        }
+
+        // set replaces every instance and appends
+        f.set("X-ONE", "3");
+        BEAST_EXPECT(str(f) ==
+            "Host=example.com;"
+            "Accept=text/html;ACCEPT=*/*;Accept=image/png;"
+            "X-ONE=3;");
+
+        // erase
+        BEAST_EXPECT(f.erase(field::accept) == 3);
+        BEAST_EXPECT(f.erase("accept") == 0);
+        BEAST_EXPECT(str(f) == "Host=example.com;X-ONE=3;");
+        {
+            auto it = f.erase(f.begin());
+            BEAST_EXPECT(it == f.begin());
+            BEAST_EXPECT(it->name_string() == "X-ONE");
+            it = f.erase(it);
+            BEAST_EXPECT(it == f.end());
+            BEAST_EXPECT(f.empty());
+        }
+
+        // whitespace is trimmed, empty values are kept
+        f.insert("a", "  value\t ");
+        f.set("b", "");
+        BEAST_EXPECT(f["a"] == "value");
+        BEAST_EXPECT(f.find("b") != f.end());
+        BEAST_EXPECT(f.find("b")->value().empty());
+
+        // values taken from the container itself
+        f.insert(field::user_agent, std::string(600, 'u'));
+        for(int i = 0; i < 4; ++i)
+            f.insert("c", f[field::user_agent]);
+        f.set(field::user_agent, f["a"]);
+        f.set("a", f.begin()->name_string());
+        BEAST_EXPECT(f[field::user_agent] == "value");
+        BEAST_EXPECT(f["a"] == "a");
+        BEAST_EXPECT(f.count("c") == 4);
+        BEAST_EXPECT(f["c"] == std::string(600, 'u'));
+
+        // clear keeps the start line
+        f.clear();
+        BEAST_EXPECT(f.empty());
+        BEAST_EXPECT(wire(f) == "\r\n");
+
+        // limits
+        {
+            std::string const big(flat_fields::max_value_size + 1, 'v');
+            error_code ec;
+            f.insert(field::unknown, "x", big, ec);
+            BEAST_EXPECT(ec == error::header_field_value_too_large);
+            f.insert(field::unknown, big, "x", ec);
+            BEAST_EXPECT(ec == error::header_field_name_too_large);
+            BEAST_THROWS(f.insert("x", big), system_error);
+            BEAST_THROWS(f.set(field::age, big), system_error);
+            BEAST_EXPECT(f.empty());
+            f.insert(field::unknown, "x",
+                big.substr(1), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(f["x"].size() == flat_fields::max_value_size);
+        }
+    }
+
+    // Apply the same random operations to basic_fields
+    // and basic_flat_fields and compare the results.
+    void
+    testRandom()
+    {
+        static string_view const names[] = {
+            "Host", "ACCEPT", "accept", "Cookie", "Set-Cookie",
+            "X-A", "x-a", "X-B", "Content-Length", "X-Longer-Name",
+            "Transfer-Encoding", "connection", "X-A1", "X-B1" };
+        std::mt19937 g;
+        for(int round = 0; round < 50; ++round)
+        {
+            fields f0;
+            flat_fields f1;
+            for(int i = 0; i < 200; ++i)
+            {
+                auto const name = names[g() % (sizeof(names) / sizeof(names[0]))];
+                auto const value = std::string(g() % 40, 'a' + g() % 26);
+                switch(g() % 6)
+                {
+                case 0:
+                case 1:
+                case 2:
+                    f0.insert(name, value);
+                    f1.insert(name, value);
+                    break;
+                case 3:
+                    f0.set(name, value);
+                    f1.set(name, value);
+                    break;
+                case 4:
+                    BEAST_EXPECT(f0.erase(name) == f1.erase(name));
+                    break;
+                case 5:
+                {
+                    auto const n = size(f0);
+                    if(n == 0)
+                        break;
+                    auto const k = g() % n;
+                    f0.erase(std::next(f0.begin(), k));
+                    f1.erase(std::next(f1.begin(), k));
+                    break;
+                }
+                }
+                for(auto name2 : names)
+                {
+                    BEAST_EXPECT(f0.count(name2) == f1.count(name2));
+                    BEAST_EXPECT(f0[name2] == f1[name2]);
+                    auto const r0 = f0.equal_range(name2);
+                    auto const r1 = f1.equal_range(name2);
+                    BEAST_EXPECT(
+                        std::distance(f0.begin(), r0.first) ==
+                        std::distance(f1.begin(), r1.first));
+                    BEAST_EXPECT(
+                        std::distance(r0.first, r0.second) ==
+                        std::distance(r1.first, r1.second));
+                }
+                if(! BEAST_EXPECT(str(f0) == str(f1)))
+                    return;
+            }
+            BEAST_EXPECT(wire(f0) == wire(f1));
+        }
+    }
+
+    struct visit
+    {
+        std::string& s;
+        std::size_t& n;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&, ConstBufferSequence const& buffers)
+        {
+            s.append(buffers_to_string(buffers));
+            n = buffer_bytes(buffers);
+        }
+    };
+
+    // Serialize a complete message
+    template<bool isRequest, class Fields>
+    static
+    std::string
+    to_string(message<isRequest, string_body, Fields> const& m)
+    {
+        std::string s;
+        serializer<isRequest, string_body, Fields> sr{m};
+        error_code ec;
+        while(! sr.is_done())
+        {
+            std::size_t n = 0;
+            sr.next(ec, visit{s, n});
+            if(ec)
+                break;
+            sr.consume(n);
+        }
+        return s;
+    }
+
+    void
+    testMessage()
+    {
+        {
+            request<string_body, flat_fields> req;
+            request<string_body> req0;
+            auto const build =
+                [](request_header<flat_fields>& h)
+                {
+                    h.method_string("CUSTOM");
+                    h.target("/");
+                    h.set(field::host, "localhost");
+                    h.set(field::user_agent, "test");
+                    h.method(verb::post);
+                    h.target("/path/to/a/rather/long/target?with=query");
+                };
+            build(req);
+            req.body() = "hello";
+            req.prepare_payload();
+            req0.method(verb::post);
+            req0.target("/path/to/a/rather/long/target?with=query");
+            req0.set(field::host, "localhost");
+            req0.set(field::user_agent, "test");
+            req0.body() = "hello";
+            req0.prepare_payload();
+            BEAST_EXPECT(req.method() == verb::post);
+            BEAST_EXPECT(req.method_string() == "POST");
+            BEAST_EXPECT(req.target() ==
+                "/path/to/a/rather/long/target?with=query");
+            BEAST_EXPECT(req[field::content_length] == "5");
+            BEAST_EXPECT(to_string(req) == to_string(req0));
+
+            req.method_string("CUSTOM");
+            req.target("/");
+            req0.method_string("CUSTOM");
+            req0.target("/");
+            BEAST_EXPECT(req.method() == verb::unknown);
+            BEAST_EXPECT(req.method_string() == "CUSTOM");
+            BEAST_EXPECT(req.target() == "/");
+            BEAST_EXPECT(req[field::host] == "localhost");
+            BEAST_EXPECT(to_string(req) == to_string(req0));
+
+            req.version(11);
+            BEAST_EXPECT(req.keep_alive());
+            req.keep_alive(false);
+            BEAST_EXPECT(! req.keep_alive());
+            BEAST_EXPECT(req[field::connection] == "close");
+            req.chunked(true);
+            BEAST_EXPECT(req.chunked());
+            BEAST_EXPECT(! req.has_content_length());
+            req.set(field::transfer_encoding, "gzip, chunked");
+            req.chunked(false);
+            BEAST_EXPECT(req[field::transfer_encoding] == "gzip");
+            req.content_length(42);
+            BEAST_EXPECT(req.has_content_length());
+            BEAST_EXPECT(req[field::content_length] == "42");
+        }
+        {
+            response<string_body, flat_fields> res;
+            response<string_body> res0;
+            res.result(status::not_found);
+            res0.result(status::not_found);
+            res.set(field::server, "test");
+            res0.set(field::server, "test");
+            res.body() = "not here";
+            res0.body() = "not here";
+            res.prepare_payload();
+            res0.prepare_payload();
+            BEAST_EXPECT(to_string(res) == to_string(res0));
+            res.reason("Gone Fishing");
+            res0.reason("Gone Fishing");
+            BEAST_EXPECT(res.reason() == "Gone Fishing");
+            BEAST_EXPECT(to_string(res) == to_string(res0));
+            res.reason("");
+            BEAST_EXPECT(res.reason() == "Not Found");
+            BEAST_EXPECT(res[field::server] == "test");
+        }
+    }
+
+    void
+    testParser()
+    {
+        string_view const s =
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: www.example.com\r\n"
+            "User-Agent: test\r\n"
+            "Accept: text/html\r\n"
+            "X-Custom: 1\r\n"
+            "Accept: */*\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+        flat_request_parser<string_body> p;
+        p.eager(true);
+        error_code ec;
+        p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        auto const m = p.release();
+        BEAST_EXPECT(m.method() == verb::get);
+        BEAST_EXPECT(m.target() == "/index.html");
+        BEAST_EXPECT(m[field::host] == "www.example.com");
+        BEAST_EXPECT(m.count(field::accept) == 2);
+        BEAST_EXPECT(m["x-custom"] == "1");
+        BEAST_EXPECT(m.body() == "hello");
+        BEAST_EXPECT(str(m) ==
+            "Host=www.example.com;User-Agent=test;"
+            "Accept=text/html;Accept=*/*;"
+            "X-Custom=1;Content-Length=5;");
+        BEAST_EXPECT(to_string(m) ==
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: www.example.com\r\n"
+            "User-Agent: test\r\n"
+            "Accept: text/html\r\n"
+            "Accept: */*\r\n"
+            "X-Custom: 1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello");
+    }
+
+    void
+    testParserAliases()
+    {
+        BOOST_STATIC_ASSERT(std::is_same<
+            flat_request_parser<string_body>::value_type,
+            request<string_body, flat_fields>>::value);
+        BOOST_STATIC_ASSERT(std::is_same<
+            flat_response_parser<string_body>::value_type,
+            response<string_body, flat_fields>>::value);
+
+        string_view const s =
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n"
+            "OK";
+        flat_response_parser<string_body> p;
+        p.eager(true);
+        error_code ec;
+        p.put(net::buffer(s.data(), s.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        BEAST_EXPECT(p.get()[field::server] == "test");
+        BEAST_EXPECT(p.get().body() == "OK");
+    }
+
+    void
+    run() override
+    {
+        testMembers();
+        testContainer();
+        testRandom();
+        testMessage();
+        testParser();
+        testParserAliases();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,flat_fields);
+
+} // http
+} // beast
+} // boost
@@ -0,0 +1,286 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/mapped_file_body.hpp>
+
+#if BOOST_BEAST_USE_POSIX_FILE
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class mapped_file_body_test : public beast::unit_test::suite
+{
+public:
+    struct visit
+    {
+        std::string& s;
+        std::size_t& n;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&, ConstBufferSequence const& buffers)
+        {
+            n = buffer_bytes(buffers);
+            s.append(buffers_to_string(buffers));
+        }
+    };
+
+    struct front
+    {
+        void const*& data;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&, ConstBufferSequence const& buffers)
+        {
+            data = net::const_buffer(
+                *net::buffer_sequence_begin(buffers)).data();
+        }
+    };
+
+    struct temp_file
+    {
+        boost::filesystem::path path =
+            boost::filesystem::unique_path();
+
+        ~temp_file()
+        {
+            error_code ec;
+            boost::filesystem::remove(path, ec);
+        }
+
+        void
+        write(std::string const& s)
+        {
+            std::ofstream f(path.native(),
+                std::ios::binary | std::ios::trunc);
+            f << s;
+        }
+
+        std::string
+        string() const
+        {
+            return path.string<std::string>();
+        }
+    };
+
+    template<bool isRequest, class Body, class Fields>
+    std::string
+    to_string(message<isRequest, Body, Fields> const& m)
+    {
+        std::string s;
+        serializer<isRequest, Body, Fields> sr{m};
+        error_code ec;
+        while(! sr.is_done())
+        {
+            std::size_t n = 0;
+            sr.next(ec, visit{s, n});
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            sr.consume(n);
+        }
+        return s;
+    }
+
+    std::string
+    body_of(string_view wire)
+    {
+        response_parser<string_body> p;
+        p.eager(true);
+        p.body_limit(boost::none);
+        error_code ec;
+        p.put(net::buffer(wire.data(), wire.size()), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(p.is_done());
+        return p.get().body();
+    }
+
+    static
+    std::string
+    make_contents(std::size_t n, char first)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>(first + i % 26));
+        return s;
+    }
+
+    void
+    testSerialize()
+    {
+        temp_file temp;
+        auto const contents = make_contents(100000, 'a');
+        temp.write(contents);
+
+        error_code ec;
+        response<mapped_file_body> res{status::ok, 11};
+        res.body().open(temp.string().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(res.body().is_open());
+        BEAST_EXPECT(res.body().size() == contents.size());
+        res.prepare_payload();
+        BEAST_EXPECT(res.payload_size() == contents.size());
+
+        // the serializer sees the mapping itself
+        {
+            serializer<false, mapped_file_body> sr{res};
+            std::string s;
+            std::size_t n = 0;
+            sr.split(true);
+            sr.next(ec, visit{s, n});
+            sr.consume(n);
+            void const* data = nullptr;
+            sr.next(ec, front{data});
+            BEAST_EXPECT(data == res.body().data());
+        }
+
+        // one message serialized twice
+        BEAST_EXPECT(body_of(to_string(res)) == contents);
+        BEAST_EXPECT(body_of(to_string(res)) == contents);
+
+        // partial range
+        res.body().seek(1005, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        res.prepare_payload();
+        BEAST_EXPECT(body_of(to_string(res)) == contents.substr(1005));
+
+        res.body().seek(contents.size() + 1, ec);
+        BEAST_EXPECT(ec == errc::invalid_argument);
+
+        // from an open file
+        {
+            file_posix f;
+            f.open(temp.string().c_str(), file_mode::read, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            f.seek(5, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            response<mapped_file_body> res2{status::ok, 11};
+            res2.body().reset(f, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            res2.prepare_payload();
+            BEAST_EXPECT(body_of(to_string(res2)) == contents.substr(5));
+        }
+
+        // chunked
+        res.body().seek(0, ec);
+        res.chunked(true);
+        BEAST_EXPECT(body_of(to_string(res)) == contents);
+    }
+
+    void
+    testEmpty()
+    {
+        temp_file temp;
+        temp.write("");
+        error_code ec;
+        response<mapped_file_body> res{status::ok, 11};
+        res.body().open(temp.string().c_str(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(res.body().size() == 0);
+        res.prepare_payload();
+        BEAST_EXPECT(body_of(to_string(res)).empty());
+
+        res.body().close();
+        BEAST_EXPECT(! res.body().is_open());
+        res.body().open("no/such/file", ec);
+        BEAST_EXPECT(ec);
+        BEAST_EXPECT(! res.body().is_open());
+    }
+
+    void
+    testCache()
+    {
+        temp_file t1;
+        temp_file t2;
+        temp_file t3;
+        t1.write(make_contents(5000, 'a'));
+        t2.write(make_contents(6000, 'b'));
+        t3.write(make_contents(7000, 'c'));
+
+        error_code ec;
+        mapped_file_cache cache(2);
+        BEAST_EXPECT(cache.capacity() == 2);
+
+        // the same file shares one mapping
+        response<mapped_file_body> r1{status::ok, 11};
+        response<mapped_file_body> r2{status::ok, 11};
+        r1.body().open(t1.string().c_str(), cache, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        r2.body().open(t1.string().c_str(), cache, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(r1.body().data() == r2.body().data());
+        BEAST_EXPECT(cache.size() == 1);
+
+        // least recently used is evicted
+        response<mapped_file_body> r3{status::ok, 11};
+        r3.body().open(t2.string().c_str(), cache, ec);
+        r3.body().open(t1.string().c_str(), cache, ec);
+        r3.body().open(t3.string().c_str(), cache, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(cache.size() == 2);
+        r3.body().open(t1.string().c_str(), cache, ec);
+        BEAST_EXPECT(r3.body().data() == r1.body().data());
+
+        // a replaced file is mapped again
+        auto const contents = make_contents(9000, 'd');
+        {
+            auto const tmp = boost::filesystem::unique_path();
+            std::ofstream f(tmp.native(), std::ios::binary);
+            f << contents;
+            f.close();
+            boost::filesystem::rename(tmp, t1.path);
+        }
+        r3.body().open(t1.string().c_str(), cache, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(r3.body().size() == contents.size());
+        BEAST_EXPECT(r3.body().data() != r1.body().data());
+        r3.prepare_payload();
+        BEAST_EXPECT(body_of(to_string(r3)) == contents);
+
+        // the old mapping outlives its cache entry
+        r1.prepare_payload();
+        BEAST_EXPECT(body_of(to_string(r1)) ==
+            make_contents(5000, 'a'));
+
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(body_of(to_string(r3)) == contents);
+
+        r3.body().open("no/such/file", cache, ec);
+        BEAST_EXPECT(ec);
+    }
+
+    void
+    run() override
+    {
+        testSerialize();
+        testEmpty();
+        testCache();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,mapped_file_body);
+
+} // http
+} // beast
+} // boost
+
+#endif
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/http/prepared_header.hpp>
+
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/flat_fields.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+class prepared_header_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::chrono::system_clock::time_point
+    at(std::int64_t t)
+    {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<
+                std::chrono::system_clock::duration>(
+                    std::chrono::seconds(t)));
+    }
+
+    static
+    std::string
+    str(prepared_header& h,
+        std::uint64_t n, std::int64_t t)
+    {
+        return buffers_to_string(h.get(n, at(t)));
+    }
+
+    template<class Fields>
+    void
+    testGet()
+    {
+        response<empty_body, Fields> res{status::not_found, 11};
+        res.set(field::server, "test");
+        res.set(field::date, "Mon, 01 Jan 2001 00:00:00 GMT");
+        res.set(field::content_length, "1234");
+        res.set(field::transfer_encoding, "chunked");
+        res.set(field::cache_control, "no-cache");
+        prepared_header h{res.base()};
+
+        BEAST_EXPECT(str(h, 0, 784111777) ==
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n");
+
+        // the header is patched in place
+        auto const b1 = h.get(5, at(784111777));
+        auto const b2 = h.get(
+            (std::numeric_limits<std::uint64_t>::max)(),
+            at(784111778));
+        BEAST_EXPECT(b1.data() == b2.data());
+        BEAST_EXPECT(buffers_to_string(b2) ==
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Date: Sun, 06 Nov 1994 08:49:38 GMT\r\n"
+            "Content-Length: 18446744073709551615\r\n"
+            "\r\n");
+
+        // copies are independent
+        prepared_header h2(h);
+        BEAST_EXPECT(str(h2, 42, 0) ==
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+            "Content-Length: 42\r\n"
+            "\r\n");
+        BEAST_EXPECT(buffers_to_string(b2).find(
+            "Content-Length: 18446744073709551615\r\n") !=
+                std::string::npos);
+
+        // copies keep their capacity
+        auto const b3 = h2.get(0, at(0));
+        BEAST_EXPECT(h2.get((std::numeric_limits<
+            std::uint64_t>::max)(), at(1)).data() == b3.data());
+        prepared_header h4{res.base()};
+        h4 = h;
+        auto const b4 = h4.get(0, at(0));
+        BEAST_EXPECT(h4.get((std::numeric_limits<
+            std::uint64_t>::max)(), at(1)).data() == b4.data());
+        BEAST_EXPECT(str(h4, 1, 0) == str(h, 1, 0));
+
+        // no fields
+        response<empty_body, Fields> empty{status::ok, 10};
+        prepared_header h3{empty.base()};
+        BEAST_EXPECT(str(h3, 7, 951782400) ==
+            "HTTP/1.0 200 OK\r\n"
+            "Date: Tue, 29 Feb 2000 00:00:00 GMT\r\n"
+            "Content-Length: 7\r\n"
+            "\r\n");
+    }
+
+    template<class Fields>
+    void
+    testNoContentLength()
+    {
+        auto const check =
+            [&](status result, string_view start_line)
+            {
+                response<empty_body, Fields> res{result, 11};
+                res.set(field::server, "test");
+                res.set(field::content_length, "5");
+                prepared_header h{res.base()};
+                auto const expected =
+                    std::string(start_line) +
+                    "Server: test\r\n"
+                    "Date: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+                    "\r\n";
+                BEAST_EXPECT(str(h, 0, 0) == expected);
+                BEAST_EXPECT(str(h, 42, 0) == expected);
+
+                prepared_header h2(h);
+                BEAST_EXPECT(str(h2, 42, 0) == expected);
+            };
+        check(status::continue_,
+            "HTTP/1.1 100 Continue\r\n");
+        check(status::switching_protocols,
+            "HTTP/1.1 101 Switching Protocols\r\n");
+        check(status::no_content,
+            "HTTP/1.1 204 No Content\r\n");
+        check(status::not_modified,
+            "HTTP/1.1 304 Not Modified\r\n");
+    }
+
+    void
+    testDate()
+    {
+        response<empty_body> res{status::ok, 11};
+        prepared_header h{res.base()};
+        auto const date =
+            [&](std::int64_t t)
+            {
+                auto const s = str(h, 0, t);
+                return s.substr(s.find("Date: ") + 6, 29);
+            };
+        BEAST_EXPECT(date(-1) ==
+            "Wed, 31 Dec 1969 23:59:59 GMT");
+        BEAST_EXPECT(date(68169600) ==
+            "Tue, 29 Feb 1972 00:00:00 GMT");
+        BEAST_EXPECT(date(946684799) ==
+            "Fri, 31 Dec 1999 23:59:59 GMT");
+        BEAST_EXPECT(date(951868800) ==
+            "Wed, 01 Mar 2000 00:00:00 GMT");
+        BEAST_EXPECT(date(1234567890) ==
+            "Fri, 13 Feb 2009 23:31:30 GMT");
+        BEAST_EXPECT(date(4102444800) ==
+            "Fri, 01 Jan 2100 00:00:00 GMT");
+        BEAST_EXPECT(date(7263259200) ==
+            "Sat, 01 Mar 2200 12:00:00 GMT");
+    }
+
+    void
+    run() override
+    {
+        testGet<fields>();
+        testGet<flat_fields>();
+        testNoContentLength<fields>();
+        testNoContentLength<flat_fields>();
+        testDate();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,http,prepared_header);
+
+} // http
+} // beast
+} // boost
@@ -15,6 +15,7 @@
 #include <boost/beast/core/ostream.hpp>
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/flat_fields.hpp>
 #include <boost/beast/http/dynamic_body.hpp>
 #include <boost/beast/http/parser.hpp>
 #include <boost/beast/http/string_body.hpp>
@@ -343,6 +344,54 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    void
+    testReadFlatFields(yield_context do_yield)
+    {
+        string_view const s =
+            "GET /path HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "User-Agent: test\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        {
+            test::stream ts{ioc_, s};
+            request<string_body, flat_fields> m;
+            multi_buffer b;
+            read(ts, b, m);
+            BEAST_EXPECT(m.target() == "/path");
+            BEAST_EXPECT(m[field::host] == "localhost");
+            BEAST_EXPECT(m[field::user_agent] == "test");
+            BEAST_EXPECT(m.body() == "*****");
+        }
+        {
+            test::stream ts{ioc_, s};
+            request<string_body, flat_fields> m;
+            error_code ec;
+            multi_buffer b;
+            read(ts, b, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m[field::host] == "localhost");
+            BEAST_EXPECT(m.body() == "*****");
+        }
+        {
+            test::stream ts{ioc_,
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"
+                "abc"};
+            response<string_body, flat_fields> m;
+            error_code ec;
+            multi_buffer b;
+            async_read(ts, b, m, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m.result() == status::ok);
+            BEAST_EXPECT(m[field::server] == "test");
+            BEAST_EXPECT(m.body() == "abc");
+        }
+    }
+
     void
     testEof(yield_context do_yield)
     {
@@ -802,6 +851,10 @@ public:
             testRead(yield);
         });
         yield_to([&](yield_context yield)
+        {
+            testReadFlatFields(yield);
+        });
+        yield_to([&](yield_context yield)
         {
             testEof(yield);
         });
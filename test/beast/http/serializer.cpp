@@ -11,8 +11,11 @@
 #include <boost/beast/http/serializer.hpp>
 
 #include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/http/flat_fields.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -116,10 +119,150 @@ public:
         }
     }
 
+    struct collect
+    {
+        std::string out;
+        std::size_t count = 0;
+        void const* first = nullptr;
+
+        template<class ConstBufferSequence>
+        void
+        operator()(error_code&,
+            ConstBufferSequence const& buffers)
+        {
+            count = 0;
+            first = nullptr;
+            for(auto b : buffers_range_ref(buffers))
+            {
+                if(! first)
+                    first = b.data();
+                ++count;
+                out.append(static_cast<
+                    char const*>(b.data()), b.size());
+            }
+        }
+    };
+
+    template<bool isRequest, class Fields>
+    void
+    fill(message<isRequest, string_body, Fields>& m)
+    {
+        m.set(field::server, "test");
+        m.set(field::content_type, "text/plain");
+        m.set(field::cache_control, "no-cache");
+        m.set("X-Custom", "value");
+        m.body() = "*****";
+        m.prepare_payload();
+    }
+
+    // Serialize `m` and return the output, with the
+    // number of buffers in the first call to `next`.
+    template<bool isRequest, class Fields, class Init>
+    std::string
+    serialize(
+        message<isRequest, string_body, Fields> const& m,
+        Init const& init,
+        std::size_t& count,
+        void const*& first)
+    {
+        collect visit;
+        error_code ec;
+        serializer<isRequest, string_body, Fields> sr{m};
+        init(sr);
+        count = 0;
+        first = nullptr;
+        for(;;)
+        {
+            auto const size = visit.out.size();
+            sr.next(ec, visit);
+            BEAST_EXPECT(! ec);
+            if(count == 0)
+            {
+                count = visit.count;
+                first = visit.first;
+            }
+            sr.consume(visit.out.size() - size);
+            if(sr.is_done())
+                break;
+        }
+        return visit.out;
+    }
+
+    template<bool isRequest, class Fields>
+    void
+    checkFlatten(message<isRequest, string_body, Fields> const& m)
+    {
+        std::size_t count;
+        void const* first;
+        auto const expected = serialize(m,
+            [](serializer<isRequest, string_body, Fields>&)
+            {
+            }, count, first);
+        BEAST_EXPECT(count > 2);
+
+        // flattened with the allocator of the fields
+        BEAST_EXPECT(serialize(m,
+            [](serializer<isRequest, string_body, Fields>& sr)
+            {
+                BEAST_EXPECT(! sr.flatten());
+                sr.flatten(true);
+                BEAST_EXPECT(sr.flatten());
+            }, count, first) == expected);
+        BEAST_EXPECT(count == (m.chunked() ? 7 : 2));
+
+        // flattened into storage provided by the caller
+        char buf[512];
+        BEAST_EXPECT(serialize(m,
+            [&](serializer<isRequest, string_body, Fields>& sr)
+            {
+                sr.flatten(net::buffer(buf));
+            }, count, first) == expected);
+        BEAST_EXPECT(count == (m.chunked() ? 7 : 2));
+        BEAST_EXPECT(first == buf);
+
+        // storage which is too small
+        BEAST_EXPECT(serialize(m,
+            [&](serializer<isRequest, string_body, Fields>& sr)
+            {
+                sr.flatten(net::buffer(buf, 10));
+            }, count, first) == expected);
+        BEAST_EXPECT(count == (m.chunked() ? 7 : 2));
+        BEAST_EXPECT(first != buf);
+
+        // header only
+        BEAST_EXPECT(serialize(m,
+            [](serializer<isRequest, string_body, Fields>& sr)
+            {
+                sr.split(true);
+                sr.flatten(true);
+            }, count, first) == expected);
+        BEAST_EXPECT(count == 1);
+    }
+
+    template<class Fields>
+    void
+    testFlatten()
+    {
+        {
+            request<string_body, Fields> req{verb::post, "/path", 11};
+            fill(req);
+            checkFlatten(req);
+        }
+        {
+            response<string_body, Fields> res{status::ok, 11};
+            fill(res);
+            checkFlatten(res);
+            res.chunked(true);
+            checkFlatten(res);
+        }
+    }
+
     void
     run() override
     {
         testWriteLimit();
+        testFlatten<fields>();
+        testFlatten<flat_fields>();
     }
 };
 
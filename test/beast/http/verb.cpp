@@ -106,6 +106,14 @@ public:
         bad("UNLOC_");
         bad("UNSUBSCRIB_");
 
+        bad("get");
+        bad("Get");
+        bad("GET ");
+        bad(string_view("GET\0", 4));
+        bad("UNSUBSCRIBES");
+        bad("UNSUBSCRIBEUNSUBSCRIBE");
+        bad("");
+
         try
         {
             to_string(static_cast<verb>(-1));
@@ -30,6 +30,7 @@
 #include <boost/asio/writable_pipe.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
+#include <array>
 #include <sstream>
 #include <string>
 #if BOOST_ASIO_HAS_CO_AWAIT
@@ -1119,6 +1120,69 @@ public:
         asio::post(ioc_, do_yield);
     }
 
+    void
+    testPreparedHeader(yield_context do_yield)
+    {
+        response<empty_body> res{status::ok, 11};
+        res.set(field::server, "test");
+        prepared_header h{res.base()};
+        auto const expected =
+            [](string_view date, string_view body)
+            {
+                return
+                    "HTTP/1.1 200 OK\r\n"
+                    "Server: test\r\n"
+                    "Date: " + std::string(date) + "\r\n"
+                    "Content-Length: " +
+                        std::to_string(body.size()) + "\r\n"
+                    "\r\n" + std::string(body);
+            };
+        auto const date =
+            [](string_view s)
+            {
+                auto const pos = s.find("Date: ");
+                return std::string(s.substr(pos + 6, 29));
+            };
+        {
+            test::stream ts{ioc_}, tr{ioc_};
+            ts.connect(tr);
+            auto const n = write(ts, h, net::buffer("OK", 2));
+            BEAST_EXPECT(n == tr.str().size());
+            BEAST_EXPECT(tr.str() ==
+                expected(date(tr.str()), "OK"));
+        }
+        {
+            test::stream ts{ioc_}, tr{ioc_};
+            ts.connect(tr);
+            error_code ec;
+            std::array<net::const_buffer, 2> body{{
+                net::buffer("Hello, ", 7),
+                net::buffer("world!", 6)}};
+            write(ts, h, body, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(tr.str() ==
+                expected(date(tr.str()), "Hello, world!"));
+        }
+        {
+            test::stream ts{ioc_}, tr{ioc_};
+            ts.connect(tr);
+            error_code ec;
+            async_write(ts, h,
+                net::const_buffer{}, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(tr.str() ==
+                expected(date(tr.str()), ""));
+        }
+        {
+            test::fail_count fc(0);
+            test::stream ts{ioc_, fc}, tr{ioc_};
+            ts.connect(tr);
+            error_code ec;
+            write(ts, h, net::buffer("OK", 2), ec);
+            BEAST_EXPECT(ec == test::error::test_failure);
+        }
+    }
+
     void
     run() override
     {
@@ -1128,6 +1192,7 @@ public:
             {
                 testAsyncWrite(yield);
                 testFailures(yield);
+                testPreparedHeader(yield);
             });
         testOutput();
         test_std_ostream();
@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/detail/mask.hpp>
+
+#include <boost/beast/core/buffers_cat.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+class mask_test
+    : public beast::unit_test::suite
+{
+public:
+    // The masking rule from rfc6455, one octet at a time
+    static
+    void
+    reference(
+        unsigned char* p,
+        std::size_t n,
+        std::uint32_t key)
+    {
+        prepared_key k;
+        prepare_key(k, key);
+        for(std::size_t i = 0; i < n; ++i)
+            p[i] ^= k[i % 4];
+    }
+
+    void
+    testPrepareKey()
+    {
+        prepared_key k;
+        prepare_key(k, 0x04030201);
+        BEAST_EXPECT(k[0] == 1);
+        BEAST_EXPECT(k[1] == 2);
+        BEAST_EXPECT(k[2] == 3);
+        BEAST_EXPECT(k[3] == 4);
+    }
+
+    void
+    testSizes()
+    {
+        // every size and alignment across the vector block sizes
+        std::mt19937 g;
+        std::uint32_t const key = 0xa1b2c3d4;
+        std::vector<unsigned char> buf(640);
+        std::vector<unsigned char> expected;
+        std::vector<std::size_t> sizes;
+        for(std::size_t n = 0; n <= 300; ++n)
+            sizes.push_back(n);
+        for(std::size_t n = 500; n <= 600; ++n)
+            sizes.push_back(n);
+        for(std::size_t offset = 0; offset < 32; ++offset)
+        {
+            for(auto const n : sizes)
+            {
+                for(auto& c : buf)
+                    c = static_cast<unsigned char>(g());
+                expected = buf;
+                reference(&expected[offset], n, key);
+                prepared_key k;
+                prepare_key(k, key);
+                mask_inplace(net::buffer(&buf[offset], n), k);
+                if(! BEAST_EXPECTS(buf == expected,
+                    std::to_string(offset) + "," + std::to_string(n)))
+                    return;
+
+                // the key advances by the size, modulo 4
+                prepared_key k2;
+                prepare_key(k2, key);
+                for(std::size_t i = 0; i < 4; ++i)
+                    BEAST_EXPECT(k[i] == k2[(n + i) % 4]);
+            }
+        }
+    }
+
+    void
+    testSequence()
+    {
+        // the key rotation carries across buffers
+        std::mt19937 g;
+        std::uint32_t const key = 0x5a6b7c8d;
+        for(int iter = 0; iter < 500; ++iter)
+        {
+            std::vector<unsigned char> buf(g() % 1000);
+            for(auto& c : buf)
+                c = static_cast<unsigned char>(g());
+            auto expected = buf;
+            reference(expected.data(), expected.size(), key);
+
+            std::vector<net::mutable_buffer> v;
+            std::size_t pos = 0;
+            while(pos < buf.size())
+            {
+                auto const n = (std::min<std::size_t>)(
+                    buf.size() - pos, g() % 80);
+                v.emplace_back(&buf[pos], n);
+                pos += n;
+            }
+            prepared_key k;
+            prepare_key(k, key);
+            mask_inplace(v, k);
+            if(! BEAST_EXPECT(buf == expected))
+                return;
+        }
+    }
+
+    void
+    testCopy()
+    {
+        std::mt19937 g;
+        std::uint32_t const key = 0x0badf00d;
+
+        // many small segments, as produced by buffers_cat
+        for(int iter = 0; iter < 500; ++iter)
+        {
+            std::vector<unsigned char> src(g() % 1200);
+            for(auto& c : src)
+                c = static_cast<unsigned char>(g());
+            auto expected = src;
+            reference(expected.data(), expected.size(), key);
+
+            std::vector<net::const_buffer> v;
+            std::size_t pos = 0;
+            while(pos < src.size())
+            {
+                auto const n = (std::min<std::size_t>)(
+                    src.size() - pos, g() % (iter % 2 ? 9 : 200));
+                v.emplace_back(&src[pos], n);
+                pos += n;
+            }
+            std::vector<unsigned char> dest(src.size() + 7);
+            prepared_key k;
+            prepare_key(k, key);
+            auto const n = mask_copy(net::buffer(
+                &dest[iter % 8], src.size()), v, k);
+            BEAST_EXPECT(n == src.size());
+            if(! BEAST_EXPECT(std::equal(expected.begin(),
+                    expected.end(), dest.begin() + iter % 8)))
+                return;
+            prepared_key k2;
+            prepare_key(k2, key);
+            mask_inplace(net::buffer(src), k2);
+            BEAST_EXPECT(k == k2);
+        }
+
+        // the destination limits the copy
+        {
+            std::string const s1 = "Hello, ";
+            std::string const s2 = "world!";
+            unsigned char dest[10] = {};
+            prepared_key k;
+            prepare_key(k, key);
+            auto const n = mask_copy(net::buffer(dest),
+                buffers_cat(net::buffer(s1), net::buffer(s2)), k);
+            BEAST_EXPECT(n == 10);
+            std::string const s = s1 + s2;
+            std::vector<unsigned char> expected(
+                s.begin(), s.begin() + 10);
+            reference(expected.data(), expected.size(), key);
+            BEAST_EXPECT(std::equal(
+                expected.begin(), expected.end(), dest));
+            prepared_key k2;
+            prepare_key(k2, key);
+            BEAST_EXPECT(k[0] == k2[2]);
+        }
+
+        // empty source
+        {
+            unsigned char dest[4] = {};
+            prepared_key k;
+            prepare_key(k, key);
+            BEAST_EXPECT(mask_copy(net::buffer(dest),
+                net::const_buffer(), k) == 0);
+            prepared_key k2;
+            prepare_key(k2, key);
+            BEAST_EXPECT(k == k2);
+        }
+    }
+
+    void
+    testInvolution()
+    {
+        // masking twice restores the payload
+        std::vector<unsigned char> buf(4096);
+        for(std::size_t i = 0; i < buf.size(); ++i)
+            buf[i] = static_cast<unsigned char>(i * 7);
+        auto const original = buf;
+        prepared_key k;
+        prepare_key(k, 0xdeadbeef);
+        mask_inplace(net::buffer(&buf[3], 4001), k);
+        BEAST_EXPECT(buf != original);
+        prepare_key(k, 0xdeadbeef);
+        mask_inplace(net::buffer(&buf[3], 4001), k);
+        BEAST_EXPECT(buf == original);
+    }
+
+    void
+    run() override
+    {
+        testPrepareKey();
+        testSizes();
+        testSequence();
+        testCopy();
+        testInvolution();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,mask);
+
+} // detail
+} // websocket
+} // beast
+} // boost
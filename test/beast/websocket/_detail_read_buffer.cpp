@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/detail/read_buffer.hpp>
+
+#include <boost/beast/core/buffer_traits.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/read_size.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+namespace detail {
+
+BOOST_STATIC_ASSERT(
+    net::is_dynamic_buffer<read_buffer>::value);
+
+class read_buffer_test
+    : public beast::unit_test::suite
+{
+public:
+    // Fill the space offered by the next read
+    static
+    std::size_t
+    fill(read_buffer& b, std::size_t n)
+    {
+        auto const mb = b.prepare(n);
+        std::memset(mb.data(), 'x', mb.size());
+        b.commit(mb.size());
+        return mb.size();
+    }
+
+    void
+    testFixed()
+    {
+        // with no larger limit, the buffer never grows
+        read_buffer b(1536);
+        BEAST_EXPECT(b.size() == 0);
+        BEAST_EXPECT(b.max_size() == 1536);
+        for(int i = 0; i < 4; ++i)
+        {
+            auto const n = read_size(b, b.max_size());
+            BEAST_EXPECT(n == 1536);
+            fill(b, n);
+            b.consume(b.size());
+        }
+        BEAST_EXPECT(read_size(b, b.max_size()) == 1536);
+        try
+        {
+            b.prepare(1537);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    testGrow()
+    {
+        read_buffer b(1536);
+        b.max_size(8192);
+        BEAST_EXPECT(b.max_size() == 8192);
+        BEAST_EXPECT(read_size(b, b.max_size()) == 1536);
+
+        // full reads double the offer up to the limit
+        fill(b, read_size(b, b.max_size()));
+        BEAST_EXPECT(read_size(b, b.max_size()) == 3072);
+        b.consume(b.size());
+        BEAST_EXPECT(read_size(b, b.max_size()) == 3072);
+        fill(b, read_size(b, b.max_size()));
+        b.consume(b.size());
+        BEAST_EXPECT(read_size(b, b.max_size()) == 6144);
+        fill(b, read_size(b, b.max_size()));
+        b.consume(b.size());
+        BEAST_EXPECT(read_size(b, b.max_size()) == 8192);
+        fill(b, read_size(b, b.max_size()));
+        b.consume(b.size());
+        BEAST_EXPECT(read_size(b, b.max_size()) == 8192);
+
+        // the caller's limit is respected
+        BEAST_EXPECT(read_size(b, 100) == 100);
+
+        // short reads decay the offer back to the minimum
+        for(int i = 0; i < 8; ++i)
+        {
+            auto const mb = b.prepare(read_size(b, b.max_size()));
+            std::memset(mb.data(), 'y', 10);
+            b.commit(10);
+            b.consume(10);
+        }
+        BEAST_EXPECT(read_size(b, b.max_size()) == 1536);
+
+        // lowering the limit lowers the offer
+        fill(b, read_size(b, b.max_size()));
+        b.consume(b.size());
+        b.max_size(2000);
+        BEAST_EXPECT(read_size(b, b.max_size()) == 2000);
+    }
+
+    void
+    testData()
+    {
+        // unread bytes survive a reallocation
+        read_buffer b(16);
+        b.max_size(64);
+        std::string const s = "0123456789abcdef";
+        auto mb = b.prepare(s.size());
+        std::memcpy(mb.data(), s.data(), s.size());
+        b.commit(s.size());
+        b.consume(4);
+        BEAST_EXPECT(buffers_to_string(b.data()) == s.substr(4));
+        mb = b.prepare(20);
+        std::memcpy(mb.data(), s.data(), 20 - 4);
+        std::memcpy(static_cast<char*>(mb.data()) + 16, "wxyz", 4);
+        b.commit(20);
+        BEAST_EXPECT(buffers_to_string(b.data()) ==
+            s.substr(4) + s + "wxyz");
+        BEAST_EXPECT(buffer_bytes(b.cdata()) == 32);
+
+        // unread bytes are moved to the front
+        b.consume(30);
+        mb = b.prepare(60);
+        b.commit(0);
+        BEAST_EXPECT(buffers_to_string(b.data()) == "yz");
+
+        // committing more than prepared is clamped
+        b.prepare(4);
+        b.commit(10);
+        BEAST_EXPECT(b.size() == 6);
+        b.clear();
+        BEAST_EXPECT(b.size() == 0);
+    }
+
+    void
+    run() override
+    {
+        testFixed();
+        testGrow();
+        testData();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,read_buffer);
+
+} // detail
+} // websocket
+} // beast
+} // boost
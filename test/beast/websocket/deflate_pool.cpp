@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/deflate_pool.hpp>
+
+#include <boost/beast/websocket/detail/deflate_pool.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <boost/beast/_experimental/test/stream.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <string>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+class deflate_pool_test : public beast::unit_test::suite
+{
+public:
+    void
+    testPool()
+    {
+        auto& pool = detail::deflate_pool::instance();
+        shrink_deflate_pool();
+        set_deflate_pool_limit(2);
+        auto const s0 = get_deflate_pool_stats();
+        BEAST_EXPECT(s0.deflate_pooled == 0);
+        BEAST_EXPECT(s0.inflate_pooled == 0);
+        {
+            auto zo1 = pool.get_deflate(6, 15, 8);
+            auto zo2 = pool.get_deflate(6, 15, 8);
+            auto zo3 = pool.get_deflate(6, 15, 8);
+            auto zi = pool.get_inflate(15);
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use + 3);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use + 1);
+            BEAST_EXPECT(s.created == s0.created + 4);
+            BEAST_EXPECT(s.reused == s0.reused);
+        }
+        {
+            // one compressor was destroyed, over the limit
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use);
+            BEAST_EXPECT(s.deflate_pooled == 2);
+            BEAST_EXPECT(s.inflate_pooled == 1);
+        }
+        {
+            auto zo = pool.get_deflate(1, 9, 4);
+            auto zi = pool.get_inflate(9);
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_pooled == 1);
+            BEAST_EXPECT(s.inflate_pooled == 0);
+            BEAST_EXPECT(s.created == s0.created + 4);
+            BEAST_EXPECT(s.reused == s0.reused + 2);
+
+            // a reused compressor works with new parameters
+            std::string const in(1000, '*');
+            std::string out(zlib::deflate_upper_bound(in.size()), 0);
+            zlib::z_params zs;
+            zs.next_in = in.data();
+            zs.avail_in = in.size();
+            zs.next_out = &out[0];
+            zs.avail_out = out.size();
+            error_code ec;
+            zo->write(zs, zlib::Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            out.resize(zs.total_out);
+            std::string res(in.size(), 0);
+            zlib::z_params zs2;
+            zs2.next_in = out.data();
+            zs2.avail_in = out.size();
+            zs2.next_out = &res[0];
+            zs2.avail_out = res.size();
+            zi->write(zs2, zlib::Flush::sync, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(res == in);
+        }
+        set_deflate_pool_limit(1);
+        {
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_pooled == 1);
+            BEAST_EXPECT(s.inflate_pooled == 1);
+        }
+        shrink_deflate_pool();
+        {
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_pooled == 0);
+            BEAST_EXPECT(s.inflate_pooled == 0);
+        }
+        set_deflate_pool_limit(64);
+    }
+
+    // Connect a client and a server with the given options
+    void
+    open(
+        net::io_context& ioc,
+        stream<test::stream>& wsc,
+        stream<test::stream>& wss,
+        permessage_deflate const& pmd)
+    {
+        wsc.set_option(pmd);
+        wss.set_option(pmd);
+        wsc.next_layer().connect(wss.next_layer());
+        wsc.async_handshake(
+            "localhost", "/", [](error_code){});
+        wss.async_accept([](error_code){});
+        ioc.run();
+        ioc.restart();
+        BEAST_EXPECT(wsc.is_open());
+        BEAST_EXPECT(wss.is_open());
+    }
+
+    void
+    echo(
+        stream<test::stream>& wsc,
+        stream<test::stream>& wss)
+    {
+        std::string const s(1000, '*');
+        wsc.write(net::buffer(s));
+        flat_buffer b;
+        wss.read(b);
+        BEAST_EXPECT(buffers_to_string(b.data()) == s);
+    }
+
+    void
+    testStream()
+    {
+        permessage_deflate pmd;
+        pmd.client_enable = true;
+        pmd.server_enable = true;
+
+        // state is taken on the first compressed message,
+        // and kept while the context is taken over
+        {
+            auto const s0 = get_deflate_pool_stats();
+            net::io_context ioc;
+            stream<test::stream> wsc{ioc};
+            stream<test::stream> wss{ioc};
+            open(ioc, wsc, wss, pmd);
+            auto s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use);
+            echo(wsc, wss);
+            echo(wsc, wss);
+            s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use + 1);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use + 1);
+        }
+        {
+            // closed streams give their state back
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_pooled > 0);
+            BEAST_EXPECT(s.inflate_pooled > 0);
+        }
+
+        // state goes back to the pool after each message
+        // when the context is not taken over
+        pmd.client_no_context_takeover = true;
+        pmd.server_no_context_takeover = true;
+        {
+            auto const s0 = get_deflate_pool_stats();
+            net::io_context ioc;
+            stream<test::stream> wsc{ioc};
+            stream<test::stream> wss{ioc};
+            open(ioc, wsc, wss, pmd);
+            echo(wsc, wss);
+            auto s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use);
+            echo(wsc, wss);
+            s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.reused > s0.reused);
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use);
+        }
+    }
+
+    void
+    testIdleRelease()
+    {
+        permessage_deflate pmd;
+        pmd.client_enable = true;
+        pmd.server_enable = true;
+
+        // the compressor is kept by default
+        {
+            auto const s0 = get_deflate_pool_stats();
+            net::io_context ioc;
+            stream<test::stream> wsc{ioc};
+            stream<test::stream> wss{ioc};
+            open(ioc, wsc, wss, pmd);
+            echo(wsc, wss);
+            ioc.poll();
+            auto const s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use + 1);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use + 1);
+        }
+
+        // the compressor is given back after the idle release
+        // time, while the decompressor keeps the peer's context
+        pmd.idle_release = std::chrono::milliseconds(1);
+        {
+            auto const s0 = get_deflate_pool_stats();
+            net::io_context ioc;
+            stream<test::stream> wsc{ioc};
+            stream<test::stream> wss{ioc};
+            open(ioc, wsc, wss, pmd);
+            echo(wsc, wss);
+            auto s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use + 1);
+            ioc.run();
+            ioc.restart();
+            s = get_deflate_pool_stats();
+            BEAST_EXPECT(s.deflate_in_use == s0.deflate_in_use);
+            BEAST_EXPECT(s.inflate_in_use == s0.inflate_in_use + 1);
+
+            // the next message starts a new context
+            echo(wsc, wss);
+            echo(wsc, wss);
+        }
+    }
+
+    void
+    run() override
+    {
+        testPool();
+        testStream();
+        testIdleRelease();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,deflate_pool);
+
+} // websocket
+} // beast
+} // boost
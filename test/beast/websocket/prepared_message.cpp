@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/websocket/prepared_message.hpp>
+
+#include <boost/beast/websocket/stream.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/asio/io_context.hpp>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+BOOST_STATIC_ASSERT(
+    detail::is_batch_message<prepared_message>::value);
+BOOST_STATIC_ASSERT(
+    detail::is_batch_message<net::const_buffer>::value);
+BOOST_STATIC_ASSERT(
+    ! detail::is_batch_message<int>::value);
+
+class prepared_message_test : public websocket_test_suite
+{
+public:
+    void
+    testMembers()
+    {
+        {
+            prepared_message const m;
+            BEAST_EXPECT(! m.binary());
+            BEAST_EXPECT(m.size() == 0);
+            BEAST_EXPECT(m.data().size() == 0);
+        }
+        {
+            std::string const s = "Hello";
+            prepared_message const m(net::buffer(s));
+            BEAST_EXPECT(! m.binary());
+            BEAST_EXPECT(m.size() == s.size());
+            BEAST_EXPECT(buffers_to_string(m.payload()) == s);
+            BEAST_EXPECT(buffers_to_string(m.data()) ==
+                std::string("\x81\x05", 2) + s);
+        }
+        {
+            std::string const s(300, '*');
+            prepared_message const m(net::buffer(s), true);
+            BEAST_EXPECT(m.binary());
+            BEAST_EXPECT(buffers_to_string(m.payload()) == s);
+            BEAST_EXPECT(buffers_to_string(m.data()) ==
+                std::string("\x82\x7e\x01\x2c", 4) + s);
+
+            // copies share the framed bytes
+            prepared_message const m2 = m;
+            BEAST_EXPECT(m2.data().data() == m.data().data());
+        }
+    }
+
+    void
+    testWrite()
+    {
+        std::string const s1 = "Hello";
+        std::string const s2(70000, '#');
+        std::vector<prepared_message> const v{
+            prepared_message(net::buffer(s1)),
+            prepared_message(net::const_buffer()),
+            prepared_message(net::buffer(s2), true)};
+        std::size_t const total = s1.size() + s2.size();
+
+        auto const check =
+            [&](stream<test::stream>& ws)
+            {
+                flat_buffer b;
+                ws.read(b);
+                BEAST_EXPECT(ws.got_text());
+                BEAST_EXPECT(buffers_to_string(b.data()) == s1);
+                b.clear();
+                ws.read(b);
+                BEAST_EXPECT(ws.got_text());
+                BEAST_EXPECT(b.size() == 0);
+                ws.read(b);
+                BEAST_EXPECT(ws.got_binary());
+                BEAST_EXPECT(buffers_to_string(b.data()) == s2);
+            };
+
+        // client, the payload is masked
+        {
+            echo_server es{log};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            BEAST_EXPECT(ws.write_messages(v) == total);
+            check(ws);
+        }
+
+        // server, the frames are sent as they are
+        {
+            echo_server es{log, kind::async_client};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            es.async_handshake();
+            ws.accept();
+            ws.binary(true);
+            BEAST_EXPECT(ws.write_messages(v) == total);
+            check(ws);
+        }
+
+        // one message, sync and async
+        {
+            echo_server es{log, kind::async_client};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            es.async_handshake();
+            ws.accept();
+            BEAST_EXPECT(ws.write(v[0]) == s1.size());
+            std::size_t count = 0;
+            ws.async_write(v[1],
+                [&](error_code ec, std::size_t n)
+                {
+                    ++count;
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(n == 0);
+                });
+            ioc.run();
+            BEAST_EXPECT(count == 1);
+            error_code ec;
+            BEAST_EXPECT(ws.write(v[2], ec) == s2.size());
+            BEAST_EXPECTS(! ec, ec.message());
+            check(ws);
+        }
+
+        // compressed once, shared by every stream
+        {
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.msg_size_threshold = 0;
+            doTest(pmd, [&](ws_type& ws)
+            {
+                BEAST_EXPECT(ws.write_messages(v) == total);
+                flat_buffer b;
+                ws.read(b);
+                BEAST_EXPECT(buffers_to_string(b.data()) == s1);
+                b.clear();
+                ws.read(b);
+                BEAST_EXPECT(b.size() == 0);
+                ws.read(b);
+                BEAST_EXPECT(ws.got_binary());
+                BEAST_EXPECT(buffers_to_string(b.data()) == s2);
+            });
+        }
+    }
+
+    static
+    std::string
+    inflate(net::const_buffer in)
+    {
+        zlib::inflate_stream zi;
+        std::string s(static_cast<char const*>(in.data()), in.size());
+        s.append("\x00\x00\xff\xff", 4);
+        std::string out(100000, 0);
+        zlib::z_params zs;
+        zs.next_in = s.data();
+        zs.avail_in = s.size();
+        zs.next_out = &out[0];
+        zs.avail_out = out.size();
+        error_code ec;
+        zi.write(zs, zlib::Flush::sync, ec);
+        out.resize(zs.total_out);
+        return out;
+    }
+
+    void
+    testDeflate()
+    {
+        std::string s;
+        for(int i = 0; i < 1000; ++i)
+            s += "message " + std::to_string(i % 10);
+        prepared_message const m(net::buffer(s), true);
+
+        for(int bits : {9, 12, 15})
+        {
+            detail::impl_base<true> ib;
+            permessage_deflate o;
+            o.server_enable = true;
+            ib.set_option_pmd(o);
+            ib.pmd_config_ = {};
+            ib.pmd_config_.accept = true;
+            ib.pmd_config_.server_max_window_bits = bits;
+            ib.open_pmd(role_type::server);
+            auto const z = ib.deflate(m);
+            BEAST_EXPECT(z.deflated());
+            BEAST_EXPECT(z.binary());
+            BEAST_EXPECT(z.size() < s.size());
+            BEAST_EXPECT(static_cast<unsigned char const*>(
+                z.data().data())[0] == 0xc2);
+            BEAST_EXPECT(inflate(z.payload()) == s);
+
+            // the compressed form is kept with the message
+            BEAST_EXPECT(ib.deflate(m).data().data() ==
+                z.data().data());
+            BEAST_EXPECT(ib.deflate(z).data().data() ==
+                z.data().data());
+        }
+
+        // empty messages are not compressed
+        {
+            detail::impl_base<true> ib;
+            permessage_deflate o;
+            o.server_enable = true;
+            ib.set_option_pmd(o);
+            ib.pmd_config_ = {};
+            ib.pmd_config_.accept = true;
+            ib.open_pmd(role_type::server);
+            prepared_message const e(net::const_buffer{});
+            BEAST_EXPECT(! ib.deflate(e).deflated());
+        }
+    }
+
+    void
+    run() override
+    {
+        testMembers();
+        testWrite();
+        testDeflate();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,websocket,prepared_message);
+
+} // websocket
+} // beast
+} // boost
@@ -16,6 +16,8 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/asio/write.hpp>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace beast {
@@ -339,6 +341,132 @@ public:
         bad(string_view("\x81\x7f\x00\x00\x00\x00\x00\x00\xff\xff", 10));
     }
 
+    void
+    testReadMessages()
+    {
+        auto const check =
+            [&](string_view s, std::size_t size,
+                std::vector<std::string> const& expected)
+            {
+                echo_server es{log};
+                net::io_context ioc;
+                stream<test::stream> ws{ioc};
+                ws.next_layer().connect(es.stream());
+                ws.handshake("localhost", "/");
+                ws.next_layer().append(s);
+                std::vector<flat_buffer> v(size);
+                auto const n = ws.read_messages(v);
+                BEAST_EXPECT(n == expected.size());
+                for(std::size_t i = 0; i < n; ++i)
+                    BEAST_EXPECT(buffers_to_string(
+                        v[i].data()) == expected[i]);
+                for(std::size_t i = n; i < v.size(); ++i)
+                    BEAST_EXPECT(v[i].size() == 0);
+                return ws.got_text();
+            };
+
+        // buffered messages are delivered together
+        BEAST_EXPECT(check(string_view(
+            "\x81\x01*" "\x81\x02**" "\x81\x00", 9),
+                4, {"*", "**", ""}));
+        BEAST_EXPECT(! check(std::string(
+            "\x82\x01*" "\x82\x7e\x00\x7e", 7) +
+                std::string(126, '*'), 2,
+                    {"*", std::string(126, '*')}));
+
+        // the batch is limited by the number of buffers
+        check("\x81\x01*" "\x81\x01*" "\x81\x01*", 2, {"*", "*"});
+
+        // the batch stops at a different message type,
+        // a fragment, a control frame or a partial frame
+        check("\x81\x01*" "\x82\x01*", 4, {"*"});
+        check("\x81\x01*" "\x01\x01*" "\x80\x01*", 4, {"*"});
+        check(string_view(
+            "\x81\x01*" "\x89\x00" "\x81\x01*", 8), 4, {"*"});
+        check("\x81\x01*" "\x81\x02*", 4, {"*"});
+
+        // frames left behind are read normally
+        {
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            ws.next_layer().append(
+                "\x81\x01*" "\x01\x01" "a" "\x80\x01" "b" "\x81\x01" "c");
+            std::vector<multi_buffer> v(4);
+            BEAST_EXPECT(ws.read_messages(v) == 1);
+            multi_buffer b;
+            ws.read(b);
+            BEAST_EXPECT(buffers_to_string(b.data()) == "ab");
+            v.clear();
+            v.resize(1);
+            BEAST_EXPECT(ws.read_messages(v) == 1);
+            BEAST_EXPECT(buffers_to_string(v[0].data()) == "c");
+        }
+
+        // a bad buffered message fails the next read
+        {
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            ws.next_layer().append(
+                "\x81\x01*" "\x81\x01\xff");
+            std::vector<flat_buffer> v(2);
+            BEAST_EXPECT(ws.read_messages(v) == 1);
+            BEAST_EXPECT(v[1].size() == 0);
+            error_code ec;
+            ws.read_messages(v, ec);
+            BEAST_EXPECTS(ec == error::bad_frame_payload,
+                ec.message());
+        }
+
+        // the buffer limit is respected
+        {
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            ws.next_layer().append(
+                "\x81\x01*" "\x81\x02**");
+            std::vector<flat_buffer> v;
+            v.emplace_back(1);
+            v.emplace_back(1);
+            BEAST_EXPECT(ws.read_messages(v) == 1);
+            error_code ec;
+            ws.read(v[1], ec);
+            BEAST_EXPECTS(ec == error::buffer_overflow,
+                ec.message());
+        }
+
+        // async
+        {
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            ws.next_layer().append(
+                "\x81\x01*" "\x81\x02**" "\x81\x03***");
+            std::vector<flat_buffer> v(4);
+            std::size_t count = 0;
+            ws.async_read_messages(v,
+                [&](error_code ec, std::size_t n)
+                {
+                    ++count;
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(n == 3);
+                    BEAST_EXPECT(buffers_to_string(
+                        v[2].data()) == "***");
+                });
+            ioc.run();
+            BEAST_EXPECT(count == 1);
+        }
+    }
+
     void
     testIssue802()
     {
@@ -1155,6 +1283,7 @@ public:
     run() override
     {
         testParseFrame();
+        testReadMessages();
         testIssue802();
         testIssue807();
         testIssue954();
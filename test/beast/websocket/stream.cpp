@@ -85,6 +85,18 @@ public:
             pass();
         }
 
+        ws.read_buffer_bytes(65536);
+        BEAST_EXPECT(ws.read_buffer_bytes() == 65536);
+        try
+        {
+            ws.read_buffer_bytes(1535);
+            fail();
+        }
+        catch(std::exception const&)
+        {
+            pass();
+        }
+
         ws.secure_prng(true);
         ws.secure_prng(false);
 
@@ -14,6 +14,8 @@
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <array>
+#include <random>
+#include <string>
 
 namespace boost {
 namespace beast {
@@ -566,6 +568,166 @@ public:
         }
     }
 
+    // Strict RFC 3629 decoding, one code point at a time
+    static
+    bool
+    reference(std::string const& s)
+    {
+        std::size_t i = 0;
+        while(i < s.size())
+        {
+            auto const c = static_cast<unsigned char>(s[i]);
+            std::size_t n;
+            std::uint32_t cp;
+            if(c < 0x80)
+            {
+                ++i;
+                continue;
+            }
+            else if(c >= 0xc2 && c <= 0xdf)
+            {
+                n = 2;
+                cp = c & 0x1f;
+            }
+            else if(c >= 0xe0 && c <= 0xef)
+            {
+                n = 3;
+                cp = c & 0x0f;
+            }
+            else if(c >= 0xf0 && c <= 0xf4)
+            {
+                n = 4;
+                cp = c & 0x07;
+            }
+            else
+            {
+                return false;
+            }
+            if(i + n > s.size())
+                return false;
+            for(std::size_t j = 1; j < n; ++j)
+            {
+                auto const d = static_cast<unsigned char>(s[i + j]);
+                if((d & 0xc0) != 0x80)
+                    return false;
+                cp = (cp << 6) | (d & 0x3f);
+            }
+            if( (n == 3 && cp < 0x800) ||
+                (n == 4 && cp < 0x10000) ||
+                (cp >= 0xd800 && cp <= 0xdfff) ||
+                cp > 0x10ffff)
+                return false;
+            i += n;
+        }
+        return true;
+    }
+
+    template<class Generator>
+    static
+    void
+    append_code_point(std::string& s, Generator& g)
+    {
+        std::uint32_t cp;
+        switch(g() % 5)
+        {
+        case 0:
+        case 1: cp = g() % 0x80; break;
+        case 2: cp = 0x80 + g() % (0x800 - 0x80); break;
+        case 3:
+            cp = 0x800 + g() % (0x10000 - 0x800);
+            if(cp >= 0xd800 && cp <= 0xdfff)
+                cp = 'x';
+            break;
+        default: cp = 0x10000 + g() % (0x110000 - 0x10000); break;
+        }
+        if(cp < 0x80)
+        {
+            s.push_back(static_cast<char>(cp));
+        }
+        else if(cp < 0x800)
+        {
+            s.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else if(cp < 0x10000)
+        {
+            s.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else
+        {
+            s.push_back(static_cast<char>(0xf0 | (cp >> 18)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+    }
+
+    void
+    testRandom()
+    {
+        // Long inputs take the vector path, so compare
+        // whole and segmented writes against the reference.
+        std::mt19937 g;
+        for(int i = 0; i < 20000; ++i)
+        {
+            std::string s;
+            auto const n = g() % 300;
+            bool const ascii = (i % 4) == 0;
+            while(s.size() < n)
+            {
+                if(ascii)
+                    s.push_back(static_cast<char>(g() % 0x80));
+                else
+                    append_code_point(s, g);
+            }
+            // mostly corrupt a byte, or truncate
+            switch(g() % 4)
+            {
+            case 0:
+                break;
+            case 1:
+                if(! s.empty())
+                    s[g() % s.size()] = static_cast<char>(g());
+                break;
+            case 2:
+                if(! s.empty())
+                    s[g() % s.size()] = static_cast<char>(
+                        0x80 | (g() % 0x80));
+                break;
+            default:
+                if(! s.empty())
+                    s.resize(s.size() - 1 - g() % (
+                        (std::min<std::size_t>)(s.size(), 3)));
+                break;
+            }
+            auto const expected = reference(s);
+
+            BEAST_EXPECTS(check_utf8(s.data(), s.size()) ==
+                expected, std::to_string(i));
+
+            utf8_checker u;
+            bool result = true;
+            std::size_t pos = 0;
+            while(pos < s.size())
+            {
+                auto const m = (std::min<std::size_t>)(
+                    s.size() - pos, 1 + g() % 100);
+                if(! u.write(reinterpret_cast<
+                    std::uint8_t const*>(&s[pos]), m))
+                {
+                    result = false;
+                    break;
+                }
+                pos += m;
+            }
+            if(result)
+                result = u.finish();
+            BEAST_EXPECTS(result == expected, std::to_string(i));
+        }
+    }
+
     void
     run() override
     {
@@ -576,6 +738,7 @@ public:
         testWithStreamBuffer();
         testBranches();
         AutodeskTests();
+        testRandom();
         // 6.4.2
         AutobahnTest(std::vector<std::vector<std::uint8_t>>{
             { 0xCE, 0xBA, 0xE1, 0xBD, 0xB9, 0xCF, 0x83, 0xCE, 0xBC, 0xCE, 0xB5, 0xF4 },
@@ -12,6 +12,8 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <string>
+#include <vector>
 
 #if BOOST_ASIO_HAS_CO_AWAIT
 #include <boost/asio/use_awaitable.hpp>
@@ -266,6 +268,138 @@ public:
         });
     }
 
+    void
+    testWriteMessages()
+    {
+        std::string const s1 = "Hello";
+        std::string const s2(200, '*');
+        std::string const s3(70000, '#');
+        std::vector<net::const_buffer> v{
+            net::buffer(s1),
+            net::const_buffer(),
+            net::buffer(s2),
+            net::buffer(s3)};
+        std::size_t const total =
+            s1.size() + s2.size() + s3.size();
+
+        auto const check =
+            [&](stream<test::stream>& ws)
+            {
+                for(auto const& s : {s1, std::string(), s2, s3})
+                {
+                    flat_buffer b;
+                    ws.read(b);
+                    BEAST_EXPECT(ws.got_text());
+                    BEAST_EXPECT(buffers_to_string(b.data()) == s);
+                }
+            };
+
+        // mask
+        {
+            echo_server es{log};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            BEAST_EXPECT(ws.write_messages(v) == total);
+            check(ws);
+        }
+
+        // nomask, large payloads are referenced
+        {
+            echo_server es{log, kind::async_client};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            es.async_handshake();
+            ws.accept();
+            BEAST_EXPECT(ws.write_messages(v) == total);
+            check(ws);
+        }
+
+        // no messages
+        {
+            echo_server es{log};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            std::vector<net::const_buffer> none;
+            BEAST_EXPECT(ws.write_messages(none) == 0);
+        }
+
+        // async
+        {
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            std::size_t count = 0;
+            ws.async_write_messages(v,
+                [&](error_code ec, std::size_t n)
+                {
+                    ++count;
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(n == total);
+                });
+            ioc.run();
+            BEAST_EXPECT(count == 1);
+            check(ws);
+        }
+
+        // already closed
+        {
+            echo_server es{log};
+            stream<test::stream> ws{ioc_};
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            ws.close({});
+            error_code ec;
+            ws.write_messages(v, ec);
+            BEAST_EXPECTS(ec == net::error::operation_aborted,
+                ec.message());
+        }
+
+        // deflate writes one message at a time
+        {
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            pmd.server_enable = true;
+            pmd.msg_size_threshold = 0;
+            doTest(pmd, [&](ws_type& ws)
+            {
+                BEAST_EXPECT(ws.write_messages(v) == total);
+                for(auto const& s : {s1, std::string(), s2, s3})
+                {
+                    flat_buffer b;
+                    ws.read(b);
+                    BEAST_EXPECT(buffers_to_string(b.data()) == s);
+                }
+            });
+        }
+
+        // deflate, async
+        {
+            permessage_deflate pmd;
+            pmd.client_enable = true;
+            echo_server es{log};
+            net::io_context ioc;
+            stream<test::stream> ws{ioc};
+            ws.set_option(pmd);
+            ws.next_layer().connect(es.stream());
+            ws.handshake("localhost", "/");
+            std::size_t count = 0;
+            ws.async_write_messages(v,
+                [&](error_code ec, std::size_t n)
+                {
+                    ++count;
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(n == total);
+                });
+            ioc.run();
+            BEAST_EXPECT(count == 1);
+            check(ws);
+        }
+    }
+
     void
     testPausationAbandoning()
     {
@@ -857,6 +991,7 @@ public:
         testWrite();
         testPausationAbandoning();
         testWriteSuspend();
+        testWriteMessages();
         testAsyncWriteFrame();
         testMoveOnly();
         testIssue226();
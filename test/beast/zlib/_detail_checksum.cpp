@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+// Test that header file is self-contained.
+#include <boost/beast/zlib/detail/adler32.hpp>
+#include <boost/beast/zlib/detail/crc32.hpp>
+
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "zlib-1.2.12/zlib.h"
+
+namespace boost {
+namespace beast {
+namespace zlib {
+namespace detail {
+
+class checksum_test : public beast::unit_test::suite
+{
+public:
+    void
+    testVectors()
+    {
+        std::string const s = "123456789";
+        BEAST_EXPECT(detail::crc32(0, s.data(), s.size()) == 0xcbf43926);
+        BEAST_EXPECT(detail::crc32(0, nullptr, 0) == 0);
+        BEAST_EXPECT(detail::adler32(1, s.data(), s.size()) == 0x091e01de);
+        BEAST_EXPECT(detail::adler32(1, nullptr, 0) == 1);
+
+        std::string const w = "Wikipedia";
+        BEAST_EXPECT(detail::adler32(1, w.data(), w.size()) == 0x11e60398);
+    }
+
+    void
+    testReference()
+    {
+        // every size and alignment across the vector block
+        // sizes, and sizes which need the modulo reduction
+        std::mt19937 g;
+        std::vector<unsigned char> buf(20000 + 64);
+        for(auto& c : buf)
+            c = static_cast<unsigned char>(g());
+        std::vector<std::size_t> sizes;
+        for(std::size_t n = 0; n <= 300; ++n)
+            sizes.push_back(n);
+        for(std::size_t n : { 5551, 5552, 5553, 11104, 20000 })
+            sizes.push_back(n);
+        for(std::size_t offset = 0; offset < 32; offset += 3)
+        {
+            for(auto const n : sizes)
+            {
+                auto const p = &buf[offset];
+                auto const c0 = static_cast<std::uint32_t>(g());
+                auto const a0 = static_cast<std::uint32_t>(
+                    (g() % 65521) | ((g() % 65521) << 16));
+                if(! BEAST_EXPECTS(detail::crc32(c0, p, n) ==
+                        ::crc32(c0, p, static_cast<uInt>(n)),
+                        std::to_string(offset) + "," + std::to_string(n)))
+                    return;
+                if(! BEAST_EXPECTS(detail::adler32(a0, p, n) ==
+                        ::adler32(a0, p, static_cast<uInt>(n)),
+                        std::to_string(offset) + "," + std::to_string(n)))
+                    return;
+            }
+        }
+
+        // all 0xff is the worst case for the sums
+        std::vector<unsigned char> ff(100000, 0xff);
+        BEAST_EXPECT(detail::adler32(0xfff0fff0, ff.data(), ff.size()) ==
+            ::adler32(0xfff0fff0, ff.data(), static_cast<uInt>(ff.size())));
+        BEAST_EXPECT(detail::crc32(0, ff.data(), ff.size()) ==
+            ::crc32(0, ff.data(), static_cast<uInt>(ff.size())));
+    }
+
+    void
+    testIncremental()
+    {
+        // the checksum of pieces continues across calls
+        std::mt19937 g;
+        std::vector<unsigned char> buf(10000);
+        for(auto& c : buf)
+            c = static_cast<unsigned char>(g());
+        auto const crc = detail::crc32(0, buf.data(), buf.size());
+        auto const adler = detail::adler32(1, buf.data(), buf.size());
+        for(int iter = 0; iter < 100; ++iter)
+        {
+            std::uint32_t c = 0;
+            std::uint32_t a = 1;
+            std::size_t pos = 0;
+            while(pos < buf.size())
+            {
+                auto const n = (std::min<std::size_t>)(
+                    buf.size() - pos, g() % 300);
+                c = detail::crc32(c, &buf[pos], n);
+                a = detail::adler32(a, &buf[pos], n);
+                pos += n;
+            }
+            BEAST_EXPECT(c == crc);
+            BEAST_EXPECT(a == adler);
+        }
+    }
+
+    void
+    run() override
+    {
+        testVectors();
+        testReference();
+        testIncremental();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,zlib,checksum);
+
+} // detail
+} // zlib
+} // beast
+} // boost
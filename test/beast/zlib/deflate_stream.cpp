@@ -14,6 +14,7 @@
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <numeric>
 #include <random>
 
@@ -635,6 +636,113 @@ public:
         testCVE(CVE_2018_25032_fixed, 6, Strategy::normal);
     }
 
+    // Compress with the given format, using output buffers of
+    // at most `chunk` bytes, and decompress with ZLib.
+    void
+    doFormat(
+        std::string const& in,
+        Format format,
+        int level,
+        Strategy strategy,
+        std::size_t chunk)
+    {
+        deflate_stream ds;
+        ds.reset(level, 15, 8, strategy, format);
+        std::string out;
+        z_params zp;
+        zp.next_in = in.data();
+        zp.avail_in = in.size();
+        error_code ec;
+        for(;;)
+        {
+            auto const used = out.size();
+            out.resize(used + chunk);
+            zp.next_out = &out[used];
+            zp.avail_out = chunk;
+            ds.write(zp, Flush::finish, ec);
+            out.resize(out.size() - zp.avail_out);
+            if(ec == error::end_of_stream)
+                break;
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+        }
+        BEAST_EXPECT(zp.total_out == out.size());
+        BEAST_EXPECT(out.size() <= ds.upper_bound(in.size()));
+
+        // ZLib verifies the header and trailer
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        inflateInit2(&zs, format == Format::gzip ? 31 : 15);
+        std::string result(in.size() + 1, 0);
+        zs.next_in = (Bytef*)out.data();
+        zs.avail_in = static_cast<uInt>(out.size());
+        zs.next_out = (Bytef*)&result[0];
+        zs.avail_out = static_cast<uInt>(result.size());
+        auto const rv = inflate(&zs, Z_FINISH);
+        BEAST_EXPECT(rv == Z_STREAM_END);
+        BEAST_EXPECT(zs.avail_in == 0);
+        result.resize(zs.total_out);
+        inflateEnd(&zs);
+        BEAST_EXPECT(result == in);
+    }
+
+    void
+    testFormat()
+    {
+        auto const s1 = corpus1(100000);
+        auto const s2 = corpus2(5000);
+        for(auto format : { Format::zlib, Format::gzip })
+        {
+            for(int level : { 0, 1, 6, 9 })
+            {
+                doFormat(s1, format, level, Strategy::normal, 65536);
+                doFormat(s2, format, level, Strategy::normal, 65536);
+                doFormat("", format, level, Strategy::normal, 64);
+            }
+            doFormat(s1, format, 6, Strategy::huffman, 65536);
+            doFormat(s1, format, 6, Strategy::rle, 65536);
+
+            // the header and trailer cross output buffers
+            for(std::size_t chunk = 1; chunk <= 11; ++chunk)
+                doFormat(s1.substr(0, 1000),
+                    format, 6, Strategy::normal, chunk);
+        }
+
+        // the zlib header
+        {
+            deflate_stream ds;
+            ds.reset(9, 15, 8, Strategy::normal, Format::zlib);
+            std::string const in = "Hello, world!";
+            unsigned char out[64];
+            z_params zp;
+            zp.next_in = in.data();
+            zp.avail_in = in.size();
+            zp.next_out = out;
+            zp.avail_out = sizeof(out);
+            error_code ec;
+            ds.write(zp, Flush::finish, ec);
+            BEAST_EXPECT(ec == error::end_of_stream);
+            BEAST_EXPECT(out[0] == 0x78 && out[1] == 0xda);
+            // the trailer is the Adler-32 of the input, big endian
+            auto const adler = adler32(1, reinterpret_cast<
+                Bytef const*>(in.data()), static_cast<uInt>(in.size()));
+            auto const p = out + zp.total_out - 4;
+            BEAST_EXPECT(p[0] == ((adler >> 24) & 0xff));
+            BEAST_EXPECT(p[3] == (adler & 0xff));
+
+            // reset() keeps the format
+            ds.reset();
+            zp.next_in = in.data();
+            zp.avail_in = in.size();
+            zp.next_out = out;
+            zp.avail_out = sizeof(out);
+            zp.total_out = 0;
+            ds.write(zp, Flush::finish, ec);
+            BEAST_EXPECT(ec == error::end_of_stream);
+            BEAST_EXPECT(out[0] == 0x78 && out[1] == 0xda);
+        }
+    }
+
     void
     run() override
     {
@@ -657,6 +765,7 @@ public:
         testFlushAfterDistMatch(zlib_compressor);
         testFlushAfterDistMatch(beast_compressor);
         testCVE();
+        testFormat();
     }
 };
 
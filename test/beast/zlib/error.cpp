@@ -11,6 +11,7 @@
 #include <boost/beast/zlib/error.hpp>
 
 #include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <boost/static_assert.hpp>
 #include <memory>
 
 namespace boost {
@@ -61,6 +62,18 @@ public:
         check("boost.beast.zlib", error::incomplete_length_set);
 
         check("boost.beast.zlib", error::general);
+
+        check("boost.beast.zlib", error::invalid_header_check);
+        check("boost.beast.zlib", error::invalid_method);
+        check("boost.beast.zlib", error::invalid_window_size);
+        check("boost.beast.zlib", error::invalid_header_flags);
+        check("boost.beast.zlib", error::invalid_header_crc);
+        check("boost.beast.zlib", error::invalid_data_check);
+        check("boost.beast.zlib", error::invalid_length_check);
+
+        // new codes are appended, existing values do not change
+        BOOST_STATIC_ASSERT(static_cast<int>(error::general) ==
+            static_cast<int>(error::incomplete_length_set) + 1);
     }
 };
 
@@ -634,6 +634,236 @@ public:
         BEAST_EXPECT(out == "Hello");
     }
 
+    // Compress with ZLib in the zlib or gzip format
+    static
+    std::string
+    compressFormat(
+        string_view const& in,
+        Format format,
+        int level,
+        gz_header* head = nullptr)
+    {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if(deflateInit2(&zs, level, Z_DEFLATED,
+                format == Format::gzip ? 31 : 15,
+                8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::logic_error{"deflateInit2 failed"};
+        if(head)
+            deflateSetHeader(&zs, head);
+        std::string out;
+        out.resize(deflateBound(&zs,
+            static_cast<uLong>(in.size())) + 256);
+        zs.next_in = (Bytef*)in.data();
+        zs.avail_in = static_cast<uInt>(in.size());
+        zs.next_out = (Bytef*)&out[0];
+        zs.avail_out = static_cast<uInt>(out.size());
+        if(deflate(&zs, Z_FINISH) != Z_STREAM_END)
+            throw std::logic_error("deflate failed");
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return out;
+    }
+
+    // Decompress, feeding at most `chunk` bytes of input
+    // at a time. Returns the last error and sets `left`
+    // to the size of the unused input.
+    static
+    error_code
+    inflateFormat(
+        string_view const& in,
+        Format format,
+        std::size_t chunk,
+        std::string& out,
+        std::size_t& left,
+        int windowBits = 15)
+    {
+        inflate_stream is;
+        is.reset(windowBits, format);
+        out.clear();
+        z_params zp;
+        zp.next_in = in.data();
+        zp.avail_in = 0;
+        std::size_t pos = 0;
+        error_code ec;
+        for(;;)
+        {
+            if(zp.avail_in == 0 && pos < in.size())
+            {
+                auto const n = (std::min)(chunk, in.size() - pos);
+                zp.next_in = in.data() + pos;
+                zp.avail_in = n;
+                pos += n;
+            }
+            auto const used = out.size();
+            out.resize(used + 4096);
+            zp.next_out = &out[used];
+            zp.avail_out = 4096;
+            is.write(zp, Flush::sync, ec);
+            out.resize(out.size() - zp.avail_out);
+            if(ec == error::need_buffers && pos < in.size())
+                ec = {};
+            if(ec)
+                break;
+        }
+        left = zp.avail_in + in.size() - pos;
+        return ec;
+    }
+
+    void
+    testFormat()
+    {
+        auto const s1 = corpus1(50000);
+        auto const s2 = corpus2(3000);
+        std::string out;
+        std::size_t left;
+
+        for(auto format : { Format::zlib, Format::gzip })
+        {
+            for(int level : { 0, 1, 6, 9 })
+            {
+                for(auto const& in : { s1, s2, std::string() })
+                {
+                    auto const z = compressFormat(in, format, level);
+                    auto ec = inflateFormat(z, format, z.size(), out, left);
+                    BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+                    BEAST_EXPECT(out == in);
+                    BEAST_EXPECT(left == 0);
+                }
+            }
+
+            // one byte at a time, followed by other data
+            {
+                auto const z = compressFormat(
+                    s1.substr(0, 2000), format, 6) + "xyz";
+                for(std::size_t chunk : { 1, 2, 3, 5, 7, 64 })
+                {
+                    auto ec = inflateFormat(z, format, chunk, out, left);
+                    BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+                    BEAST_EXPECT(out == s1.substr(0, 2000));
+                    BEAST_EXPECT(left == 3);
+                }
+            }
+
+            // corrupt checksum and length
+            {
+                auto const z = compressFormat(s1, format, 6);
+                auto z1 = z;
+                z1[z1.size() - (format == Format::gzip ? 8 : 1)] ^= 1;
+                auto ec = inflateFormat(z1, format, 100, out, left);
+                BEAST_EXPECTS(ec == error::invalid_data_check, ec.message());
+                if(format == Format::gzip)
+                {
+                    auto z2 = z;
+                    z2[z2.size() - 1] ^= 1;
+                    ec = inflateFormat(z2, format, 100, out, left);
+                    BEAST_EXPECTS(ec == error::invalid_length_check,
+                        ec.message());
+                }
+            }
+
+            // wrong format
+            {
+                auto const other = format == Format::gzip ?
+                    Format::zlib : Format::gzip;
+                auto const z = compressFormat(s2, other, 6);
+                auto ec = inflateFormat(z, format, z.size(), out, left);
+                BEAST_EXPECTS(ec == error::invalid_header_check,
+                    ec.message());
+            }
+        }
+
+        // gzip header with every optional field
+        {
+            gz_header head;
+            memset(&head, 0, sizeof(head));
+            std::string extra(300, 'e');
+            head.text = 1;
+            head.time = 0x12345678;
+            head.os = 3;
+            head.extra = (Bytef*)&extra[0];
+            head.extra_len = static_cast<uInt>(extra.size());
+            head.name = (Bytef*)"file.txt";
+            head.comment = (Bytef*)"a comment";
+            head.hcrc = 1;
+            auto const z = compressFormat(s1, Format::gzip, 6, &head);
+            for(std::size_t chunk : { 1, 3, 16, 100000 })
+            {
+                auto ec = inflateFormat(
+                    z, Format::gzip, chunk, out, left);
+                BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+                BEAST_EXPECT(out == s1);
+            }
+
+            auto z1 = z;
+            z1[12 + 2 + 100] ^= 1; // inside the extra field
+            auto ec = inflateFormat(z1, Format::gzip, 50, out, left);
+            BEAST_EXPECTS(ec == error::invalid_header_crc, ec.message());
+
+            auto z2 = z;
+            z2[2] = 7;
+            ec = inflateFormat(z2, Format::gzip, 50, out, left);
+            BEAST_EXPECTS(ec == error::invalid_method, ec.message());
+
+            auto z3 = z;
+            z3[3] |= 0x20;
+            ec = inflateFormat(z3, Format::gzip, 50, out, left);
+            BEAST_EXPECTS(ec == error::invalid_header_flags, ec.message());
+        }
+
+        // zlib header checks
+        {
+            auto const z = compressFormat(s2, Format::zlib, 6);
+            auto z1 = z;
+            z1[1] ^= 1;
+            auto ec = inflateFormat(z1, Format::zlib, 50, out, left);
+            BEAST_EXPECTS(ec == error::invalid_header_check, ec.message());
+
+            // window larger than allowed
+            ec = inflateFormat(z, Format::zlib, 50, out, left, 14);
+            BEAST_EXPECTS(ec == error::invalid_window_size, ec.message());
+
+            // preset dictionary
+            std::string const dict = "0123456789";
+            z_stream zs;
+            memset(&zs, 0, sizeof(zs));
+            deflateInit(&zs, 6);
+            deflateSetDictionary(&zs,
+                (Bytef const*)dict.data(), static_cast<uInt>(dict.size()));
+            std::string z2(256, 0);
+            zs.next_in = (Bytef*)dict.data();
+            zs.avail_in = static_cast<uInt>(dict.size());
+            zs.next_out = (Bytef*)&z2[0];
+            zs.avail_out = static_cast<uInt>(z2.size());
+            deflate(&zs, Z_FINISH);
+            z2.resize(zs.total_out);
+            deflateEnd(&zs);
+            ec = inflateFormat(z2, Format::zlib, 50, out, left);
+            BEAST_EXPECTS(ec == error::need_dict, ec.message());
+        }
+
+        // reset() keeps the format
+        {
+            auto const z = compressFormat(s2, Format::gzip, 6);
+            inflate_stream is;
+            is.reset(15, Format::gzip);
+            for(int i = 0; i < 2; ++i)
+            {
+                is.reset();
+                out.resize(s2.size() + 1);
+                z_params zp;
+                zp.next_in = z.data();
+                zp.avail_in = z.size();
+                zp.next_out = &out[0];
+                zp.avail_out = out.size();
+                error_code ec;
+                is.write(zp, Flush::sync, ec);
+                BEAST_EXPECTS(ec == error::end_of_stream, ec.message());
+                BEAST_EXPECT(out.substr(0, zp.total_out) == s2);
+            }
+        }
+    }
+
     void
     run() override
     {
@@ -650,6 +880,7 @@ public:
         testFixedHuffmanFlushTrees(beast_decompressor);
         testUncompressedFlushTrees(zlib_decompressor);
         testUncompressedFlushTrees(beast_decompressor);
+        testFormat();
     }
 };
 
@@ -0,0 +1,440 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/beast/core/string.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace http {
+
+namespace legacy {
+
+// The field lookup table used before the perfect hash
+class field_table
+{
+    static
+    std::uint32_t
+    get_chars(
+        unsigned char const* p) noexcept
+    {
+        return
+             p[0] |
+            (p[1] <<  8) |
+            (p[2] << 16) |
+            (p[3] << 24);
+    }
+
+    static
+    std::uint32_t
+    digest(string_view s)
+    {
+        std::uint32_t r = 0;
+        std::size_t n = s.size();
+        auto p = reinterpret_cast<
+            unsigned char const*>(s.data());
+        while(n >= 4)
+        {
+            auto const v = get_chars(p);
+            r = (r * 5 + (
+                v | 0x20202020 ));
+            p += 4;
+            n -= 4;
+        }
+        while( n > 0 )
+        {
+            r = r * 5 + ( *p | 0x20 );
+            ++p;
+            --n;
+        }
+        return r;
+    }
+
+    static
+    bool
+    equals(string_view lhs, string_view rhs)
+    {
+        using Int = std::uint32_t;
+        auto n = lhs.size();
+        if(n != rhs.size())
+            return false;
+        auto p1 = reinterpret_cast<
+            unsigned char const*>(lhs.data());
+        auto p2 = reinterpret_cast<
+            unsigned char const*>(rhs.data());
+        auto constexpr S = sizeof(Int);
+        auto constexpr Mask = static_cast<Int>(
+            0xDFDFDFDFDFDFDFDF & ~Int{0});
+        for(; n >= S; p1 += S, p2 += S, n -= S)
+        {
+            Int const v1 = get_chars(p1);
+            Int const v2 = get_chars(p2);
+            if((v1 ^ v2) & Mask)
+                return false;
+        }
+        for(; n; ++p1, ++p2, --n)
+            if(( *p1 ^ *p2) & 0xDF)
+                return false;
+        return true;
+    }
+
+    enum { N = 5155 };
+    unsigned char map_[ N ][ 2 ] = {};
+
+public:
+    field_table()
+    {
+        for(std::size_t i = 1; i < 357; ++i)
+        {
+            auto const j =
+                digest(to_string(static_cast<field>(i))) % N;
+            map_[j][i < 256 ? 0 : 1] =
+                static_cast<unsigned char>(i < 256 ? i : i - 255);
+        }
+    }
+
+    field
+    string_to_field(string_view s) const
+    {
+        auto h = digest(s);
+        auto j = h % N;
+        int i = map_[j][0];
+        if(i != 0 && equals(s, to_string(static_cast<field>(i))))
+            return static_cast<field>(i);
+        i = map_[j][1];
+        if(i == 0)
+            return field::unknown;
+        i += 255;
+        if(equals(s, to_string(static_cast<field>(i))))
+            return static_cast<field>(i);
+        return field::unknown;
+    }
+};
+
+// The verb lookup used before the perfect hash
+verb
+string_to_verb(string_view v)
+{
+    using namespace beast::detail::string_literals;
+    if(v.size() < 3)
+        return verb::unknown;
+    auto c = v[0];
+    v.remove_prefix(1);
+    switch(c)
+    {
+    case 'A':
+        if(v == "CL"_sv)
+            return verb::acl;
+        break;
+
+    case 'B':
+        if(v == "IND"_sv)
+            return verb::bind;
+        break;
+
+    case 'C':
+        c = v[0];
+        v.remove_prefix(1);
+        switch(c)
+        {
+        case 'H':
+            if(v == "ECKOUT"_sv)
+                return verb::checkout;
+            break;
+
+        case 'O':
+            if(v == "NNECT"_sv)
+                return verb::connect;
+            if(v == "PY"_sv)
+                return verb::copy;
+            BOOST_FALLTHROUGH;
+
+        default:
+            break;
+        }
+        break;
+
+    case 'D':
+        if(v == "ELETE"_sv)
+            return verb::delete_;
+        break;
+
+    case 'G':
+        if(v == "ET"_sv)
+            return verb::get;
+        break;
+
+    case 'H':
+        if(v == "EAD"_sv)
+            return verb::head;
+        break;
+
+    case 'L':
+        if(v == "INK"_sv)
+            return verb::link;
+        if(v == "OCK"_sv)
+            return verb::lock;
+        break;
+
+    case 'M':
+        c = v[0];
+        v.remove_prefix(1);
+        switch(c)
+        {
+        case '-':
+            if(v == "SEARCH"_sv)
+                return verb::msearch;
+            break;
+
+        case 'E':
+            if(v == "RGE"_sv)
+                return verb::merge;
+            break;
+
+        case 'K':
+            if(v == "ACTIVITY"_sv)
+                return verb::mkactivity;
+            if(v[0] == 'C')
+            {
+                v.remove_prefix(1);
+                if(v == "ALENDAR"_sv)
+                    return verb::mkcalendar;
+                if(v == "OL"_sv)
+                    return verb::mkcol;
+                break;
+            }
+            break;
+
+        case 'O':
+            if(v == "VE"_sv)
+                return verb::move;
+            BOOST_FALLTHROUGH;
+
+        default:
+            break;
+        }
+        break;
+
+    case 'N':
+        if(v == "OTIFY"_sv)
+            return verb::notify;
+        break;
+
+    case 'O':
+        if(v == "PTIONS"_sv)
+            return verb::options;
+        break;
+
+    case 'P':
+        c = v[0];
+        v.remove_prefix(1);
+        switch(c)
+        {
+        case 'A':
+            if(v == "TCH"_sv)
+                return verb::patch;
+            break;
+
+        case 'O':
+            if(v == "ST"_sv)
+                return verb::post;
+            break;
+
+        case 'R':
+            if(v == "OPFIND"_sv)
+                return verb::propfind;
+            if(v == "OPPATCH"_sv)
+                return verb::proppatch;
+            break;
+
+        case 'U':
+            if(v == "RGE"_sv)
+                return verb::purge;
+            if(v == "T"_sv)
+                return verb::put;
+            BOOST_FALLTHROUGH;
+
+        default:
+            break;
+        }
+        break;
+
+    case 'R':
+        if(v[0] != 'E')
+            break;
+        v.remove_prefix(1);
+        if(v == "BIND"_sv)
+            return verb::rebind;
+        if(v == "PORT"_sv)
+            return verb::report;
+        break;
+
+    case 'S':
+        if(v == "EARCH"_sv)
+            return verb::search;
+        if(v == "UBSCRIBE"_sv)
+            return verb::subscribe;
+        break;
+
+    case 'T':
+        if(v == "RACE"_sv)
+            return verb::trace;
+        break;
+
+    case 'U':
+        if(v[0] != 'N')
+            break;
+        v.remove_prefix(1);
+        if(v == "BIND"_sv)
+            return verb::unbind;
+        if(v == "LINK"_sv)
+            return verb::unlink;
+        if(v == "LOCK"_sv)
+            return verb::unlock;
+        if(v == "SUBSCRIBE"_sv)
+            return verb::unsubscribe;
+        break;
+
+    default:
+        break;
+    }
+
+    return verb::unknown;
+}
+
+} // legacy
+
+class field_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // Field names as they appear on the wire
+    static
+    std::vector<std::string>
+    field_corpus()
+    {
+        std::vector<std::string> v = {
+            "Host", "User-Agent", "Accept", "Accept-Language",
+            "Accept-Encoding", "Connection", "Cookie", "Referer",
+            "Cache-Control", "Content-Type", "Content-Length",
+            "If-None-Match", "If-Modified-Since", "Authorization",
+            "Upgrade-Insecure-Requests", "Sec-Fetch-Mode",
+            "Sec-Fetch-Site", "Sec-WebSocket-Key", "Origin", "Pragma",
+            "content-length", "transfer-encoding", "x-forwarded-for",
+            "X-Request-Id", "X-Real-IP", "X-Amzn-Trace-Id", "DNT",
+            "Strict-Transport-Security", "Set-Cookie", "Server",
+            "Date", "Last-Modified", "ETag", "Vary", "Expires" };
+        return v;
+    }
+
+    static
+    std::vector<std::string>
+    verb_corpus()
+    {
+        std::vector<std::string> v = {
+            "GET", "GET", "GET", "GET", "POST", "POST", "PUT",
+            "DELETE", "HEAD", "OPTIONS", "PATCH", "CONNECT",
+            "PROPFIND", "M-SEARCH", "BREW", "get" };
+        return v;
+    }
+
+    template<class F>
+    double
+    timed(
+        char const* what,
+        std::vector<std::string> const& corpus,
+        std::size_t rounds,
+        F const& f)
+    {
+        std::vector<string_view> names;
+        names.reserve(corpus.size() * 64);
+        std::mt19937 g;
+        for(std::size_t i = 0; i < corpus.size() * 64; ++i)
+            names.emplace_back(corpus[g() % corpus.size()]);
+        unsigned sum = 0;
+        auto const start = clock_type::now();
+        for(std::size_t r = 0; r < rounds; ++r)
+            for(auto const& s : names)
+                sum += static_cast<unsigned>(f(s));
+        auto const elapsed = std::chrono::duration<double>(
+            clock_type::now() - start).count();
+        auto const ns = elapsed * 1e9 / (rounds * names.size());
+        log <<
+            what << ": " << ns << " ns/lookup" <<
+            " (" << sum % 10 << ")" << std::endl;
+        return ns;
+    }
+
+    void
+    testField()
+    {
+        legacy::field_table const table;
+        auto const corpus = field_corpus();
+        for(auto const& s : corpus)
+            BEAST_EXPECTS(string_to_field(s) ==
+                table.string_to_field(s), s);
+        for(int i = 0; i < 3; ++i)
+        {
+            timed("field, legacy", corpus, 20000,
+                [&](string_view s)
+                {
+                    return table.string_to_field(s);
+                });
+            timed("field, perfect hash", corpus, 20000,
+                [](string_view s)
+                {
+                    return string_to_field(s);
+                });
+        }
+    }
+
+    void
+    testVerb()
+    {
+        auto const corpus = verb_corpus();
+        for(auto const& s : corpus)
+            BEAST_EXPECTS(string_to_verb(s) ==
+                legacy::string_to_verb(s), s);
+        for(int i = 0; i < 3; ++i)
+        {
+            timed("verb, legacy", corpus, 40000,
+                [](string_view s)
+                {
+                    return legacy::string_to_verb(s);
+                });
+            timed("verb, perfect hash", corpus, 40000,
+                [](string_view s)
+                {
+                    return string_to_verb(s);
+                });
+        }
+    }
+
+    void
+    run() override
+    {
+        testField();
+        testVerb();
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,benchmarks,field);
+
+} // http
+} // beast
+} // boost
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#include <boost/beast/websocket/detail/hybi13.hpp>
+#include <boost/beast/core/detail/base64.hpp>
+#include <boost/beast/core/detail/cpu_info.hpp>
+#include <boost/beast/core/detail/sha1.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+class handshake_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // Calls `f` a fixed number of times
+    // and reports the rate in calls per second.
+    template<class F>
+    void
+    measure(char const* what, F const& f)
+    {
+        std::size_t constexpr count = 2000000;
+        auto const start = clock_type::now();
+        std::uint32_t check = 0;
+        for(std::size_t i = 0; i < count; ++i)
+            check += f(i);
+        auto const elapsed = std::chrono::duration<
+            double>(clock_type::now() - start).count();
+        log <<
+            what << ": " <<
+            static_cast<std::uint64_t>(count / elapsed) <<
+            " per second (" << (check & 0xff) << ")" <<
+            std::endl;
+    }
+
+    // The two blocks hashed for a Sec-WebSocket-Accept
+    template<class Transform>
+    void
+    measureSha1(char const* what, Transform transform)
+    {
+        std::uint8_t blocks[128] = {};
+        std::memcpy(blocks,
+            "dGhlIHNhbXBsZSBub25jZQ=="
+            "258EAFA5-E914-47DA-95CA-C5AB0DC85B11", 60);
+        blocks[60] = 0x80;
+        blocks[126] = 0x01;
+        blocks[127] = 0xe0;
+        measure(what,
+            [&](std::size_t i)
+            {
+                std::uint32_t digest[5] = {
+                    0x67452301, 0xefcdab89, 0x98badcfe,
+                    0x10325476, 0xc3d2e1f0 };
+                blocks[0] = static_cast<std::uint8_t>(i);
+                transform(digest, blocks, 2);
+                return digest[0];
+            });
+    }
+
+    void
+    run() override
+    {
+        measureSha1("sha1, portable ",
+            &beast::detail::sha1::transform_portable);
+#if ! BOOST_BEAST_NO_INTRINSICS
+        if(beast::detail::get_cpu_info().sha)
+            measureSha1("sha1, SHA-NI   ",
+                &beast::detail::sha1::transform_shani);
+#endif
+
+        measure("base64, 20 bytes",
+            [](std::size_t i)
+            {
+                unsigned char in[20] = {};
+                char out[28];
+                in[0] = static_cast<unsigned char>(i);
+                beast::detail::base64::encode(out, in, sizeof(in));
+                return static_cast<std::uint32_t>(out[0]);
+            });
+
+        measure("make_sec_ws_key",
+            [](std::size_t)
+            {
+                detail::sec_ws_key_type key;
+                detail::make_sec_ws_key(key);
+                return static_cast<std::uint32_t>(key[0]);
+            });
+
+        measure("make_sec_ws_accept",
+            [](std::size_t i)
+            {
+                char key[] = "dGhlIHNhbXBsZSBub25jZQ==";
+                key[0] = "ABCD"[i % 4];
+                detail::sec_ws_accept_type accept;
+                detail::make_sec_ws_accept(accept, key);
+                return static_cast<std::uint32_t>(accept[0]);
+            });
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,benchmarks,handshake);
+
+} // websocket
+} // beast
+} // boost
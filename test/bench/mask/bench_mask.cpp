@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2016-2019 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/beast
+//
+
+#include <boost/beast/websocket/detail/mask.hpp>
+#include <boost/beast/_experimental/unit_test/suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast {
+namespace websocket {
+
+namespace legacy {
+
+// The masking loop used before the vector kernels
+void
+mask_inplace(net::mutable_buffer const& b, detail::prepared_key& key)
+{
+    auto n = b.size();
+    auto const mask = key; // avoid aliasing
+    auto p = static_cast<unsigned char*>(b.data());
+    while(n >= 4)
+    {
+        for(int i = 0; i < 4; ++i)
+            p[i] ^= mask[i];
+        p += 4;
+        n -= 4;
+    }
+    if(n > 0)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+            p[i] ^= mask[i];
+        auto const v0 = key;
+        for(std::size_t i = 0; i < key.size(); ++i)
+            key[i] = v0[(i + n) % key.size()];
+    }
+}
+
+} // legacy
+
+class mask_test : public beast::unit_test::suite
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // Masks `total` bytes in frames of `size` bytes
+    // and reports the throughput in MB/s.
+    template<class F>
+    void
+    measure(
+        char const* what,
+        std::size_t size,
+        F const& f)
+    {
+        std::size_t constexpr total = 256 * 1024 * 1024;
+        // odd offset, as payloads follow a frame header
+        std::vector<unsigned char> buf(size + 64);
+        net::mutable_buffer const b(&buf[3], size);
+        detail::prepared_key key;
+        detail::prepare_key(key, 0x12345678);
+        auto const start = clock_type::now();
+        for(std::size_t n = 0; n < total; n += size)
+            f(b, key);
+        auto const elapsed = std::chrono::duration<
+            double>(clock_type::now() - start).count();
+        log <<
+            what << " " << size << " bytes: " <<
+            static_cast<std::uint64_t>(total / elapsed / 1e6) <<
+            " MB/s (" << static_cast<unsigned>(buf[3]) << ")" <<
+            std::endl;
+    }
+
+    // Copies a message made of `segments` pieces into a frame
+    // buffer and masks it, `total` bytes overall, and reports the
+    // throughput in MB/s.
+    template<class F>
+    void
+    measureCopy(
+        char const* what,
+        std::size_t size,
+        std::size_t segments,
+        F const& f)
+    {
+        std::size_t constexpr total = 256 * 1024 * 1024;
+        std::string const msg(size, 'x');
+        std::vector<net::const_buffer> v;
+        for(std::size_t i = 0; i < segments; ++i)
+            v.emplace_back(
+                msg.data() + i * size / segments,
+                (i + 1) * size / segments - i * size / segments);
+        std::vector<unsigned char> buf(size);
+        detail::prepared_key key;
+        detail::prepare_key(key, 0x12345678);
+        auto const start = clock_type::now();
+        for(std::size_t n = 0; n < total; n += size)
+            f(net::buffer(buf), v, key);
+        auto const elapsed = std::chrono::duration<
+            double>(clock_type::now() - start).count();
+        log <<
+            what << " " << size << " bytes in " << segments <<
+            " pieces: " <<
+            static_cast<std::uint64_t>(total / elapsed / 1e6) <<
+            " MB/s (" << static_cast<unsigned>(buf[0]) << ")" <<
+            std::endl;
+    }
+
+    void
+    testCopy()
+    {
+        using buffers_type = std::vector<net::const_buffer>;
+        for(auto const p : {
+            std::make_pair<std::size_t, std::size_t>(1400, 1),
+            std::make_pair<std::size_t, std::size_t>(1400, 12),
+            std::make_pair<std::size_t, std::size_t>(65536, 1),
+            std::make_pair<std::size_t, std::size_t>(65536, 64),
+            std::make_pair<std::size_t, std::size_t>(4194304, 1) })
+        {
+            measureCopy("copy, mask", p.first, p.second,
+                [](net::mutable_buffer const& b,
+                    buffers_type const& v,
+                    detail::prepared_key& key)
+                {
+                    net::buffer_copy(b, v);
+                    detail::mask_inplace(b, key);
+                });
+            measureCopy("mask_copy ", p.first, p.second,
+                [](net::mutable_buffer const& b,
+                    buffers_type const& v,
+                    detail::prepared_key& key)
+                {
+                    detail::mask_copy(b, v, key);
+                });
+        }
+    }
+
+    void
+    run() override
+    {
+        for(std::size_t size : { 16, 125, 1400, 16384, 1048576 })
+        {
+            measure("legacy", size,
+                [](net::mutable_buffer const& b,
+                    detail::prepared_key& key)
+                {
+                    legacy::mask_inplace(b, key);
+                });
+            measure("beast ", size,
+                [](net::mutable_buffer const& b,
+                    detail::prepared_key& key)
+                {
+                    detail::mask_inplace(b, key);
+                });
+        }
+        testCopy();
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(beast,benchmarks,mask);
+
+} // websocket
+} // beast
+} // boost
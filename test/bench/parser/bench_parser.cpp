@@ -131,7 +131,8 @@ public:
 
     template<class Function>
     void
-    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    timedTest(std::size_t repeat, std::string const& name, Function&& f,
+        std::size_t bytes = 0)
     {
         using namespace std::chrono;
         using clock_type = std::chrono::high_resolution_clock;
@@ -143,7 +144,14 @@ public:
             auto const elapsed = clock_type::now() - t0;
             log <<
                 "Trial " << trial << ": " <<
-                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+                duration_cast<milliseconds>(elapsed).count() << " ms";
+            if(bytes > 0)
+            {
+                auto const us = duration_cast<
+                    microseconds>(elapsed).count();
+                log << ", " << bytes / (us ? us : 1) << " MB/s";
+            }
+            log << std::endl;
         }
     }
 
@@ -331,10 +339,156 @@ public:
         pass();
     }
 
+    // Messages dominated by long field values and chunk
+    // extensions, which are scanned for the end of line.
+    static
+    corpus
+    build_long_corpus(std::size_t n, std::true_type)
+    {
+        corpus v;
+        v.resize(n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            ostream(v[i]) <<
+                "GET /api/v1/orders?page=" << i << " HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "Authorization: Bearer " << std::string(1200, 'A' + i % 26) << "\r\n"
+                "Cookie: session=" << std::string(4096, 'a' + i % 26) << "\r\n"
+                "Accept: */*\r\n"
+                "\r\n";
+        }
+        return v;
+    }
+
+    static
+    corpus
+    build_long_corpus(std::size_t n, std::false_type)
+    {
+        corpus v;
+        v.resize(n);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto os = ostream(v[i]);
+            os <<
+                "HTTP/1.1 200 OK\r\n"
+                "Set-Cookie: session=" << std::string(4096, 'a' + i % 26) << "\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            for(std::size_t j = 0; j < 16; ++j)
+                os <<
+                    "1;signature=" << std::string(256, 'a' + j) << "\r\n"
+                    "*\r\n";
+            os << "0\r\n\r\n";
+        }
+        return v;
+    }
+
+    void
+    testLongLines()
+    {
+        static std::size_t constexpr Trials = 5;
+        static std::size_t constexpr Repeat = 500;
+
+        auto const creq = build_long_corpus(N/20, std::true_type{});
+        auto const cres = build_long_corpus(N/20, std::false_type{});
+        std::size_t size = 0;
+        for(auto const& b : creq)
+            size += b.size();
+        for(auto const& b : cres)
+            size += b.size();
+
+        testcase << "Parser long line test, " <<
+            ((Repeat * size + 512) / 1024) << "KB in " <<
+                (Repeat * (creq.size() + cres.size())) << " messages";
+
+        timedTest(Trials, "http::basic_parser",
+            [&]
+            {
+                testParser2<bench_parser<
+                    true, dynamic_body, fields>>(
+                        Repeat, creq);
+                testParser2<bench_parser<
+                    false, dynamic_body, fields>>(
+                        Repeat, cres);
+            }, Repeat * size);
+        timedTest(Trials, "nodejs_parser",
+            [&]
+            {
+                testParser1<nodejs_parser<
+                    true, dynamic_body, fields>>(
+                        Repeat, creq);
+                testParser1<nodejs_parser<
+                    false, dynamic_body, fields>>(
+                        Repeat, cres);
+            }, Repeat * size);
+        pass();
+    }
+
+    // Feed a message `step` octets at a time, presenting
+    // unconsumed octets again like `http::read` does.
+    template<class Parser>
+    void
+    feedSegmented(
+        std::string const& s, std::size_t step)
+    {
+        Parser p;
+        p.header_limit((std::numeric_limits<std::uint32_t>::max)());
+        flat_buffer b;
+        std::size_t pos = 0;
+        error_code ec;
+        while(! p.is_done() && pos < s.size())
+        {
+            auto const n = (std::min)(step, s.size() - pos);
+            b.commit(net::buffer_copy(
+                b.prepare(n), net::buffer(s.data() + pos, n)));
+            pos += n;
+            b.consume(p.put(b.data(), ec));
+            if(ec == error::need_more)
+                continue;
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+        }
+        BEAST_EXPECT(p.is_done());
+    }
+
+    void
+    testSegmented()
+    {
+        static std::size_t constexpr Trials = 3;
+
+        // 16KB header with one long line
+        std::string const s =
+            "GET /api/v1/orders HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Authorization: Bearer " + std::string(1200, 'A') + "\r\n"
+            "Cookie: session=" + std::string(14000, 'a') + "\r\n"
+            "Accept: */*\r\n"
+            "\r\n";
+
+        testcase << "Parser segmented input test, " <<
+            s.size() << " byte header";
+
+        for(std::size_t step : { 1, 536, 1448 })
+        {
+            std::size_t const repeat = step == 1 ? 20 : 2000;
+            timedTest(Trials, std::to_string(repeat) + " x " +
+                std::to_string(step) + " byte segments",
+                [&]
+                {
+                    for(std::size_t i = 0; i < repeat; ++i)
+                        feedSegmented<bench_parser<
+                            true, dynamic_body, fields>>(s, step);
+                }, repeat * s.size());
+        }
+        pass();
+    }
+
     void run() override
     {
         pass();
         testSpeed();
+        testLongLines();
+        testSegmented();
     }
 };
 
@@ -11,6 +11,7 @@
 #include <boost/beast/_experimental/unit_test/suite.hpp>
 #include <chrono>
 #include <random>
+#include <string>
 
 #ifndef BEAST_USE_BOOST_LOCALE_BENCHMARK
 #define BEAST_USE_BOOST_LOCALE_BENCHMARK 0
@@ -66,15 +67,36 @@ public:
 
     static
     inline
-    size_type
+    double
     throughput(std::chrono::duration<
-        double> const& elapsed, size_type items)
+        double> const& elapsed, size_type bytes)
     {
-        using namespace std::chrono;
-        return static_cast<size_type>(
-            1 / (elapsed/items).count());
+        // GB/s
+        return bytes / elapsed.count() / 1e9;
     }
 
+    static
+    void
+    append(std::string& s, std::uint32_t cp)
+    {
+        if(cp < 0x80)
+        {
+            s.push_back(static_cast<char>(cp));
+        }
+        else if(cp < 0x800)
+        {
+            s.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else
+        {
+            s.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+    }
+
+    // printable ASCII
     std::string
     corpus(std::size_t n)
     {
@@ -86,6 +108,38 @@ public:
         return s;
     }
 
+    // European text, about one accented letter in eight
+    std::string
+    latin(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n + 2);
+        while(s.size() < n)
+        {
+            if(rand(8) == 0)
+                append(s, 0xc0 + rand<std::uint32_t>(0x40));
+            else
+                s.push_back(static_cast<char>('a' + rand(26)));
+        }
+        return s;
+    }
+
+    // CJK ideographs with some ASCII punctuation
+    std::string
+    cjk(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n + 3);
+        while(s.size() < n)
+        {
+            if(rand(16) == 0)
+                s.push_back(' ');
+            else
+                append(s, 0x4e00 + rand<std::uint32_t>(0x5200));
+        }
+        return s;
+    }
+
     void
     checkBeast(std::string const& s)
     {
@@ -119,10 +173,11 @@ public:
     }
 
     void
-    run() override
+    measure(char const* what, std::string const& s)
     {
-        auto const s = corpus(32 * 1024 * 1024);
-        for(int i = 0; i < 5; ++ i)
+        BEAST_EXPECT(beast::websocket::detail::check_utf8(
+            s.data(), s.size()));
+        for(int i = 0; i < 3; ++ i)
         {
             auto const elapsed = test([&]{
                 checkBeast(s);
@@ -131,10 +186,11 @@ public:
                 checkBeast(s);
                 checkBeast(s);
             });
-            log << "beast:  " << throughput(elapsed, s.size()) << " char/s" << std::endl;
+            log << "beast " << what << ": " <<
+                throughput(elapsed, 5 * s.size()) << " GB/s" << std::endl;
         }
     #if BEAST_USE_BOOST_LOCALE_BENCHMARK
-        for(int i = 0; i < 5; ++ i)
+        for(int i = 0; i < 3; ++ i)
         {
             auto const elapsed = test([&]{
                 checkLocale(s);
@@ -143,9 +199,19 @@ public:
                 checkLocale(s);
                 checkLocale(s);
             });
-            log << "locale: " << throughput(elapsed, s.size()) << " char/s" << std::endl;
+            log << "locale " << what << ": " <<
+                throughput(elapsed, 5 * s.size()) << " GB/s" << std::endl;
         }
     #endif
+    }
+
+    void
+    run() override
+    {
+        std::size_t constexpr n = 32 * 1024 * 1024;
+        measure("ascii", corpus(n));
+        measure("latin", latin(n));
+        measure("cjk  ", cjk(n));
         pass();
     }
 };
@@ -15,6 +15,7 @@
 #include <iomanip>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "zlib-1.2.12/zlib.h"
 
@@ -64,13 +65,42 @@ public:
         return s;
     }
 
+    // JSON lines, like a stream of websocket messages
+    static
+    std::string
+    corpus3(std::size_t n)
+    {
+        static char const* const names[] = {
+            "id", "price", "size", "side", "symbol", "time", "venue" };
+        std::string s;
+        s.reserve(n + 128);
+        std::mt19937 g;
+        std::uniform_int_distribution<std::uint32_t> d0{0, 99999};
+        while(s.size() < n)
+        {
+            s += "{";
+            for(auto name : names)
+            {
+                s += "\"";
+                s += name;
+                s += "\":";
+                s += std::to_string(d0(g));
+                s += ",";
+            }
+            s.back() = '}';
+            s += "\n";
+        }
+        s.resize(n);
+        return s;
+    }
+
     std::string
-    doDeflateBeast(string_view const& in)
+    doDeflateBeast(string_view const& in, int level)
     {
         z_params zs;
         deflate_stream ds;
         ds.reset(
-            Z_DEFAULT_COMPRESSION,
+            level,
             15,
             4,
             Strategy::normal);
@@ -88,14 +118,14 @@ public:
     }
 
     std::string
-    doDeflateZLib(string_view const& in)
+    doDeflateZLib(string_view const& in, int level)
     {
         int result;
         z_stream zs;
         memset(&zs, 0, sizeof(zs));
         result = deflateInit2(
             &zs,
-            Z_DEFAULT_COMPRESSION,
+            level,
             Z_DEFLATED,
             -15,
             4,
@@ -121,13 +151,18 @@ public:
     void
     doCorpus(
         std::size_t size,
-        std::size_t repeat)
+        std::size_t repeat,
+        int level = Z_DEFAULT_COMPRESSION)
     {
         std::size_t constexpr trials = 3;
         auto const c1 = corpus1(size);
         auto const c2 = corpus2(size);
+        // Level 1 uses deflate_quick, whose output differs from zlib
+        bool const same = level != 1;
         log <<
-            std::left << std::setw(10) << (std::to_string(size) + "B") <<
+            std::left << std::setw(10) << (std::to_string(size) + "B" +
+                (level == Z_DEFAULT_COMPRESSION ? "" :
+                    " L" + std::to_string(level))) <<
             std::right << std::setw(12) << "Beast" << "     " <<
             std::right << std::setw(12) << "ZLib" <<
                 std::endl;
@@ -137,14 +172,14 @@ public:
             log << std::left << std::setw(10) << "corpus1";
             std::string out1;
             for(std::size_t j = 0; j < repeat; ++j)
-                out1 = doDeflateBeast(c1);
+                out1 = doDeflateBeast(c1, level);
             auto const t1 =
                 test::throughput(t.elapsed(), size * repeat);
             log << std::right << std::setw(12) << t1 << " B/s ";
             std::string out2;
             for(std::size_t j = 0; j < repeat; ++j)
-                out2 = doDeflateZLib(c1);
-            BEAST_EXPECT(out1 == out2);
+                out2 = doDeflateZLib(c1, level);
+            BEAST_EXPECT(! same || out1 == out2);
             auto const t2 =
                 test::throughput(t.elapsed(), size * repeat);
             log << std::right << std::setw(12) << t2 << " B/s";
@@ -158,14 +193,14 @@ public:
             log << std::left << std::setw(10) << "corpus2";
             std::string out1;
             for(std::size_t j = 0; j < repeat; ++j)
-                out1 = doDeflateBeast(c2);
+                out1 = doDeflateBeast(c2, level);
             auto const t1 =
                 test::throughput(t.elapsed(), size * repeat);
             log << std::right << std::setw(12) << t1 << " B/s ";
             std::string out2;
             for(std::size_t j = 0; j < repeat; ++j)
-                out2 = doDeflateZLib(c2);
-            BEAST_EXPECT(out1 == out2);
+                out2 = doDeflateZLib(c2, level);
+            BEAST_EXPECT(! same || out1 == out2);
             auto const t2 =
                 test::throughput(t.elapsed(), size * repeat);
             log << std::right << std::setw(12) << t2 << " B/s";
@@ -176,12 +211,95 @@ public:
         log << std::endl;
     }
 
+    // Compress count messages of the given size with one
+    // stream and a sync flush after each, as permessage-deflate
+    // does with context takeover.
+    void
+    doMessages(
+        std::size_t size,
+        std::size_t count,
+        std::size_t repeat,
+        int level)
+    {
+        std::size_t constexpr trials = 3;
+        auto const c = corpus3(size * count);
+        std::string out;
+        out.resize(deflate_upper_bound(size) + 16);
+        log <<
+            std::left << std::setw(10) << (std::to_string(size) + "B L" +
+                std::to_string(level)) <<
+            std::right << std::setw(12) << "Beast" << "     " <<
+            std::right << std::setw(12) << "ZLib" <<
+                std::endl;
+        for(std::size_t i = 0; i < trials; ++i)
+        {
+            log << std::left << std::setw(10) << "messages";
+            std::size_t n1 = 0;
+            test::timer t;
+            for(std::size_t j = 0; j < repeat; ++j)
+            {
+                deflate_stream ds;
+                ds.reset(level, 15, 4, Strategy::normal);
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    z_params zs;
+                    zs.next_in = &c[k * size];
+                    zs.avail_in = size;
+                    zs.next_out = &out[0];
+                    zs.avail_out = out.size();
+                    error_code ec;
+                    ds.write(zs, Flush::sync, ec);
+                    if(ec || zs.avail_in != 0)
+                        throw std::logic_error("deflate_stream failed");
+                    n1 += out.size() - zs.avail_out;
+                }
+            }
+            auto const t1 =
+                test::throughput(t.elapsed(), size * count * repeat);
+            log << std::right << std::setw(12) << t1 << " B/s ";
+            std::size_t n2 = 0;
+            test::timer tz;
+            for(std::size_t j = 0; j < repeat; ++j)
+            {
+                z_stream zs;
+                memset(&zs, 0, sizeof(zs));
+                deflateInit2(&zs, level,
+                    Z_DEFLATED, -15, 4, Z_DEFAULT_STRATEGY);
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    zs.next_in = (Bytef*)&c[k * size];
+                    zs.avail_in = static_cast<uInt>(size);
+                    zs.next_out = (Bytef*)&out[0];
+                    zs.avail_out = static_cast<uInt>(out.size());
+                    if(deflate(&zs, Z_SYNC_FLUSH) != Z_OK ||
+                            zs.avail_in != 0)
+                        throw std::logic_error("deflate failed");
+                    n2 += out.size() - zs.avail_out;
+                }
+                deflateEnd(&zs);
+            }
+            auto const t2 =
+                test::throughput(tz.elapsed(), size * count * repeat);
+            log << std::right << std::setw(12) << t2 << " B/s";
+            log << std::right << std::setw(12) <<
+                int(double(t1)*100/t2-100) << "%";
+            log << std::right << std::setw(8) <<
+                int(double(n1)*100/n2-100) << "% size";
+            log << std::endl;
+        }
+        log << std::endl;
+    }
+
     void
     doBench()
     {
         doCorpus(      16 * 1024, 512);
         doCorpus(    1024 * 1024,   8);
         doCorpus(8 * 1024 * 1024,   1);
+        doCorpus(    1024 * 1024,   8, 1);
+        doMessages(  512, 8192, 4, 1);
+        doMessages( 4096, 1024, 4, 1);
+        doMessages( 4096, 1024, 4, 6);
     }
 
     void
@@ -15,6 +15,7 @@
 #include <iomanip>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "zlib-1.2.12/zlib.h"
 
@@ -64,6 +65,35 @@ public:
         return s;
     }
 
+    // JSON text, like the messages of a WebSocket API
+    static
+    std::string
+    corpus3(std::size_t n)
+    {
+        static char const* const names[] = {
+            "id", "price", "size", "side", "symbol", "time", "venue" };
+        std::string s;
+        s.reserve(n + 128);
+        std::mt19937 g;
+        std::uniform_int_distribution<std::uint32_t> d0{0, 99999};
+        while(s.size() < n)
+        {
+            s += "{";
+            for(auto name : names)
+            {
+                s += "\"";
+                s += name;
+                s += "\":";
+                s += std::to_string(d0(g));
+                s += ",";
+            }
+            s.back() = '}';
+            s += "\n";
+        }
+        s.resize(n);
+        return s;
+    }
+
     static
     std::string
     compress(string_view const& in)
@@ -221,12 +251,116 @@ public:
         log << std::endl;
     }
 
+    // Inflate a stream of messages, one write per message,
+    // as permessage-deflate does with context takeover.
+    void
+    doMessages(
+        std::size_t size,
+        std::size_t count,
+        std::size_t repeat)
+    {
+        std::size_t constexpr trials = 3;
+        auto const c = corpus3(size * count);
+        std::vector<std::string> msgs;
+        {
+            int result;
+            z_stream zs;
+            memset(&zs, 0, sizeof(zs));
+            result = deflateInit2(&zs, Z_DEFAULT_COMPRESSION,
+                Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            if(result != Z_OK)
+                throw std::logic_error("deflateInit2 failed");
+            std::string out;
+            out.resize(deflateBound(&zs,
+                static_cast<uLong>(size)) + 16);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                zs.next_in = (Bytef*)&c[i * size];
+                zs.avail_in = static_cast<uInt>(size);
+                zs.next_out = (Bytef*)&out[0];
+                zs.avail_out = static_cast<uInt>(out.size());
+                result = deflate(&zs, Z_SYNC_FLUSH);
+                if(result != Z_OK)
+                    throw std::logic_error("deflate failed");
+                msgs.emplace_back(out.data(),
+                    out.size() - zs.avail_out);
+            }
+            deflateEnd(&zs);
+        }
+        // room for more than one message, so each
+        // write consumes all of its input
+        std::string out;
+        out.resize(2 * size);
+        log <<
+            std::left << std::setw(10) << (std::to_string(size) + "B") <<
+            std::right << std::setw(12) << "Beast" << "     " <<
+            std::right << std::setw(12) << "ZLib" <<
+                std::endl;
+        for(std::size_t i = 0; i < trials; ++i)
+        {
+            test::timer t;
+            log << std::left << std::setw(10) << "messages";
+            for(std::size_t j = 0; j < repeat; ++j)
+            {
+                inflate_stream is;
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    z_params zs;
+                    zs.next_in = msgs[k].data();
+                    zs.avail_in = msgs[k].size();
+                    zs.next_out = &out[0];
+                    zs.avail_out = out.size();
+                    error_code ec;
+                    is.write(zs, Flush::sync, ec);
+                    if(ec || zs.avail_in != 0 ||
+                            zs.avail_out != size)
+                        throw std::logic_error("inflate_stream failed");
+                }
+            }
+            BEAST_EXPECT(out.compare(0, size,
+                c, (count - 1) * size, size) == 0);
+            auto const t1 =
+                test::throughput(t.elapsed(), size * count * repeat);
+            log << std::right << std::setw(12) << t1 << " B/s ";
+            test::timer tz;
+            for(std::size_t j = 0; j < repeat; ++j)
+            {
+                z_stream zs;
+                memset(&zs, 0, sizeof(zs));
+                inflateInit2(&zs, -15);
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    zs.next_in = (Bytef*)msgs[k].data();
+                    zs.avail_in = static_cast<uInt>(msgs[k].size());
+                    zs.next_out = (Bytef*)&out[0];
+                    zs.avail_out = static_cast<uInt>(out.size());
+                    auto const result = inflate(&zs, Z_SYNC_FLUSH);
+                    if(result != Z_OK || zs.avail_in != 0 ||
+                            zs.avail_out != size)
+                        throw std::logic_error("inflate failed");
+                }
+                inflateEnd(&zs);
+            }
+            BEAST_EXPECT(out.compare(0, size,
+                c, (count - 1) * size, size) == 0);
+            auto const t2 =
+                test::throughput(tz.elapsed(), size * count * repeat);
+            log << std::right << std::setw(12) << t2 << " B/s";
+            log << std::right << std::setw(12) <<
+                unsigned(double(t1)*100/t2-100) << "%";
+            log << std::endl;
+        }
+        log << std::endl;
+    }
+
     void
     doBench()
     {
         doCorpus(  1 * 1024 * 1024, 64);
         doCorpus(  4 * 1024 * 1024, 16);
         doCorpus( 16 * 1024 * 1024,  8);
+        doMessages(  512, 8192, 8);
+        doMessages( 4096, 1024, 8);
     }
 
     void